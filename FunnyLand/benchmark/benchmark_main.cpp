@@ -0,0 +1,244 @@
+﻿/**
+ * @file benchmark_main.cpp
+ * @brief 无头基准测试程序：用 SDL 的 offscreen/dummy 视频驱动和软件渲染器启动 GameApp，
+ *        运行合成场景固定帧数，以 JSON 输出帧时间统计、各阶段耗时和内存分配次数。
+ *
+ * 工作目录需为 FunnyLand/（与游戏相同，需要读取 assets/）。
+ * 用法：FunnyLandBenchmark [--sprites N] [--parallax N] [--frames N] [--warmup N] [--pooled] [--churn N] [--workers N] [--reload-every N] [--seed N] [--output file.json]
+ *       --churn N：每秒通过预制体回收池生成并销毁 N 个短命对象
+ *       --reload-every N：每 N 帧通过预加载切换重新加载基准场景（期间加载场景会取消并重新发起一次预加载）
+ *       --workers N：任务调度器的工作线程数（默认 -1 按硬件线程数，0 表示组件全部在主线程串行更新；并行更新只作用于 --pooled 的组件池）
+ * 分配次数来自引擎的 MemoryTracker（工程定义 FUNNYLAND_MEMORY_TRACKING=1 以启用堆分配跟踪），
+ * 结果中的 memory 为最后一帧各内存标签（子系统、场景）的占用。
+ */
+#include "benchmark_scene.h"
+#include "../src/engine/core/game_app.h"
+#include "../src/engine/core/config.h"
+#include "../src/engine/core/memory_tracker.h"
+#include "../src/engine/scene/prefab_registry.h"
+#include <SDL3/SDL.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct BenchmarkOptions
+    {
+        benchmark::BenchmarkSceneOptions scene;
+        int frames = 600;               ///< @brief 统计的帧数
+        int job_workers = -1;           ///< @brief 任务调度器工作线程数
+        int warmup_frames = 60;         ///< @brief 预热帧数（不计入统计，让纹理加载、容器扩容等一次性开销先发生）
+        std::string output_path;        ///< @brief 结果文件路径（为空时输出到标准输出）
+    };
+
+    /// @brief 单项指标的统计结果
+    nlohmann::ordered_json summarize(std::vector<double> samples)
+    {
+        if (samples.empty()) return nlohmann::ordered_json::object();
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](double p) {
+            const size_t index = static_cast<size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+            return samples[std::min(index, samples.size() - 1)];
+        };
+        double sum = 0.0;
+        for (double sample : samples) sum += sample;
+        return {
+            {"mean", sum / static_cast<double>(samples.size())},
+            {"p50", percentile(0.50)},
+            {"p99", percentile(0.99)},
+            {"min", samples.front()},
+            {"max", samples.back()},
+        };
+    }
+
+    bool parseArguments(int argc, char* argv[], BenchmarkOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            auto nextInt = [&](int& value) {
+                if (i + 1 >= argc) return false;
+                value = std::atoi(argv[++i]);
+                return true;
+            };
+            bool ok = true;
+            if (arg == "--sprites") ok = nextInt(options.scene.sprite_count);
+            else if (arg == "--parallax") ok = nextInt(options.scene.parallax_count);
+            else if (arg == "--frames") ok = nextInt(options.frames);
+            else if (arg == "--warmup") ok = nextInt(options.warmup_frames);
+            else if (arg == "--pooled") options.scene.use_component_storage = true;
+            else if (arg == "--churn") ok = nextInt(options.scene.churn_per_second);
+            else if (arg == "--workers") ok = nextInt(options.job_workers);
+            else if (arg == "--reload-every") ok = nextInt(options.scene.reload_every_frames);
+            else if (arg == "--seed")
+            {
+                int seed = 0;
+                ok = nextInt(seed);
+                options.scene.seed = static_cast<std::uint32_t>(seed);
+            }
+            else if (arg == "--output" && i + 1 < argc) options.output_path = argv[++i];
+            else ok = false;
+
+            if (!ok)
+            {
+                spdlog::error("无法解析参数 '{}'", arg);
+                return false;
+            }
+        }
+        options.frames = std::max(options.frames, 1);
+        options.warmup_frames = std::max(options.warmup_frames, 0);
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    spdlog::set_level(spdlog::level::warn);
+
+    BenchmarkOptions options;
+    if (!parseArguments(argc, argv, options)) return 1;
+
+    // 无窗口、无GPU：offscreen 驱动不可用时退回 dummy，渲染器固定为软件渲染
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen,dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+    std::vector<double> frame_ms, input_ms, events_ms, update_ms, render_ms, present_ms, allocations, render_commands, frame_arena_bytes;
+    frame_ms.reserve(options.frames);
+    input_ms.reserve(options.frames);
+    events_ms.reserve(options.frames);
+    update_ms.reserve(options.frames);
+    render_ms.reserve(options.frames);
+    present_ms.reserve(options.frames);
+    allocations.reserve(options.frames);
+    render_commands.reserve(options.frames);
+    frame_arena_bytes.reserve(options.frames);
+    std::uint64_t last_allocation_count = 0;
+    std::uint64_t last_allocated_bytes = 0;
+    std::uint64_t measured_bytes = 0;
+
+    engine::core::GameApp game_app;
+    game_app.setConfigOverride([&options](engine::core::Config& config) {
+        config.vsync_enabled_ = false;      // 不等待垂直同步
+        config.target_fps_ = 0;             // 不进入 Time::limitFrameRate
+        config.profile_trace_path_.clear();
+        config.job_worker_threads_ = options.job_workers;
+    });
+    benchmark::BenchmarkScene* scene = nullptr;
+    engine::object::GameObjectPool::Stats pool_stats;
+    engine::core::MemorySnapshot memory_snapshot;
+    const std::uint64_t total_frames = static_cast<std::uint64_t>(options.warmup_frames + options.frames);
+    options.scene.current_scene = &scene;  // 重新加载后场景会被替换，由场景自己在 init()/clean() 时更新
+    game_app.setSceneFactory([&options](engine::core::Context& context, engine::scene::SceneManager& scene_manager) {
+        return std::make_unique<benchmark::BenchmarkScene>(context, scene_manager, options.scene);
+    });
+    game_app.setFrameCallback([&](const engine::core::FrameTimings& timings) {
+        const std::uint64_t allocation_count = engine::core::MemoryTracker::getTotalAllocations();
+        const std::uint64_t frame_allocations = allocation_count - last_allocation_count;
+        last_allocation_count = allocation_count;
+        const std::uint64_t allocated_bytes = engine::core::MemoryTracker::getTotalAllocatedBytes();
+        const std::uint64_t frame_bytes = allocated_bytes - last_allocated_bytes;
+        last_allocated_bytes = allocated_bytes;
+        if (scene) pool_stats = scene->getPrefabRegistry().getTotalPoolStats(); // 场景在 run() 结束时销毁，逐帧记下最新统计
+        if (timings.frame_index + 1 == total_frames) memory_snapshot = engine::core::MemoryTracker::snapshot();
+        if (timings.frame_index < static_cast<std::uint64_t>(options.warmup_frames)) return;
+        measured_bytes += frame_bytes;
+        frame_ms.push_back(timings.frame_ms);
+        input_ms.push_back(timings.input_ms);
+        events_ms.push_back(timings.events_ms);
+        update_ms.push_back(timings.update_ms);
+        render_ms.push_back(timings.render_ms);
+        present_ms.push_back(timings.present_ms);
+        allocations.push_back(static_cast<double>(frame_allocations));
+        render_commands.push_back(static_cast<double>(timings.render_commands));
+        frame_arena_bytes.push_back(static_cast<double>(timings.frame_arena_bytes));
+    });
+    game_app.setMaxFrames(total_frames);
+    game_app.run();
+
+    if (frame_ms.empty())
+    {
+        spdlog::error("基准测试没有采集到任何帧（引擎初始化失败？）");
+        return 1;
+    }
+
+    if (!engine::core::MemoryTracker::isHeapTrackingEnabled())
+    {
+        spdlog::warn("未启用堆分配跟踪（FUNNYLAND_MEMORY_TRACKING），分配统计全部为 0");
+    }
+    double total_allocations = 0.0;
+    for (double count : allocations) total_allocations += count;
+    
+    nlohmann::ordered_json memory = nlohmann::ordered_json::object();
+    for (const auto& tag : memory_snapshot.tags)
+    {
+        if (tag.getTotalBytes() == 0 && tag.heap_allocations == 0 && tag.resource_count == 0) continue;
+        memory[tag.name] = {
+            {"heap_bytes", tag.heap_bytes},
+            {"heap_allocations", tag.heap_allocations},
+            {"resource_bytes", tag.resource_bytes},
+            {"resource_count", tag.resource_count},
+        };
+    }
+
+    nlohmann::ordered_json result = {
+        {"config", {
+            {"sprites", options.scene.sprite_count},
+            {"parallax_layers", options.scene.parallax_count},
+            {"pooled_components", options.scene.use_component_storage},
+            {"churn_per_second", options.scene.churn_per_second},
+            {"reload_every_frames", options.scene.reload_every_frames},
+            {"job_workers", options.job_workers},
+            {"seed", options.scene.seed},
+            {"warmup_frames", options.warmup_frames},
+            {"frames", frame_ms.size()},
+            {"video_driver", SDL_GetCurrentVideoDriver() ? SDL_GetCurrentVideoDriver() : ""},
+        }},
+        {"frame_ms", summarize(frame_ms)},
+        {"phases_ms", {
+            {"input", summarize(input_ms)},
+            {"events", summarize(events_ms)},
+            {"update", summarize(update_ms)},
+            {"render", summarize(render_ms)},
+            {"present", summarize(present_ms)},
+        }},
+        {"render_commands", summarize(render_commands)},
+        {"allocations", {
+            {"total", static_cast<std::uint64_t>(total_allocations)},
+            {"per_frame", summarize(allocations)},
+            {"bytes", measured_bytes},
+            {"frame_arena_bytes", summarize(frame_arena_bytes)},
+        }},
+        {"memory", memory},
+        {"object_pools", {
+            {"created", pool_stats.created},
+            {"active", pool_stats.active},
+            {"free", pool_stats.free},
+            {"peak_active", pool_stats.peak_active},
+            {"acquired", pool_stats.acquired},
+            {"reused", pool_stats.reused},
+        }},
+    };
+
+    const std::string text = result.dump(2);
+    if (options.output_path.empty())
+    {
+        std::cout << text << std::endl;
+    }
+    else
+    {
+        std::ofstream out(options.output_path);
+        if (!out.is_open())
+        {
+            spdlog::error("无法写入结果文件 '{}'", options.output_path);
+            return 1;
+        }
+        out << text << std::endl;
+    }
+    return 0;
+}
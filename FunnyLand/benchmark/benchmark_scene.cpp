@@ -0,0 +1,248 @@
+﻿#include "benchmark_scene.h"
+#include "../src/engine/core/context.h"
+#include "../src/engine/core/memory_tracker.h"
+#include "../src/engine/object/game_object.h"
+#include "../src/engine/component/transform_component.h"
+#include "../src/engine/component/sprite_component.h"
+#include "../src/engine/component/parallax_component.h"
+#include "../src/engine/render/camera.h"
+#include "../src/engine/scene/prefab_registry.h"
+#include "../src/engine/scene/scene_manager.h"
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <spdlog/spdlog.h>
+
+namespace benchmark
+{
+    namespace
+    {
+        constexpr float WORLD_SIZE = 4096.0f;          // 对象分布区域的边长
+        constexpr float FIXED_STEP = 1.0f / 60.0f;     // 移动按固定步长计算，保证每次运行的场景演化一致
+        constexpr const char* CHURN_PREFAB = "churn";  // 短命对象的预制体名称
+
+        constexpr std::array<const char*, 6> SPRITE_TEXTURES = {
+            "assets/textures/Props/big-crate.png",
+            "assets/textures/Props/crate.png",
+            "assets/textures/Props/bush.png",
+            "assets/textures/Items/cherry.png",
+            "assets/textures/Items/gem.png",
+            "assets/textures/Actors/frog.png",
+        };
+
+        constexpr std::array<const char*, 2> PARALLAX_TEXTURES = {
+            "assets/textures/Layers/back.png",
+            "assets/textures/Layers/middle.png",
+        };
+
+        /// @brief 让对象在世界范围内匀速漂移并在边界反弹
+        class DriftComponent final : public engine::component::Component
+        {
+            friend class engine::object::GameObject;
+        private:
+            glm::vec2 initial_velocity_;
+            glm::vec2 velocity_;
+            engine::component::TransformComponent* transform_ = nullptr;
+
+        public:
+            explicit DriftComponent(const glm::vec2& velocity) : initial_velocity_(velocity), velocity_(velocity) {}
+
+            /// @brief 只写所在对象的变换，可以在工作线程中并行更新
+            static engine::component::ComponentAccess declareAccess()
+            {
+                return engine::component::ComponentAccess{}.write<engine::component::TransformComponent>();
+            }
+
+        protected:
+            void init() override
+            {
+                transform_ = owner_->getComponent<engine::component::TransformComponent>();
+            }
+
+            void update(float, engine::core::Context&) override
+            {
+                if (!transform_) return;
+                glm::vec2 position = transform_->getPosition() + velocity_ * FIXED_STEP;
+                if (position.x < 0.0f || position.x > WORLD_SIZE) velocity_.x = -velocity_.x;
+                if (position.y < 0.0f || position.y > WORLD_SIZE) velocity_.y = -velocity_.y;
+                transform_->setPosition(position);
+            }
+
+            void reset() override { velocity_ = initial_velocity_; }
+        };
+
+        /// @brief 存活固定时间后请求场景移除所在对象（归还回收池时重置计时）
+        class LifetimeComponent final : public engine::component::Component
+        {
+            friend class engine::object::GameObject;
+        private:
+            float lifetime_;
+            float age_ = 0.0f;
+
+        public:
+            explicit LifetimeComponent(float lifetime) : lifetime_(lifetime) {}
+
+            /// @brief 只修改所在对象的删除标记
+            static engine::component::ComponentAccess declareAccess() { return {}; }
+
+        protected:
+            void update(float, engine::core::Context&) override
+            {
+                age_ += FIXED_STEP;
+                if (age_ >= lifetime_) owner_->setNeedRemoved(true);
+            }
+
+            void reset() override { age_ = 0.0f; }
+        };
+
+        constexpr const char* SCENE_NAME = "BenchmarkScene";
+        constexpr const char* RELOADING_SCENE_NAME = "BenchmarkReloading";
+
+        /// @brief 在新场景自己的内存标签下创建它（不记在发起切换的场景名下）
+        template<typename T>
+        std::unique_ptr<T> makeScene(const char* name, engine::core::Context& context, engine::scene::SceneManager& scene_manager,
+                                     const BenchmarkSceneOptions& options)
+        {
+            ENGINE_MEMORY_SCOPE(engine::scene::Scene::getMemoryTagFor(name));
+            return std::make_unique<T>(context, scene_manager, options);
+        }
+
+        /// @brief 重新加载时的加载场景：第一次更新时用一个新的基准场景重新发起预加载，取消正在进行的那次（自己随之被弹出）
+        class ReloadingScene final : public engine::scene::Scene
+        {
+        private:
+            BenchmarkSceneOptions options_;
+            bool restarted_ = false;
+
+        public:
+            ReloadingScene(engine::core::Context& context, engine::scene::SceneManager& scene_manager, const BenchmarkSceneOptions& options)
+                : Scene(RELOADING_SCENE_NAME, context, scene_manager), options_(options) {}
+
+            void update(float delta_time) override
+            {
+                Scene::update(delta_time);
+                if (restarted_) return;
+                restarted_ = true;
+                scene_manager_.requestPreloadScene(makeScene<BenchmarkScene>(SCENE_NAME, context_, scene_manager_, options_));
+            }
+        };
+    }
+
+    BenchmarkScene::BenchmarkScene(engine::core::Context& context, engine::scene::SceneManager& scene_manager, const BenchmarkSceneOptions& options)
+        : Scene(SCENE_NAME, context, scene_manager), options_(options), churn_rng_(options.seed + 1)
+    {
+    }
+
+    void BenchmarkScene::init()
+    {
+        createParallaxLayers();
+        createSprites();
+        if (options_.churn_per_second > 0) registerChurnPrefab();
+        Scene::init();
+        if (options_.current_scene) *options_.current_scene = this;
+        spdlog::info("BenchmarkScene: {} 个精灵对象, {} 层视差背景", options_.sprite_count, options_.parallax_count);
+    }
+
+    void BenchmarkScene::update(float delta_time)
+    {
+        Scene::update(delta_time);
+        spawnChurnObjects();
+
+        // 相机沿一个固定的圆形路线移动，让可见集合每帧变化
+        const float angle = static_cast<float>(frame_) * 0.01f;
+        const float radius = WORLD_SIZE * 0.35f;
+        const glm::vec2 center{WORLD_SIZE * 0.5f, WORLD_SIZE * 0.5f};
+        context_.getCamera().setPosition(center + radius * glm::vec2(std::cos(angle), std::sin(angle)));
+        ++frame_;
+        if (options_.reload_every_frames > 0 && frame_ % static_cast<std::uint64_t>(options_.reload_every_frames) == 0) requestReload();
+    }
+
+    void BenchmarkScene::clean()
+    {
+        if (options_.current_scene && *options_.current_scene == this) *options_.current_scene = nullptr;
+        Scene::clean();
+    }
+
+    engine::scene::SceneAssets BenchmarkScene::discoverAssets() const
+    {
+        engine::scene::SceneAssets assets;
+        assets.textures.assign(SPRITE_TEXTURES.begin(), SPRITE_TEXTURES.end());
+        assets.textures.insert(assets.textures.end(), PARALLAX_TEXTURES.begin(), PARALLAX_TEXTURES.end());
+        return assets;
+    }
+
+    void BenchmarkScene::requestReload()
+    {
+        if (scene_manager_.isPreloading()) return;
+        scene_manager_.requestPreloadScene(makeScene<BenchmarkScene>(SCENE_NAME, context_, scene_manager_, options_), true,
+                                           makeScene<ReloadingScene>(RELOADING_SCENE_NAME, context_, scene_manager_, options_));
+    }
+
+    void BenchmarkScene::createParallaxLayers()
+    {
+        for (int i = 0; i < options_.parallax_count; ++i)
+        {
+            auto layer = std::make_unique<engine::object::GameObject>("parallax_" + std::to_string(i));
+            layer->addComponent<engine::component::TransformComponent>();
+            const float factor = 0.3f + 0.3f * static_cast<float>(i);
+            layer->addComponent<engine::component::ParallaxComponent>(
+                PARALLAX_TEXTURES[i % PARALLAX_TEXTURES.size()], glm::vec2(factor, factor), glm::bvec2(true, false));
+            addGameObject(std::move(layer));
+        }
+    }
+
+    void BenchmarkScene::createSprites()
+    {
+        std::mt19937 rng(options_.seed);
+        std::uniform_real_distribution<float> position_dist(0.0f, WORLD_SIZE);
+        std::uniform_real_distribution<float> velocity_dist(-60.0f, 60.0f);
+        std::uniform_real_distribution<float> rotation_dist(0.0f, 360.0f);
+        auto& resource_manager = context_.getResourceManager();
+
+        for (int i = 0; i < options_.sprite_count; ++i)
+        {
+            auto object = options_.use_component_storage
+                ? createPooledGameObject("sprite")
+                : std::make_unique<engine::object::GameObject>("sprite");
+            // 四分之一的对象带旋转，覆盖旋转精灵的顶点路径
+            const float rotation = (i % 4 == 0) ? rotation_dist(rng) : 0.0f;
+            object->addComponent<engine::component::TransformComponent>(glm::vec2(position_dist(rng), position_dist(rng)), glm::vec2(1.0f), rotation);
+            object->addComponent<engine::component::SpriteComponent>(SPRITE_TEXTURES[i % SPRITE_TEXTURES.size()], resource_manager);
+            object->addComponent<DriftComponent>(glm::vec2(velocity_dist(rng), velocity_dist(rng)));
+            addGameObject(std::move(object));
+        }
+    }
+
+    void BenchmarkScene::registerChurnPrefab()
+    {
+        auto& prefabs = getPrefabRegistry();
+        engine::scene::PrefabTemplate prefab;
+        prefab.name = CHURN_PREFAB;
+        prefab.texture_id = SPRITE_TEXTURES[4];
+        prefab.alignment = engine::utils::Alignment::CENTER;
+        const float lifetime = options_.churn_lifetime;
+        prefabs.registerPrefab(std::move(prefab), [lifetime](engine::object::GameObject& object, const engine::scene::PrefabTemplate&) {
+            object.addComponent<DriftComponent>(glm::vec2(40.0f, -25.0f));
+            object.addComponent<LifetimeComponent>(lifetime);
+        });
+        // 同时存活的数量约为 每秒生成数 * 存活时间，另留两帧余量（延迟加入和延迟移除各一帧）
+        const float alive = static_cast<float>(options_.churn_per_second) * (options_.churn_lifetime + 2.0f * FIXED_STEP);
+        prefabs.prewarm(CHURN_PREFAB, static_cast<size_t>(std::ceil(alive)) + 1);
+    }
+
+    void BenchmarkScene::spawnChurnObjects()
+    {
+        if (options_.churn_per_second <= 0) return;
+        std::uniform_real_distribution<float> position_dist(0.0f, WORLD_SIZE);
+        auto& prefabs = getPrefabRegistry();
+        churn_budget_ += static_cast<float>(options_.churn_per_second) * FIXED_STEP;
+        for (; churn_budget_ >= 1.0f; churn_budget_ -= 1.0f)
+        {
+            if (auto object = prefabs.instantiate(CHURN_PREFAB, glm::vec2(position_dist(churn_rng_), position_dist(churn_rng_))))
+            {
+                safeAddGameObject(std::move(object));
+            }
+        }
+    }
+}
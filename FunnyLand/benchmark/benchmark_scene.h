@@ -0,0 +1,56 @@
+﻿#pragma once
+#include "../src/engine/scene/scene.h"
+#include <cstdint>
+#include <random>
+
+namespace benchmark
+{
+    class BenchmarkScene;
+
+    /// @brief 合成场景的参数
+    struct BenchmarkSceneOptions
+    {
+        int sprite_count = 5000;        ///< @brief 带 Transform + Sprite 的对象数量
+        int parallax_count = 2;         ///< @brief 视差背景层数量
+        bool use_component_storage = false; ///< @brief 是否使用组件池存储创建对象
+        int churn_per_second = 0;       ///< @brief 每秒（按固定步长计）通过预制体回收池生成的短命对象数量
+        float churn_lifetime = 0.5f;    ///< @brief 短命对象的存活时间（秒）
+        std::uint32_t seed = 12345;     ///< @brief 随机种子（固定种子保证每次运行的场景相同）
+        int reload_every_frames = 0;    ///< @brief 大于 0 时每隔这么多帧通过预加载切换重新加载一个新的基准场景
+        BenchmarkScene** current_scene = nullptr; ///< @brief 可选：当前运行的基准场景（init() 时写入，clean() 时清空，重新加载后仍指向有效场景）
+    };
+
+    /**
+     * @brief 基准测试用的合成场景。
+     *
+     * 在一个比视口大得多的区域内随机摆放精灵对象，每个对象带一个漂移组件让它每帧移动，
+     * 相机按固定路线移动，覆盖更新、空间网格同步、视野剔除和批量绘制的完整路径。
+     * churn_per_second > 0 时每帧按预制体生成一批短命对象，到期后由场景移除并归还回收池，
+     * 用于验证生成/销毁循环在稳定后不再分配内存。
+     * reload_every_frames > 0 时定期通过 SceneManager::requestPreloadScene 切换到新的基准场景，
+     * 加载场景会在自己的 update() 中重新发起预加载，覆盖“取消进行中的预加载”这条路径。
+     */
+    class BenchmarkScene final : public engine::scene::Scene
+    {
+    private:
+        BenchmarkSceneOptions options_;
+        std::uint64_t frame_ = 0;       ///< @brief 已更新的帧数，用于驱动相机路线
+        float churn_budget_ = 0.0f;     ///< @brief 累计的待生成对象数（小数部分留到下一帧）
+        std::mt19937 churn_rng_;        ///< @brief 短命对象的位置随机数
+
+    public:
+        BenchmarkScene(engine::core::Context& context, engine::scene::SceneManager& scene_manager, const BenchmarkSceneOptions& options);
+
+        void init() override;
+        void update(float delta_time) override;
+        void clean() override;
+        engine::scene::SceneAssets discoverAssets() const override;
+
+    private:
+        void createParallaxLayers();
+        void createSprites();
+        void registerChurnPrefab();
+        void spawnChurnObjects();
+        void requestReload();
+    };
+}
@@ -0,0 +1,122 @@
+﻿/**
+ * @file component_lookup_benchmark.cpp
+ * @brief GameObject::getComponent 微基准：旧方案（typeid + std::type_index 哈希表）对比组件类型ID（数组下标 + 位集）。
+ *
+ * 独立程序，不参与游戏工程构建。旧方案的对照组需要 RTTI。构建示例（在 FunnyLand 目录下）：
+ *   g++ -std=c++20 -O2 -I../ThirdParty/glm/include -I../ThirdParty/spdlog/include -I../ThirdParty/SDL3/include
+ *       benchmark/component_lookup_benchmark.cpp src/engine/object/game_object.cpp
+ *       src/engine/object/component_storage.cpp src/engine/scene/spatial_grid.cpp src/engine/core/job_system.cpp
+ *       src/engine/core/memory_tracker.cpp -o component_lookup_benchmark
+ *   cl /std:c++20 /O2 /EHsc ...（同样的源文件与包含目录）
+ */
+#include "../src/engine/component/component.h"
+#include "../src/engine/object/game_object.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // 几个空组件，模拟一个对象上挂着多种组件的常见情况
+    template<int N>
+    class DummyComponent final : public engine::component::Component
+    {
+    public:
+        int value = N;
+    protected:
+        void update(float, engine::core::Context&) override {}
+    };
+
+    using C0 = DummyComponent<0>;
+    using C1 = DummyComponent<1>;
+    using C2 = DummyComponent<2>;
+    using C3 = DummyComponent<3>;
+    using C4 = DummyComponent<4>;
+    using C5 = DummyComponent<5>;
+
+    /// @brief 旧版 GameObject 的查找方式：typeid -> std::type_index -> unordered_map
+    struct LegacyLookup
+    {
+        std::unordered_map<std::type_index, engine::component::Component*> components;
+
+        template<typename T>
+        T* getComponent() const
+        {
+            auto it = components.find(std::type_index(typeid(T)));
+            return it != components.end() ? static_cast<T*>(it->second) : nullptr;
+        }
+    };
+
+    constexpr int OBJECT_COUNT = 1000;
+    constexpr int ROUNDS = 2000;
+
+    template<typename Func>
+    double measureNsPerLookup(Func&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const long long checksum = func();
+        const auto end = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        std::printf("    (checksum %lld)\n", checksum);     // 防止编译器把循环优化掉
+        // 每轮每个对象查找 4 次（3 次命中 + 1 次未命中）
+        return ns / (static_cast<double>(OBJECT_COUNT) * ROUNDS * 4);
+    }
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::warn);
+
+    std::vector<std::unique_ptr<engine::object::GameObject>> objects;
+    std::vector<LegacyLookup> legacy(OBJECT_COUNT);
+    objects.reserve(OBJECT_COUNT);
+    for (int i = 0; i < OBJECT_COUNT; ++i)
+    {
+        auto object = std::make_unique<engine::object::GameObject>("bench");
+        auto& map = legacy[i].components;
+        map[std::type_index(typeid(C0))] = object->addComponent<C0>();
+        map[std::type_index(typeid(C1))] = object->addComponent<C1>();
+        map[std::type_index(typeid(C2))] = object->addComponent<C2>();
+        map[std::type_index(typeid(C3))] = object->addComponent<C3>();
+        map[std::type_index(typeid(C4))] = object->addComponent<C4>();
+        objects.push_back(std::move(object));
+    }
+    engine::object::GameObject{}.addComponent<C5>();    // 让 C5 分配到类型ID，测试未命中的路径
+
+    std::printf("getComponent x %d objects x %d rounds\n", OBJECT_COUNT, ROUNDS);
+
+    const double legacy_ns = measureNsPerLookup([&] {
+        long long sum = 0;
+        for (int r = 0; r < ROUNDS; ++r)
+            for (const auto& entry : legacy)
+            {
+                sum += entry.getComponent<C0>()->value;
+                sum += entry.getComponent<C2>()->value;
+                sum += entry.getComponent<C4>()->value;
+                sum += entry.getComponent<C5>() != nullptr;
+            }
+        return sum;
+    });
+    std::printf("  type_index + unordered_map : %6.2f ns/lookup\n", legacy_ns);
+
+    const double id_ns = measureNsPerLookup([&] {
+        long long sum = 0;
+        for (int r = 0; r < ROUNDS; ++r)
+            for (const auto& object : objects)
+            {
+                sum += object->getComponent<C0>()->value;
+                sum += object->getComponent<C2>()->value;
+                sum += object->getComponent<C4>()->value;
+                sum += object->getComponent<C5>() != nullptr;
+            }
+        return sum;
+    });
+    std::printf("  component type id + bitset : %6.2f ns/lookup\n", id_ns);
+    std::printf("  speedup                    : %6.2fx\n", legacy_ns / id_ns);
+
+    for (auto& object : objects) object->clean();
+    return 0;
+}
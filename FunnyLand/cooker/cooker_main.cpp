@@ -0,0 +1,337 @@
+/**
+ * @file cooker_main.cpp
+ * @brief 离线资源烘焙工具：把 assets/ 打包成一个资源包文件，运行时由 ResourceManager 内存映射挂载。
+ *
+ * - 图片（png/jpg/bmp）预解码为 RGBA32 像素，运行时不再解码；
+ * - Tiled 地图（tmj）转换为二进制关卡（图块集内嵌、路径预解析），运行时不构建 JSON DOM；
+ * - 其他 JSON（图块集 tsj、配置等）预解析并转存为 MessagePack；
+ * - 其他文件（音频、字体）按原始字节存储，运行时通过 SDL_IOStream 直接读取映射内存。
+ * 生成后会重新挂载一次输出文件校验。
+ *
+ * 工作目录需为 FunnyLand/（与游戏相同，包内路径相对该目录，如 assets/textures/a.png）。
+ * 用法：FunnyLandCooker [--input assets] [--output assets.pak] [--exclude assets/cache]
+ *       FunnyLandCooker --convert-level assets/maps/level1.tmj assets/maps/level1.flvl   （只转换单个关卡）
+ */
+#include "../src/engine/resource/asset_archive.h"
+#include "../src/engine/scene/binary_level.h"
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using engine::resource::ArchiveEntryType;
+    using engine::resource::ArchiveHeader;
+    using engine::resource::ArchiveTocEntry;
+
+    struct CookerOptions
+    {
+        std::string input = "assets";
+        std::string output = "assets.pak";
+        std::vector<std::string> excludes = {"assets/cache"};  //运行时生成的缓存（纹理图集）不打包
+    };
+
+    //烘焙后的一个条目
+    struct CookedEntry
+    {
+        std::string path;
+        ArchiveTocEntry toc{};
+        std::vector<std::uint8_t> data;
+    };
+
+    bool parseArgs(int argc, char* argv[], CookerOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                spdlog::error("参数 {} 缺少取值", arg);
+                return false;
+            }
+            if (arg == "--input") options.input = argv[++i];
+            else if (arg == "--output") options.output = argv[++i];
+            else if (arg == "--exclude") options.excludes.emplace_back(argv[++i]);
+            else
+            {
+                spdlog::error("未知参数 {}", arg);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readFileBytes(const std::filesystem::path& path, std::vector<std::uint8_t>& bytes)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool isImage(const std::string& extension)
+    {
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp";
+    }
+
+    bool isJson(const std::string& extension)
+    {
+        return extension == ".json" || extension == ".tsj" || extension == ".tj";
+    }
+
+    //图片：解码并转换为 RGBA32，按紧凑行距存储
+    bool cookImage(const std::filesystem::path& path, CookedEntry& entry)
+    {
+        SDL_Surface* loaded = IMG_Load(path.string().c_str());
+        if (!loaded)
+        {
+            spdlog::error("解码图片失败 {} : {}", path.string(), SDL_GetError());
+            return false;
+        }
+        SDL_Surface* rgba = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!rgba)
+        {
+            spdlog::error("转换图片格式失败 {} : {}", path.string(), SDL_GetError());
+            return false;
+        }
+        const auto row_bytes = static_cast<size_t>(rgba->w) * 4;
+        entry.data.resize(row_bytes * static_cast<size_t>(rgba->h));
+        for (int y = 0; y < rgba->h; ++y)
+        {
+            std::memcpy(entry.data.data() + row_bytes * y, static_cast<const std::uint8_t*>(rgba->pixels) + static_cast<size_t>(rgba->pitch) * y, row_bytes);
+        }
+        entry.toc.type = ArchiveEntryType::Texture;
+        entry.toc.width = static_cast<std::uint32_t>(rgba->w);
+        entry.toc.height = static_cast<std::uint32_t>(rgba->h);
+        entry.toc.pitch = static_cast<std::uint32_t>(row_bytes);
+        entry.toc.format = static_cast<std::uint32_t>(SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(rgba);
+        return true;
+    }
+
+    //JSON：解析后转存为 MessagePack，运行时省去文本解析
+    bool cookJson(const std::filesystem::path& path, CookedEntry& entry)
+    {
+        std::ifstream file(path);
+        try
+        {
+            const nlohmann::json json_data = nlohmann::json::parse(file);
+            entry.data = nlohmann::json::to_msgpack(json_data);
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            spdlog::error("解析 JSON 失败 {} : {}", path.string(), e.what());
+            return false;
+        }
+        entry.toc.type = ArchiveEntryType::MsgPack;
+        return true;
+    }
+
+    //Tiled 地图：转换为二进制关卡，包内路径保持 .tmj，LevelLoader 按条目类型识别
+    bool cookLevel(const std::filesystem::path& path, CookedEntry& entry)
+    {
+        if (!engine::scene::convertTiledLevel(path.generic_string(), entry.data))
+        {
+            spdlog::error("转换关卡失败 {}", path.string());
+            return false;
+        }
+        entry.toc.type = ArchiveEntryType::Level;
+        return true;
+    }
+
+    bool writeFileBytes(const std::string& path, const std::vector<std::uint8_t>& bytes)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool cookFile(const std::filesystem::path& path, CookedEntry& entry)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (isImage(extension)) return cookImage(path, entry);
+        if (extension == ".tmj") return cookLevel(path, entry);
+        if (isJson(extension)) return cookJson(path, entry);
+
+        entry.toc.type = ArchiveEntryType::Raw;
+        if (!readFileBytes(path, entry.data))
+        {
+            spdlog::error("读取文件失败 {}", path.string());
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<std::string> collectFiles(const CookerOptions& options)
+    {
+        std::vector<std::string> files;
+        for (const auto& item : std::filesystem::recursive_directory_iterator(options.input))
+        {
+            if (!item.is_regular_file()) continue;
+            const std::string path = item.path().lexically_normal().generic_string();
+            const bool excluded = std::any_of(options.excludes.begin(), options.excludes.end(),
+                [&path](const std::string& prefix) { return path.rfind(prefix, 0) == 0; });
+            if (!excluded) files.push_back(path);
+        }
+        //排序保证相同输入生成相同的资源包
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    void writePadding(std::ofstream& out, std::uint64_t& offset)
+    {
+        static const char zeros[engine::resource::ARCHIVE_ALIGNMENT] = {};
+        const std::uint64_t padding = (engine::resource::ARCHIVE_ALIGNMENT - offset % engine::resource::ARCHIVE_ALIGNMENT) % engine::resource::ARCHIVE_ALIGNMENT;
+        out.write(zeros, static_cast<std::streamsize>(padding));
+        offset += padding;
+    }
+
+    bool writeArchive(const std::string& output_path, std::vector<CookedEntry>& entries)
+    {
+        //先写到临时文件，成功后再替换，避免游戏挂载到写了一半的资源包
+        const std::string temp_path = output_path + ".tmp";
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            spdlog::error("无法写入 {}", temp_path);
+            return false;
+        }
+
+        ArchiveHeader header{};
+        std::memcpy(header.magic, engine::resource::ARCHIVE_MAGIC, sizeof(header.magic));
+        header.version = engine::resource::ARCHIVE_VERSION;
+        header.entry_count = static_cast<std::uint32_t>(entries.size());
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::uint64_t offset = sizeof(header);
+
+        //1. 数据区：每个条目按 16 字节对齐，纹理像素可以直接作为 Surface 像素使用
+        std::string strings;
+        for (auto& entry : entries)
+        {
+            writePadding(out, offset);
+            entry.toc.data_offset = offset;
+            entry.toc.data_size = entry.data.size();
+            out.write(reinterpret_cast<const char*>(entry.data.data()), static_cast<std::streamsize>(entry.data.size()));
+            offset += entry.data.size();
+
+            entry.toc.path_offset = strings.size();
+            entry.toc.path_length = static_cast<std::uint32_t>(entry.path.size());
+            strings += entry.path;
+        }
+
+        //2. 路径字符串表
+        header.strings_offset = offset;
+        header.strings_size = strings.size();
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        offset += strings.size();
+
+        //3. 目录
+        writePadding(out, offset);
+        header.toc_offset = offset;
+        for (const auto& entry : entries)
+        {
+            out.write(reinterpret_cast<const char*>(&entry.toc), sizeof(entry.toc));
+        }
+
+        //4. 回填文件头
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        if (!out)
+        {
+            spdlog::error("写入 {} 失败", temp_path);
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path, output_path, ec);
+        if (ec)
+        {
+            spdlog::error("无法替换 {} : {}", output_path, ec.message());
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc == 4 && std::string(argv[1]) == "--convert-level")
+    {
+        std::vector<std::uint8_t> level_data;
+        if (!engine::scene::convertTiledLevel(argv[2], level_data) || !writeFileBytes(argv[3], level_data))
+        {
+            spdlog::error("转换关卡 {} -> {} 失败", argv[2], argv[3]);
+            return 1;
+        }
+        spdlog::info("转换关卡 {} -> {}（{} 字节）", argv[2], argv[3], level_data.size());
+        return 0;
+    }
+
+    CookerOptions options;
+    if (!parseArgs(argc, argv, options))
+    {
+        spdlog::info("用法：FunnyLandCooker [--input assets] [--output assets.pak] [--exclude assets/cache]");
+        spdlog::info("      FunnyLandCooker --convert-level <map.tmj> <level.flvl>");
+        return 1;
+    }
+    if (!std::filesystem::is_directory(options.input))
+    {
+        spdlog::error("输入目录 {} 不存在（工作目录需为 FunnyLand/）", options.input);
+        return 1;
+    }
+
+    const auto files = collectFiles(options);
+    std::vector<CookedEntry> entries;
+    entries.reserve(files.size());
+    size_t failed = 0;
+    size_t textures = 0;
+    size_t jsons = 0;
+    size_t levels = 0;
+    for (const auto& file : files)
+    {
+        CookedEntry entry;
+        entry.path = file;
+        if (!cookFile(file, entry))
+        {
+            ++failed;
+            continue;
+        }
+        if (entry.toc.type == ArchiveEntryType::Texture) ++textures;
+        if (entry.toc.type == ArchiveEntryType::MsgPack) ++jsons;
+        if (entry.toc.type == ArchiveEntryType::Level) ++levels;
+        entries.push_back(std::move(entry));
+    }
+    if (failed > 0)
+    {
+        //资源有问题时不生成资源包，避免运行时静默回退到散文件
+        spdlog::error("{} 个文件处理失败，未生成资源包", failed);
+        return 1;
+    }
+
+    if (!writeArchive(options.output, entries)) return 1;
+
+    //重新挂载校验
+    engine::resource::AssetArchive archive;
+    if (!archive.open(options.output) || archive.getEntryCount() != entries.size())
+    {
+        spdlog::error("校验资源包 {} 失败", options.output);
+        return 1;
+    }
+    spdlog::info("生成资源包 {}：{} 个条目（{} 张纹理，{} 个关卡，{} 个 JSON，{} 个原始文件）", options.output, entries.size(),
+                 textures, levels, jsons, entries.size() - textures - levels - jsons);
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "chunked_tile_layer_component.h"
+#include "transform_component.h"
+#include "../object/game_object.h"
+#include "../core/context.h"
+#include "../render/renderer.h"
+#include "../render/camera.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::component
+{
+    namespace
+    {
+        //向下取整的整数除法（图块坐标可以为负）
+        int floorDiv(int value, int divisor)
+        {
+            const int quotient = value / divisor;
+            return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+        }
+    }
+
+    ChunkedTileLayerComponent::ChunkedTileLayerComponent(const glm::vec2& tile_size, const glm::ivec2& chunk_size,
+                                                         std::shared_ptr<const TileSetList> tilesets)
+        : tile_size_(tile_size), chunk_size_(glm::max(chunk_size, glm::ivec2(1))), tilesets_(std::move(tilesets))
+    {
+        max_overhang_ = computeTileOverhang(tilesets_.get(), tile_size_);
+        spdlog::trace("ChunkedTileLayerComponent 构造完成，区块 {}x{} 图块", chunk_size_.x, chunk_size_.y);
+    }
+
+    void ChunkedTileLayerComponent::loadChunk(const glm::ivec2& chunk_coord, const glm::ivec2& position, const glm::ivec2& size,
+                                              std::vector<std::uint32_t>&& gids)
+    {
+        Chunk chunk;
+        chunk.position = position;
+        chunk.size = glm::clamp(size, glm::ivec2(0), chunk_size_);
+        chunk.gids = std::move(gids);
+        if (chunk.gids.size() != static_cast<size_t>(chunk.size.x) * static_cast<size_t>(chunk.size.y))
+        {
+            spdlog::error("ChunkedTileLayerComponent: 区块 ({}, {}) 的 gid 数量 {} 与尺寸 {}x{} 不一致",
+                          chunk_coord.x, chunk_coord.y, chunk.gids.size(), chunk.size.x, chunk.size.y);
+            chunk.gids.resize(static_cast<size_t>(chunk.size.x) * static_cast<size_t>(chunk.size.y), 0);
+        }
+
+        unloadChunk(chunk_coord);
+        resident_bytes_ += chunkBytes(chunk);
+        chunks_.emplace(chunkKey(chunk_coord), std::move(chunk));
+    }
+
+    void ChunkedTileLayerComponent::unloadChunk(const glm::ivec2& chunk_coord)
+    {
+        auto it = chunks_.find(chunkKey(chunk_coord));
+        if (it == chunks_.end()) return;
+        resident_bytes_ -= chunkBytes(it->second);
+        chunks_.erase(it);
+    }
+
+    void ChunkedTileLayerComponent::unloadAllChunks()
+    {
+        chunks_.clear();
+        resident_bytes_ = 0;
+    }
+
+    bool ChunkedTileLayerComponent::isChunkLoaded(const glm::ivec2& chunk_coord) const
+    {
+        return chunks_.contains(chunkKey(chunk_coord));
+    }
+
+    std::uint32_t ChunkedTileLayerComponent::getGid(int x, int y) const
+    {
+        auto it = chunks_.find(chunkKey(chunkCoordOf({x, y})));
+        if (it == chunks_.end()) return 0;
+        const auto& chunk = it->second;
+        const int local_x = x - chunk.position.x;
+        const int local_y = y - chunk.position.y;
+        if (local_x < 0 || local_y < 0 || local_x >= chunk.size.x || local_y >= chunk.size.y) return 0;
+        return chunk.gids[static_cast<size_t>(local_y) * chunk.size.x + local_x];
+    }
+
+    glm::ivec2 ChunkedTileLayerComponent::chunkCoordOf(const glm::ivec2& tile_coord) const
+    {
+        return {floorDiv(tile_coord.x, chunk_size_.x), floorDiv(tile_coord.y, chunk_size_.y)};
+    }
+
+    void ChunkedTileLayerComponent::init()
+    {
+        if (!owner_)
+        {
+            spdlog::error("ChunkedTileLayerComponent 初始化失败, 没有所属对象");
+            return;
+        }
+        transform_ = owner_->getComponent<TransformComponent>();
+        if (!transform_)
+        {
+            spdlog::warn("GameObject '{}' 上的 ChunkedTileLayerComponent 没有 TransformComponent，图层偏移按 (0,0) 处理。", owner_->getName());
+        }
+    }
+
+    void ChunkedTileLayerComponent::render(engine::core::Context& context)
+    {
+        if (is_hidden_ || chunks_.empty()) return;
+
+        const auto& camera = context.getCamera();
+        const glm::vec2 layer_pos = transform_ ? transform_->getInterpolatedPosition(context.getInterpolationAlpha()) : glm::vec2(0.0f);
+
+        //相机视野转换到图层局部坐标，计算相交的区块范围
+        const glm::vec2 view_min = camera.getPosition() - layer_pos;
+        const glm::vec2 view_max = view_min + camera.getViewportSize();
+        const glm::vec2 chunk_pixel_size = getChunkPixelSize();
+
+        const int min_cx = static_cast<int>(std::floor((view_min.x - max_overhang_.x) / chunk_pixel_size.x));
+        const int max_cx = static_cast<int>(std::floor(view_max.x / chunk_pixel_size.x));
+        const int min_cy = static_cast<int>(std::floor(view_min.y / chunk_pixel_size.y));
+        const int max_cy = static_cast<int>(std::floor((view_max.y + max_overhang_.y) / chunk_pixel_size.y));
+
+        auto& renderer = context.getRenderer();
+        for (int cy = min_cy; cy <= max_cy; ++cy)
+        {
+            for (int cx = min_cx; cx <= max_cx; ++cx)
+            {
+                auto it = chunks_.find(chunkKey({cx, cy}));
+                if (it == chunks_.end()) continue;
+                auto& chunk = it->second;
+                if (!chunk.is_baked)
+                {
+                    bakeChunk(chunk, context);
+                }
+                const glm::vec2 origin = layer_pos + chunkVertexOrigin(chunk.position, tile_size_, max_overhang_);
+                for (const auto& batch : chunk.batches)
+                {
+                    renderer.drawGeometry(camera, batch.texture_handle, batch.vertices, origin);
+                }
+            }
+        }
+    }
+
+    void ChunkedTileLayerComponent::bakeChunk(Chunk& chunk, engine::core::Context& context)
+    {
+        resident_bytes_ -= chunkBytes(chunk);
+        bakeTileRegion(chunk.gids.data(), chunk.size.x, chunk.size, chunk.position, chunkVertexOrigin(chunk.position, tile_size_, max_overhang_),
+                       tilesets_.get(), tile_size_, context.getResourceManager(), chunk.batches);
+        chunk.is_baked = true;
+        resident_bytes_ += chunkBytes(chunk);
+    }
+
+    size_t ChunkedTileLayerComponent::chunkBytes(const Chunk& chunk)
+    {
+        size_t bytes = sizeof(Chunk) + chunk.gids.capacity() * sizeof(std::uint32_t);
+        for (const auto& batch : chunk.batches)
+        {
+            bytes += sizeof(TileBatch) + batch.vertices.capacity() * sizeof(SDL_Vertex);
+        }
+        return bytes;
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "./component.h"
+#include "tile_layer_component.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::component
+{
+    class TransformComponent;
+
+    /**
+     * @brief 渲染 Tiled 无限地图（infinite）图块图层的组件。
+     *
+     * 与 TileLayerComponent 不同，图层没有固定范围，只保存当前驻留的区块（Tiled 导出的 chunk），
+     * 区块由 LevelStreamer 按相机位置载入和卸载。区块首次可见时烘焙成顶点缓冲，
+     * 每帧只提交与相机视野相交的已驻留区块。
+     * 区块坐标 = 区块左上角图块坐标 / 区块尺寸（图块坐标可以为负）。
+     */
+    class ChunkedTileLayerComponent final : public engine::component::Component
+    {
+        friend class engine::object::GameObject;
+
+    private:
+        /// @brief 一个驻留的区块
+        struct Chunk
+        {
+            glm::ivec2 position = {0, 0};           ///< @brief 左上角的图块坐标
+            glm::ivec2 size = {0, 0};               ///< @brief 尺寸（图块数）
+            std::vector<std::uint32_t> gids;        ///< @brief 行优先的 gid
+            std::vector<TileBatch> batches;         ///< @brief 烘焙结果
+            bool is_baked = false;
+        };
+
+        TransformComponent* transform_ = nullptr;                   ///< @brief 缓存变换组件（位置即图层偏移）
+
+        glm::vec2 tile_size_;                                       ///< @brief 地图网格尺寸（像素）
+        glm::ivec2 chunk_size_;                                     ///< @brief 区块尺寸（图块数），同一图层的区块尺寸相同
+        std::shared_ptr<const TileSetList> tilesets_;               ///< @brief 图块集列表
+        std::unordered_map<std::int64_t, Chunk> chunks_;            ///< @brief 区块坐标 -> 驻留的区块
+        glm::vec2 max_overhang_ = {0.0f, 0.0f};                     ///< @brief 图片集合中的图块超出网格的最大尺寸（向右、向上）
+        size_t resident_bytes_ = 0;                                 ///< @brief 驻留区块占用的内存（gid 和顶点）
+        bool is_hidden_ = false;                                    ///< @brief 是否隐藏
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param tile_size 地图网格尺寸（像素）
+         * @param chunk_size 区块尺寸（图块数）
+         * @param tilesets 按 first_gid 升序排列的图块集
+         */
+        ChunkedTileLayerComponent(const glm::vec2& tile_size, const glm::ivec2& chunk_size, std::shared_ptr<const TileSetList> tilesets);
+
+        /**
+         * @brief 载入一个区块（已驻留时替换）。
+         * @param chunk_coord 区块坐标
+         * @param position 区块左上角的图块坐标
+         * @param size 区块尺寸（图块数），不超过构造时的区块尺寸
+         * @param gids 行优先的 gid，长度应为 size.x * size.y
+         */
+        void loadChunk(const glm::ivec2& chunk_coord, const glm::ivec2& position, const glm::ivec2& size, std::vector<std::uint32_t>&& gids);
+        void unloadChunk(const glm::ivec2& chunk_coord);                        ///< @brief 卸载一个区块（未驻留时忽略）
+        void unloadAllChunks();                                                 ///< @brief 卸载全部区块
+        bool isChunkLoaded(const glm::ivec2& chunk_coord) const;                ///< @brief 区块是否驻留
+
+        std::uint32_t getGid(int x, int y) const;                               ///< @brief 获取指定图块坐标的 gid（含翻转标志），所在区块未驻留时返回 0
+
+        const glm::vec2& getTileSize() const { return tile_size_; }             ///< @brief 获取网格尺寸
+        const glm::ivec2& getChunkSize() const { return chunk_size_; }          ///< @brief 获取区块尺寸（图块数）
+        glm::vec2 getChunkPixelSize() const { return tile_size_ * glm::vec2(chunk_size_); }  ///< @brief 获取区块尺寸（像素）
+        size_t getLoadedChunkCount() const { return chunks_.size(); }           ///< @brief 驻留的区块数
+        size_t getResidentBytes() const { return resident_bytes_; }             ///< @brief 驻留区块占用的内存（gid 和已烘焙的顶点）
+        bool isHidden() const { return is_hidden_; }                            ///< @brief 获取是否隐藏
+        void setHidden(bool hidden) { is_hidden_ = hidden; }                    ///< @brief 设置是否隐藏
+
+        /// @brief 区块坐标打包为哈希键（LevelStreamer 与本组件共用）
+        static std::int64_t chunkKey(const glm::ivec2& chunk_coord)
+        {
+            return (static_cast<std::int64_t>(chunk_coord.x) << 32) | static_cast<std::uint32_t>(chunk_coord.y);
+        }
+        /// @brief 图块坐标所在的区块坐标（向下取整）
+        glm::ivec2 chunkCoordOf(const glm::ivec2& tile_coord) const;
+
+    protected:
+        void init() override;
+        void update(float, engine::core::Context&) override {}
+        void render(engine::core::Context& context) override;
+
+    private:
+        void bakeChunk(Chunk& chunk, engine::core::Context& context);           ///< @brief 把一个区块烘焙为按纹理分组的顶点缓冲
+        static size_t chunkBytes(const Chunk& chunk);                           ///< @brief 区块占用的内存
+    };
+}
@@ -1,7 +1,11 @@
 ﻿#pragma once
+#include <optional>
+#include "../utils/math.h"
+
 namespace engine::object
 {
     class GameObject;
+    template<typename T> class ComponentPool;
 }
 
 namespace engine::core
@@ -22,6 +26,7 @@ namespace engine::component
     class Component
     {
         friend class engine::object::GameObject;  // 它需要调用Component的init方法
+        template<typename T> friend class engine::object::ComponentPool;  // 组件池需要按类型批量调用update
         
     protected:
         engine::object::GameObject* owner_ = nullptr;   ///< @brief 指向拥有此组件的 GameObject
@@ -39,6 +44,13 @@ namespace engine::component
         void setOwner(engine::object::GameObject* const owner){ owner_ = owner; } ///< @brief 设置组件的所有者 GameObject
         engine::object::GameObject* getOwner(){ return owner_; } ///< @brief 获取组件的所有者 GameObject
         
+        /**
+         * @brief 获取组件渲染内容在世界坐标中的包围盒，用于视野剔除。
+         *        返回 std::nullopt 表示组件没有可剔除的范围（例如全屏背景），所在对象将始终参与渲染。
+         *        包围盒变化时应调用 owner_->markBoundsDirty()。
+         */
+        virtual std::optional<engine::utils::Rect> getRenderBounds() const { return std::nullopt; }
+        
     protected:
         
         virtual void init() {}  //GameObject 添加组件时自动调用 不需要外部调用
@@ -48,6 +60,12 @@ namespace engine::component
         virtual void render(engine::core::Context&) {}
         virtual void clean() {}
         
+        /**
+         * @brief 所在对象归还回收池（GameObjectPool）时调用：清除运行时状态（速度、计时器、动画进度等），
+         *        保留已分配的资源和对其他组件的引用，对象再次取出时不会重新 init()。
+         */
+        virtual void reset() {}
+        
     };
     
 }
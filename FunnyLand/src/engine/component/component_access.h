@@ -0,0 +1,88 @@
+﻿#pragma once
+#include <bitset>
+#include <concepts>
+#include "component_type_id.h"
+
+namespace engine::component
+{
+    using ComponentMask = std::bitset<MAX_COMPONENT_TYPES>;  ///< @brief 以组件类型ID为下标的位集
+
+    /**
+     * @brief 组件类型在 update() 中对其他组件的访问声明，Scene 据此把组件池的批量更新分成可并行的阶段。
+     *
+     * 组件类型通过静态成员函数声明访问，声明即表示该类型可以在工作线程中更新：
+     * @code
+     * static engine::component::ComponentAccess declareAccess()
+     * {
+     *     return engine::component::ComponentAccess{}.read<VelocityComponent>().write<TransformComponent>();
+     * }
+     * @endcode
+     * 约定：update() 只读写本组件、所在对象上声明过的组件和只读的 Context 数据（如输入状态、时间），
+     * 不调用 SDL/渲染器，不添加/删除组件或对象（setNeedRemoved 除外）。
+     * 同一类型的组件按对象分段并行更新，因此不能访问其他对象上被写入的组件。
+     * 没有声明的类型视为可能访问任何东西，在主线程中串行更新，并且前后的阶段都不会越过它。
+     *
+     * 写入某个组件会连带访问同一对象上其他组件时（例如 TransformComponent::setScale 会更新 SpriteComponent 的偏移），
+     * 被写入的类型用静态成员函数 declareWriteEffects() 声明这些连带访问，write<T>() 会把它们一并记入，
+     * 这样写 Transform 的类型与写 Sprite 的类型不会被分到同一阶段。
+     * （所在对象的包围盒标记 GameObject::markBoundsDirty 是原子操作，不需要声明。）
+     */
+    struct ComponentAccess;
+
+    /// @brief 组件类型 T 是否声明了写入时的连带访问
+    template<typename T>
+    concept DeclaresWriteEffects = requires { { T::declareWriteEffects() } -> std::convertible_to<ComponentAccess>; };
+
+    struct ComponentAccess
+    {
+        ComponentMask reads;            ///< @brief 读取的组件类型
+        ComponentMask writes;           ///< @brief 写入的组件类型（总是包含自身类型）
+        bool main_thread = false;       ///< @brief 是否必须在主线程中串行更新
+
+        template<typename... Ts>
+        ComponentAccess& read() { (reads.set(getComponentTypeId<Ts>()), ...); return *this; }
+        /// @brief 写入 Ts（连同各类型声明的连带访问）
+        template<typename... Ts>
+        ComponentAccess& write() { (writeOne<Ts>(), ...); return *this; }
+
+        /// @brief 两个类型能否在同一阶段中同时更新（一方写入的类型被另一方读写即冲突）
+        bool conflictsWith(const ComponentAccess& other) const
+        {
+            return (writes & (other.reads | other.writes)).any() || (other.writes & reads).any();
+        }
+        
+        /// @brief 合并另一份声明（用于连带访问）
+        ComponentAccess& merge(const ComponentAccess& other)
+        {
+            reads |= other.reads;
+            writes |= other.writes;
+            main_thread = main_thread || other.main_thread;
+            return *this;
+        }
+        
+    private:
+        template<typename T>
+        void writeOne()
+        {
+            const auto type_id = getComponentTypeId<T>();
+            if (writes.test(type_id)) return;   //已记入（连带访问不要互相声明写入，否则会无限递归）
+            writes.set(type_id);
+            if constexpr (DeclaresWriteEffects<T>) merge(T::declareWriteEffects());
+        }
+    };
+
+    /// @brief 组件类型 T 是否声明了访问
+    template<typename T>
+    concept DeclaresComponentAccess = requires { { T::declareAccess() } -> std::convertible_to<ComponentAccess>; };
+
+    /// @brief 获取组件类型 T 的访问声明（未声明时为主线程串行）
+    template<typename T>
+    ComponentAccess getComponentAccess()
+    {
+        ComponentAccess access;
+        if constexpr (DeclaresComponentAccess<T>) access = T::declareAccess();
+        else access.main_thread = true;
+        access.write<T>();  //总是写入自身类型（连同它的连带访问）
+        return access;
+    }
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <string_view>
+#include <spdlog/spdlog.h>
+
+namespace engine::component
+{
+    class Component;
+
+    using ComponentTypeId = std::uint32_t;                    ///< @brief 组件类型ID，从 0 开始连续分配
+    inline constexpr ComponentTypeId MAX_COMPONENT_TYPES = 64; ///< @brief 组件类型数量上限（GameObject 用定长位集记录已有组件）
+
+    /**
+     * @brief 获取组件类型 T 的名字（仅用于日志），从编译器的函数签名中截取，不依赖 RTTI。
+     */
+    template<typename T>
+    constexpr std::string_view getComponentTypeName()
+    {
+#if defined(_MSC_VER)
+        // "... getComponentTypeName<class engine::component::XXX>(void)"
+        constexpr std::string_view signature = __FUNCSIG__;
+        constexpr std::string_view prefix = "getComponentTypeName<";
+        constexpr std::string_view suffix = ">(void)";
+#else
+        // "... getComponentTypeName() [with T = engine::component::XXX; ...]" 或 "[T = engine::component::XXX]"
+        constexpr std::string_view signature = __PRETTY_FUNCTION__;
+        constexpr std::string_view prefix = "T = ";
+        constexpr std::string_view suffix = "]";
+#endif
+        const size_t begin = signature.find(prefix);
+        if (begin == std::string_view::npos) return signature;
+        std::string_view name = signature.substr(begin + prefix.size());
+        size_t end = name.find(';');
+        if (end == std::string_view::npos) end = name.rfind(suffix);
+        if (end != std::string_view::npos) name = name.substr(0, end);
+        for (std::string_view keyword : {std::string_view{"class "}, std::string_view{"struct "}})
+        {
+            if (name.starts_with(keyword)) name.remove_prefix(keyword.size());
+        }
+        return name;
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief 分配下一个组件类型ID（仅由 getComponentTypeId 调用）。
+         * 组件可能在工作线程中第一次被查找，计数器用原子操作；超过 MAX_COMPONENT_TYPES 时记录日志并终止程序
+         * （GameObject 的位集和组件数组都按这个上限定长，越界写入比直接退出更难排查）。
+         */
+        inline ComponentTypeId nextComponentTypeId(std::string_view type_name)
+        {
+            static std::atomic<ComponentTypeId> counter{0};
+            const ComponentTypeId id = counter.fetch_add(1, std::memory_order_relaxed);
+            if (id >= MAX_COMPONENT_TYPES)
+            {
+                spdlog::critical("组件类型 '{}' 的ID {} 超过上限 MAX_COMPONENT_TYPES = {}", type_name, id, MAX_COMPONENT_TYPES);
+                std::abort();
+            }
+            return id;
+        }
+    }
+
+    /**
+     * @brief 获取组件类型 T 的ID（静态计数器方案，不依赖 RTTI）。
+     *
+     * 每个类型在第一次调用时分配一个ID，之后只是读取一个函数内静态变量，
+     * 因此 GameObject 可以直接用它做数组下标和位集测试，而不必对 std::type_index 做哈希查找。
+     * 同一次运行中ID固定，但不同运行之间的分配顺序可能不同，不要持久化。
+     */
+    template<typename T>
+    ComponentTypeId getComponentTypeId()
+    {
+        static const ComponentTypeId id = detail::nextComponentTypeId(getComponentTypeName<T>());
+        return id;
+    }
+}
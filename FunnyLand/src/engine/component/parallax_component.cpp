@@ -37,5 +37,6 @@ void engine::component::ParallaxComponent::render(engine::core::Context& context
         return;
     }
     // 直接调用视差滚动绘制函数
-    context.getRenderer().drawParallax(context.getCamera(), sprite_, transform_->getPosition(), scroll_factor_, repeat_, transform_->getScale());  
+    const float alpha = context.getInterpolationAlpha();
+    context.getRenderer().drawParallax(context.getCamera(), sprite_, transform_->getInterpolatedPosition(alpha), scroll_factor_, repeat_, transform_->getInterpolatedScale(alpha));  
 }
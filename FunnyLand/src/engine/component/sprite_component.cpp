@@ -4,6 +4,8 @@
 #include "../core/context.h"
 #include "../render/renderer.h"
 #include "../resource/resource_manager.h"
+#include "../resource/texture_atlas.h"
+#include <cmath>
 #include <spdlog/spdlog.h>
 
 namespace engine::component {
@@ -25,11 +27,23 @@ SpriteComponent::SpriteComponent(
     spdlog::trace("创建 SpriteComponent，纹理ID: {}", texture_id);
 }
 
+SpriteComponent::SpriteComponent(const engine::render::Sprite& sprite, engine::resource::ResourceManager& resource_manager,
+                                 engine::utils::Alignment alignment)
+    : resource_manager_(&resource_manager), sprite_(sprite), alignment_(alignment)
+{
+    spdlog::trace("创建 SpriteComponent，纹理ID: {}", sprite_.getTextureId());
+}
+
 void SpriteComponent::init() {
     if (!owner_) {
         spdlog::error("SpriteComponent 在初始化前未设置所有者。");
         return;
     }
+    // 解析一次纹理句柄，之后渲染不再需要字符串查找（传入已解析的精灵时跳过）
+    if (sprite_.getTextureHandle() == engine::resource::INVALID_TEXTURE_HANDLE) {
+        resolveTextureHandle();
+    }
+    
     transform_ = owner_->getComponent<TransformComponent>();
     if (!transform_) {
         spdlog::warn(
@@ -51,6 +65,10 @@ void SpriteComponent::setAlignment(engine::utils::Alignment anchor) {
 }
 
 void SpriteComponent::updateOffset() {
+    // 偏移或尺寸变化都会改变包围盒
+    if (owner_) {
+        owner_->markBoundsDirty();
+    }
     // 如果尺寸无效，偏移为0
     if (sprite_size_.x <= 0 || sprite_size_.y <= 0) {
         offset_ = {0.0f, 0.0f};
@@ -73,15 +91,36 @@ void SpriteComponent::updateOffset() {
     }
 }
 
+std::optional<engine::utils::Rect> SpriteComponent::getRenderBounds() const {
+    if (!transform_) {
+        return std::nullopt;
+    }
+    const glm::vec2 pos = transform_->getPosition() + offset_;
+    const glm::vec2 size = sprite_size_ * transform_->getScale();
+    const float rotation_degrees = transform_->getRotation();
+    if (rotation_degrees == 0.0f) {
+        return engine::utils::Rect{pos, size};
+    }
+    // 渲染时绕目标矩形中心旋转，取旋转后矩形的轴对齐包围盒
+    const float radians = rotation_degrees * (SDL_PI_F / 180.0f);
+    const float c = std::abs(std::cos(radians));
+    const float s = std::abs(std::sin(radians));
+    const glm::vec2 half = size * 0.5f;
+    const glm::vec2 center = pos + half;
+    const glm::vec2 rotated_half = {half.x * c + half.y * s, half.x * s + half.y * c};
+    return engine::utils::Rect{center - rotated_half, rotated_half * 2.0f};
+}
+
 void SpriteComponent::render(engine::core::Context& context) {
     if (is_hidden_ || !transform_ || !resource_manager_) {
         return;
     }
 
-    // 获取变换信息（考虑偏移量）
-    const glm::vec2& pos = transform_->getPosition() + offset_;
-    const glm::vec2& scale = transform_->getScale();
-    float rotation_degrees = transform_->getRotation();
+    // 获取变换信息（考虑偏移量），按插值系数取上一模拟步与当前步之间的状态
+    const float alpha = context.getInterpolationAlpha();
+    const glm::vec2 pos = transform_->getInterpolatedPosition(alpha) + offset_;
+    const glm::vec2 scale = transform_->getInterpolatedScale(alpha);
+    float rotation_degrees = transform_->getInterpolatedRotation(alpha);
 
     // 执行绘制
     context.getRenderer().drawSprite(context.getCamera(), sprite_, pos, scale, rotation_degrees);
@@ -90,6 +129,7 @@ void SpriteComponent::render(engine::core::Context& context) {
 void SpriteComponent::setSpriteById(const std::string& texture_id, const std::optional<SDL_FRect>& source_rect_opt) {
     sprite_.setTextureId(texture_id);
     sprite_.setSourceRect(source_rect_opt);
+    resolveTextureHandle();
 
     updateSpriteSize();
     updateOffset();
@@ -109,8 +149,28 @@ void SpriteComponent::updateSpriteSize() {
     if (sprite_.getSourceRect().has_value()) {
         const auto& src_rect = sprite_.getSourceRect().value();
         sprite_size_ = {src_rect.w, src_rect.h};
+    } else if (sprite_.getAtlasRect().has_value()) {
+        const auto& atlas_rect = sprite_.getAtlasRect().value();
+        sprite_size_ = {atlas_rect.w, atlas_rect.h};
     } else {
-        sprite_size_ = resource_manager_->getTextureSize(sprite_.getTextureId());
+        sprite_size_ = resource_manager_->getTextureSize(sprite_.getTextureHandle());
+    }
+}
+
+void SpriteComponent::resolveTextureHandle() {
+    if (!resource_manager_) {
+        return;
+    }
+    // 打包进图集的纹理直接使用图集页面，与同页的其它精灵合批
+    if (const auto* region = resource_manager_->findAtlasRegion(sprite_.getTextureId())) {
+        sprite_.setTextureHandle(region->page);
+        sprite_.setAtlasRect(region->rect);
+        return;
+    }
+    sprite_.setAtlasRect(std::nullopt);
+    sprite_.setTextureHandle(resource_manager_->getTextureHandle(sprite_.getTextureId()));
+    if (sprite_.getTextureHandle() == engine::resource::INVALID_TEXTURE_HANDLE) {
+        spdlog::error("无法解析纹理句柄，纹理ID: {}", sprite_.getTextureId());
     }
 }
 
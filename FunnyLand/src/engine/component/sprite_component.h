@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "../render/sprite.h"
 #include "./component.h"
+#include "./component_access.h"
 #include "../utils/alignment.h"
 #include <string>
 #include <optional>
@@ -39,6 +40,11 @@ namespace engine::component
         bool is_hidden_ = false; ///< @brief 是否隐藏精灵 不渲染
         
     public:
+        /// @brief update() 为空，可以在工作线程中批量更新（渲染仍在主线程）
+        static ComponentAccess declareAccess() { return {}; }
+        /// @brief 写入精灵的连带访问：updateOffset 会读取同一对象上的 TransformComponent
+        static ComponentAccess declareWriteEffects() { return ComponentAccess{}.read<TransformComponent>(); }
+        
         /**
      * @brief 构造函数
      * @param texture_id 纹理资源的标识符。
@@ -54,6 +60,15 @@ namespace engine::component
             const std::optional<SDL_FRect> source_rect_opt = std::nullopt,
             bool is_flipped = false
         );
+        
+        /**
+         * @brief 从已解析纹理句柄的精灵构造（例如预制体共享的精灵），init 时不再查找纹理。
+         * @param sprite 精灵（句柄无效时 init 中按纹理ID解析）
+         * @param resource_manager 资源管理器。
+         * @param alignment 初始对齐方式。
+         */
+        SpriteComponent(const engine::render::Sprite& sprite, engine::resource::ResourceManager& resource_manager,
+                        engine::utils::Alignment alignment = engine::utils::Alignment::NONE);
         ~SpriteComponent() override = default;
         
         //禁止拷贝和移动
@@ -72,6 +87,7 @@ namespace engine::component
         const glm::vec2& getSpriteSize() const { return sprite_size_; }             ///< @brief 获取精灵尺寸
         const glm::vec2& getOffset() const { return offset_; }                      ///< @brief 获取偏移量
         engine::utils::Alignment getAlignment() const { return alignment_; }        ///< @brief 获取对齐方式
+        std::optional<engine::utils::Rect> getRenderBounds() const override;        ///< @brief 世界坐标包围盒（考虑偏移、缩放和旋转）
         
         //setters
         void setSpriteById(const std::string& texture_id, const std::optional<SDL_FRect>& source_rect_opt = std::nullopt); ///< @brief 设置精灵对象
@@ -82,6 +98,7 @@ namespace engine::component
         
     private:
         void updateSpriteSize();        ///< @brief 辅助函数，根据 sprite_ 的 source_rect_ 更新 sprite_size_
+        void resolveTextureHandle();    ///< @brief 辅助函数，根据纹理ID解析并缓存纹理句柄
 
         // Component 虚函数覆盖
         void init() override;                                                   ///< @brief 初始化函数需要覆盖
@@ -0,0 +1,261 @@
+﻿#include "tile_layer_component.h"
+#include "transform_component.h"
+#include "../object/game_object.h"
+#include "../core/context.h"
+#include "../render/renderer.h"
+#include "../render/camera.h"
+#include "../resource/resource_manager.h"
+#include "../resource/texture_atlas.h"
+#include "../resource/texture_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::component
+{
+    TileLayerComponent::TileLayerComponent(const glm::vec2& tile_size, const glm::ivec2& map_size,
+                                           std::vector<std::uint32_t>&& gids,
+                                           std::shared_ptr<const TileSetList> tilesets, int chunk_size)
+        : tile_size_(tile_size), map_size_(map_size), gids_(std::move(gids)), tilesets_(std::move(tilesets)),
+          chunk_size_(chunk_size > 0 ? chunk_size : 32)
+    {
+        if (gids_.size() != static_cast<size_t>(map_size_.x) * static_cast<size_t>(map_size_.y))
+        {
+            spdlog::error("TileLayerComponent: gid 数量 {} 与图层尺寸 {}x{} 不一致", gids_.size(), map_size_.x, map_size_.y);
+            gids_.resize(static_cast<size_t>(map_size_.x) * static_cast<size_t>(map_size_.y), 0);
+        }
+        chunk_count_ = {(map_size_.x + chunk_size_ - 1) / chunk_size_, (map_size_.y + chunk_size_ - 1) / chunk_size_};
+        chunks_.resize(static_cast<size_t>(chunk_count_.x) * static_cast<size_t>(chunk_count_.y));
+        
+        //图片集合中的图块可能比网格大（向右、向上超出），剔除时需要放宽范围
+        max_overhang_ = computeTileOverhang(tilesets_.get(), tile_size_);
+        spdlog::trace("TileLayerComponent 构造完成，{}x{} 图块，{}x{} 区块", map_size_.x, map_size_.y, chunk_count_.x, chunk_count_.y);
+    }
+
+    std::uint32_t TileLayerComponent::getGid(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= map_size_.x || y >= map_size_.y) return 0;
+        return gids_[static_cast<size_t>(y) * map_size_.x + x];
+    }
+
+    void TileLayerComponent::setGid(int x, int y, std::uint32_t gid)
+    {
+        if (x < 0 || y < 0 || x >= map_size_.x || y >= map_size_.y)
+        {
+            spdlog::warn("TileLayerComponent::setGid 越界: ({}, {})", x, y);
+            return;
+        }
+        gids_[static_cast<size_t>(y) * map_size_.x + x] = gid;
+        //所在区块下次可见时重新烘焙
+        chunks_[static_cast<size_t>(y / chunk_size_) * chunk_count_.x + x / chunk_size_].is_baked = false;
+    }
+
+    void TileLayerComponent::init()
+    {
+        if (!owner_)
+        {
+            spdlog::error("TileLayerComponent 初始化失败, 没有所属对象");
+            return;
+        }
+        transform_ = owner_->getComponent<TransformComponent>();
+        if (!transform_)
+        {
+            spdlog::warn("GameObject '{}' 上的 TileLayerComponent 没有 TransformComponent，图层偏移按 (0,0) 处理。", owner_->getName());
+        }
+    }
+
+    void TileLayerComponent::render(engine::core::Context& context)
+    {
+        if (is_hidden_ || chunks_.empty()) return;
+        
+        const auto& camera = context.getCamera();
+        const glm::vec2 layer_pos = transform_ ? transform_->getInterpolatedPosition(context.getInterpolationAlpha()) : glm::vec2(0.0f);
+        
+        //相机视野转换到图层局部坐标，计算相交的区块范围
+        const glm::vec2 view_min = camera.getPosition() - layer_pos;
+        const glm::vec2 view_max = view_min + camera.getViewportSize();
+        const glm::vec2 chunk_pixel_size = tile_size_ * static_cast<float>(chunk_size_);
+        
+        int min_cx = static_cast<int>(std::floor((view_min.x - max_overhang_.x) / chunk_pixel_size.x));
+        int max_cx = static_cast<int>(std::floor(view_max.x / chunk_pixel_size.x));
+        int min_cy = static_cast<int>(std::floor(view_min.y / chunk_pixel_size.y));
+        int max_cy = static_cast<int>(std::floor((view_max.y + max_overhang_.y) / chunk_pixel_size.y));
+        min_cx = std::max(min_cx, 0);
+        min_cy = std::max(min_cy, 0);
+        max_cx = std::min(max_cx, chunk_count_.x - 1);
+        max_cy = std::min(max_cy, chunk_count_.y - 1);
+        
+        auto& renderer = context.getRenderer();
+        for (int cy = min_cy; cy <= max_cy; ++cy)
+        {
+            for (int cx = min_cx; cx <= max_cx; ++cx)
+            {
+                auto& chunk = chunks_[static_cast<size_t>(cy) * chunk_count_.x + cx];
+                if (!chunk.is_baked)
+                {
+                    bakeChunk(cx, cy, context);
+                }
+                const glm::vec2 origin = layer_pos + chunkVertexOrigin({cx * chunk_size_, cy * chunk_size_}, tile_size_, max_overhang_);
+                for (const auto& batch : chunk.batches)
+                {
+                    renderer.drawGeometry(camera, batch.texture_handle, batch.vertices, origin);
+                }
+            }
+        }
+    }
+
+    void TileLayerComponent::bakeChunk(int chunk_x, int chunk_y, engine::core::Context& context)
+    {
+        auto& chunk = chunks_[static_cast<size_t>(chunk_y) * chunk_count_.x + chunk_x];
+        const glm::ivec2 begin = {chunk_x * chunk_size_, chunk_y * chunk_size_};
+        const glm::ivec2 end = {std::min(begin.x + chunk_size_, map_size_.x), std::min(begin.y + chunk_size_, map_size_.y)};
+        
+        bakeTileRegion(gids_.data() + static_cast<size_t>(begin.y) * map_size_.x + begin.x, map_size_.x, end - begin, begin,
+                       chunkVertexOrigin(begin, tile_size_, max_overhang_), tilesets_.get(), tile_size_, context.getResourceManager(), chunk.batches);
+        chunk.is_baked = true;
+        spdlog::trace("图块区块 ({}, {}) 烘焙完成，{} 个纹理批次", chunk_x, chunk_y, chunk.batches.size());
+    }
+
+    const TileSetInfo* findTileSet(const TileSetList& tilesets, std::uint32_t gid)
+    {
+        //找到第一个 first_gid > gid 的图块集，它的前一个就是 gid 所属的图块集
+        auto it = std::upper_bound(tilesets.begin(), tilesets.end(), gid,
+            [](std::uint32_t value, const TileSetInfo& tileset) { return value < tileset.first_gid; });
+        if (it == tilesets.begin()) return nullptr;
+        return &*(it - 1);
+    }
+
+    glm::vec2 computeTileOverhang(const TileSetList* tilesets, const glm::vec2& tile_size)
+    {
+        glm::vec2 overhang = {0.0f, 0.0f};
+        if (!tilesets) return overhang;
+        for (const auto& tileset : *tilesets)
+        {
+            for (const auto& [id, image] : tileset.images)
+            {
+                overhang = glm::max(overhang, image.getTileSize() - tile_size);
+            }
+        }
+        return overhang;
+    }
+
+    void bakeTileRegion(const std::uint32_t* gids, int stride, const glm::ivec2& region_size, const glm::ivec2& tile_origin,
+                        const glm::vec2& vertex_origin, const TileSetList* tilesets, const glm::vec2& tile_size,
+                        engine::resource::ResourceManager& resource_manager, std::vector<TileBatch>& batches)
+    {
+        batches.clear();
+        if (!tilesets || tilesets->empty()) return;
+        
+        const SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+        for (int row = 0; row < region_size.y; ++row)
+        {
+            for (int col = 0; col < region_size.x; ++col)
+            {
+                const std::uint32_t raw_gid = gids[static_cast<size_t>(row) * stride + col];
+                const std::uint32_t gid = raw_gid & TileLayerComponent::GID_MASK;
+                if (gid == 0) continue;
+                
+                const TileSetInfo* tileset = findTileSet(*tilesets, gid);
+                if (!tileset)
+                {
+                    spdlog::warn("图块 gid {} 不属于任何图块集", gid);
+                    continue;
+                }
+                const std::uint32_t local_id = gid - tileset->first_gid;
+                
+                //解析纹理和源矩形
+                const std::string* image_id = nullptr;
+                SDL_FRect src_rect = {0, 0, 0, 0};
+                glm::vec2 dest_size = tile_size;
+                if (tileset->columns > 0)
+                {
+                    image_id = &tileset->image_id;
+                    const int tile_col = static_cast<int>(local_id) % tileset->columns;
+                    const int tile_row = static_cast<int>(local_id) / tileset->columns;
+                    src_rect = {static_cast<float>(tileset->margin + tile_col * (static_cast<int>(tileset->tile_size.x) + tileset->spacing)),
+                                static_cast<float>(tileset->margin + tile_row * (static_cast<int>(tileset->tile_size.y) + tileset->spacing)),
+                                tileset->tile_size.x, tileset->tile_size.y};
+                    dest_size = tileset->tile_size;
+                }
+                else
+                {
+                    auto image_it = tileset->images.find(local_id);
+                    if (image_it == tileset->images.end())
+                    {
+                        spdlog::warn("图块集中找不到图块 {} (gid {})", local_id, gid);
+                        continue;
+                    }
+                    const auto& image = image_it->second;
+                    image_id = &image.image_id;
+                    src_rect = image.source_rect.value_or(SDL_FRect{0, 0, image.size.x, image.size.y});
+                    dest_size = image.getTileSize();
+                }
+                
+                //打包进图集的图片改用图集页面，源矩形平移到页面坐标
+                engine::resource::TextureHandle handle = engine::resource::INVALID_TEXTURE_HANDLE;
+                if (const auto* region = resource_manager.findAtlasRegion(*image_id))
+                {
+                    handle = region->page;
+                    src_rect.x += region->rect.x;
+                    src_rect.y += region->rect.y;
+                }
+                else
+                {
+                    handle = resource_manager.getTextureHandle(*image_id);
+                }
+                const auto* info = resource_manager.getTextureInfo(handle);
+                if (!info || info->width <= 0 || info->height <= 0)
+                {
+                    spdlog::error("无法加载图块纹理 {}", *image_id);
+                    continue;
+                }
+                
+                //找到（或新建）该纹理的批次，区块内纹理种类很少，线性查找即可
+                auto batch_it = std::find_if(batches.begin(), batches.end(),
+                    [handle](const TileBatch& batch) { return batch.texture_handle == handle; });
+                if (batch_it == batches.end())
+                {
+                    batches.push_back({handle, {}});
+                    batch_it = batches.end() - 1;
+                }
+                
+                //Tiled 中比网格大的图块以网格左下角对齐
+                const int x = tile_origin.x + col;
+                const int y = tile_origin.y + row;
+                const float left = static_cast<float>(x) * tile_size.x - vertex_origin.x;
+                const float bottom = static_cast<float>(y + 1) * tile_size.y - vertex_origin.y;
+                const float top = bottom - dest_size.y;
+                const float right = left + dest_size.x;
+                
+                //四个角（左上、右上、右下、左下）的纹理坐标。Tiled 先做对角翻转（沿左上-右下对角线转置），再做水平、垂直翻转
+                const float u0 = src_rect.x / static_cast<float>(info->width);
+                const float u1 = (src_rect.x + src_rect.w) / static_cast<float>(info->width);
+                const float v0 = src_rect.y / static_cast<float>(info->height);
+                const float v1 = (src_rect.y + src_rect.h) / static_cast<float>(info->height);
+                SDL_FPoint uv[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+                if (raw_gid & TileLayerComponent::FLIPPED_DIAGONALLY_FLAG) std::swap(uv[1], uv[3]);
+                if (raw_gid & TileLayerComponent::FLIPPED_HORIZONTALLY_FLAG)
+                {
+                    std::swap(uv[0], uv[1]);
+                    std::swap(uv[2], uv[3]);
+                }
+                if (raw_gid & TileLayerComponent::FLIPPED_VERTICALLY_FLAG)
+                {
+                    std::swap(uv[0], uv[3]);
+                    std::swap(uv[1], uv[2]);
+                }
+                
+                auto& vertices = batch_it->vertices;
+                vertices.push_back({{left, top}, white, uv[0]});
+                vertices.push_back({{right, top}, white, uv[1]});
+                vertices.push_back({{right, bottom}, white, uv[2]});
+                vertices.push_back({{left, bottom}, white, uv[3]});
+            }
+        }
+    }
+
+    glm::vec2 chunkVertexOrigin(const glm::ivec2& tile_origin, const glm::vec2& tile_size, const glm::vec2& overhang)
+    {
+        return glm::vec2(tile_origin) * tile_size - glm::vec2(0.0f, overhang.y);
+    }
+}
@@ -0,0 +1,153 @@
+﻿#pragma once
+#include "./component.h"
+#include "../resource/texture_handle.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <SDL3/SDL_render.h>
+
+namespace engine::resource
+{
+    class ResourceManager;
+}
+
+namespace engine::component
+{
+    class TransformComponent;
+
+    /**
+     * @brief 一个 Tiled 图块集（tsj）解析后的数据，用于把 gid 解析为纹理和源矩形。
+     *
+     * 两种图块集：
+     * 1. 单图图块集（columns > 0）：所有图块切自同一张图片。
+     * 2. 图片集合图块集（columns == 0）：每个图块是一张独立图片，记录在 images 中。
+     */
+    struct TileSetInfo
+    {
+        /// @brief 图片集合中的单个图块图片
+        struct TileImage
+        {
+            std::string image_id;           ///< @brief 纹理路径
+            glm::vec2 size = {0.0f, 0.0f};  ///< @brief 图片尺寸
+            std::optional<SDL_FRect> source_rect;   ///< @brief 图块使用的子矩形（Tiled 1.9+ 的 x/y/width/height），为空表示整张图片
+            
+            /// @brief 图块的显示尺寸
+            glm::vec2 getTileSize() const { return source_rect ? glm::vec2(source_rect->w, source_rect->h) : size; }
+        };
+        
+        std::uint32_t first_gid = 0;                            ///< @brief 该图块集的第一个全局 id
+        std::uint32_t tile_count = 0;                           ///< @brief 图块数量
+        int columns = 0;                                        ///< @brief 单图图块集的列数（0 表示图片集合）
+        glm::vec2 tile_size = {0.0f, 0.0f};                     ///< @brief 单图图块集的图块尺寸
+        int margin = 0;                                         ///< @brief 图片边距
+        int spacing = 0;                                        ///< @brief 图块间距
+        std::string image_id;                                   ///< @brief 单图图块集的纹理路径
+        std::unordered_map<std::uint32_t, TileImage> images;    ///< @brief 图片集合：本地 id -> 图片
+    };
+    
+    /// @brief 按 first_gid 升序排列的图块集列表（同一地图的多个图块图层共享）
+    using TileSetList = std::vector<TileSetInfo>;
+    
+    /// @brief 烘焙后的一批图块：使用同一纹理的所有图块的顶点
+    struct TileBatch
+    {
+        engine::resource::TextureHandle texture_handle = engine::resource::INVALID_TEXTURE_HANDLE;
+        std::vector<SDL_Vertex> vertices;       ///< @brief 相对区块顶点原点的坐标（不为负），每个图块 4 个
+    };
+
+    /**
+     * @brief 渲染 Tiled 图块图层的组件。
+     *
+     * gid 以扁平数组保存（行优先）。图层被划分为固定大小的区块（chunk），
+     * 每个区块首次进入视野时按纹理烘焙成顶点缓冲并缓存，
+     * 之后每帧只提交与相机视野相交的区块，每个区块每种纹理一次绘制调用。
+     */
+    class TileLayerComponent final : public engine::component::Component
+    {
+        friend class engine::object::GameObject;
+        
+    public:
+        static constexpr std::uint32_t FLIPPED_HORIZONTALLY_FLAG = 0x80000000;  ///< @brief Tiled gid 水平翻转标志位
+        static constexpr std::uint32_t FLIPPED_VERTICALLY_FLAG = 0x40000000;    ///< @brief Tiled gid 垂直翻转标志位
+        static constexpr std::uint32_t FLIPPED_DIAGONALLY_FLAG = 0x20000000;    ///< @brief Tiled gid 对角翻转标志位（先于水平、垂直翻转应用）
+        static constexpr std::uint32_t GID_MASK = 0x0FFFFFFF;                   ///< @brief 去除所有标志位后的 gid
+        
+    private:
+        /// @brief 一个区块的烘焙结果
+        struct Chunk
+        {
+            std::vector<TileBatch> batches;
+            bool is_baked = false;
+        };
+        
+        TransformComponent* transform_ = nullptr;                   ///< @brief 缓存变换组件（位置即图层偏移）
+        
+        glm::vec2 tile_size_;                                       ///< @brief 地图网格尺寸（像素）
+        glm::ivec2 map_size_;                                       ///< @brief 图层尺寸（图块数）
+        std::vector<std::uint32_t> gids_;                           ///< @brief 扁平 gid 数组，0 表示空
+        std::shared_ptr<const TileSetList> tilesets_;               ///< @brief 图块集列表
+        
+        int chunk_size_;                                            ///< @brief 区块边长（图块数）
+        glm::ivec2 chunk_count_;                                    ///< @brief 区块数量
+        std::vector<Chunk> chunks_;                                 ///< @brief 区块缓存，行优先
+        glm::vec2 max_overhang_ = {0.0f, 0.0f};                     ///< @brief 图片集合中的图块超出网格的最大尺寸（向右、向上）
+        bool is_hidden_ = false;                                    ///< @brief 是否隐藏
+        
+    public:
+        /**
+         * @brief 构造函数
+         * @param tile_size 地图网格尺寸（像素）
+         * @param map_size 图层尺寸（图块数）
+         * @param gids 行优先的 gid 数组，长度应为 map_size.x * map_size.y
+         * @param tilesets 按 first_gid 升序排列的图块集
+         * @param chunk_size 区块边长（图块数）
+         */
+        TileLayerComponent(const glm::vec2& tile_size, const glm::ivec2& map_size, std::vector<std::uint32_t>&& gids,
+                           std::shared_ptr<const TileSetList> tilesets, int chunk_size = 32);
+        
+        std::uint32_t getGid(int x, int y) const;                               ///< @brief 获取指定网格的 gid（含翻转标志），越界返回 0
+        void setGid(int x, int y, std::uint32_t gid);                           ///< @brief 修改指定网格的 gid，所在区块会重新烘焙
+        
+        const glm::vec2& getTileSize() const { return tile_size_; }             ///< @brief 获取网格尺寸
+        const glm::ivec2& getMapSize() const { return map_size_; }              ///< @brief 获取图层尺寸（图块数）
+        int getChunkSize() const { return chunk_size_; }                        ///< @brief 获取区块边长
+        bool isHidden() const { return is_hidden_; }                            ///< @brief 获取是否隐藏
+        void setHidden(bool hidden) { is_hidden_ = hidden; }                    ///< @brief 设置是否隐藏
+        
+    protected:
+        void init() override;
+        void update(float, engine::core::Context&) override {}
+        void render(engine::core::Context& context) override;
+        
+    private:
+        void bakeChunk(int chunk_x, int chunk_y, engine::core::Context& context);             ///< @brief 把一个区块烘焙为按纹理分组的顶点缓冲
+    };
+    
+    //---------------- 图块图层组件（TileLayerComponent、ChunkedTileLayerComponent）共用的烘焙函数 ----------------
+    
+    /// @brief 二分查找 gid（不含标志位）所属的图块集，找不到返回 nullptr
+    const TileSetInfo* findTileSet(const TileSetList& tilesets, std::uint32_t gid);
+    
+    /// @brief 图片集合中的图块超出网格的最大尺寸（向右、向上），剔除时需要放宽范围
+    glm::vec2 computeTileOverhang(const TileSetList* tilesets, const glm::vec2& tile_size);
+    
+    /**
+     * @brief 把一块矩形区域的图块烘焙为按纹理分组的顶点。
+     * @param gids 区域左上角图块的 gid 指针
+     * @param stride gid 数组一行的长度
+     * @param region_size 区域尺寸（图块数）
+     * @param tile_origin 区域左上角在图层中的网格坐标
+     * @param vertex_origin 顶点坐标的原点（图层局部坐标），顶点相对它保存，绘制时作为 Renderer::drawGeometry 的位置
+     * @param batches 输出，先被清空
+     */
+    void bakeTileRegion(const std::uint32_t* gids, int stride, const glm::ivec2& region_size, const glm::ivec2& tile_origin,
+                        const glm::vec2& vertex_origin, const TileSetList* tilesets, const glm::vec2& tile_size,
+                        engine::resource::ResourceManager& resource_manager, std::vector<TileBatch>& batches);
+    
+    /// @brief 区块的顶点原点：区块左上角向上让出超出网格的图块高度，保证顶点坐标不为负（视口会裁掉原点左侧和上方）
+    glm::vec2 chunkVertexOrigin(const glm::ivec2& tile_origin, const glm::vec2& tile_size, const glm::vec2& overhang);
+}
@@ -1,9 +1,28 @@
 ﻿#include "transform_component.h"
 #include "../object/game_object.h"
 #include "sprite_component.h" 
+#include <cmath>
+#include <glm/common.hpp>
 
 namespace engine::component { 
 
+    ComponentAccess TransformComponent::declareWriteEffects()
+    {
+        return ComponentAccess{}.write<SpriteComponent>();
+    }
+
+    void TransformComponent::setPosition(const glm::vec2& position)
+    {
+        position_ = position;
+        if (owner_) owner_->markBoundsDirty();
+    }
+
+    void TransformComponent::setRotation(float rotation)
+    {
+        rotation_ = rotation;
+        if (owner_) owner_->markBoundsDirty();
+    }
+
     void TransformComponent::setScale(const glm::vec2 &scale)
     {
         scale_ = scale;
@@ -12,7 +31,45 @@ namespace engine::component {
             if (sprite_comp) {
                 sprite_comp->updateOffset();
             }
+            owner_->markBoundsDirty();
         }
     }
 
+    void TransformComponent::translate(const glm::vec2& offset)
+    {
+        position_ += offset;
+        if (owner_) owner_->markBoundsDirty();
+    }
+
+    void TransformComponent::teleport(const glm::vec2& position)
+    {
+        setPosition(position);
+        previous_position_ = position;
+    }
+
+    void TransformComponent::savePreviousState()
+    {
+        previous_position_ = position_;
+        previous_scale_ = scale_;
+        previous_rotation_ = rotation_;
+    }
+
+    glm::vec2 TransformComponent::getInterpolatedPosition(float alpha) const
+    {
+        return glm::mix(previous_position_, position_, alpha);
+    }
+
+    float TransformComponent::getInterpolatedRotation(float alpha) const
+    {
+        //把角度差映射到 [-180, 180)，从 350° 转到 10° 时走 20° 而不是 -340°
+        float delta = std::fmod(rotation_ - previous_rotation_ + 180.0f, 360.0f);
+        if (delta < 0.0f) delta += 360.0f;
+        return rotation_ - (delta - 180.0f) * (1.0f - alpha);
+    }
+
+    glm::vec2 TransformComponent::getInterpolatedScale(float alpha) const
+    {
+        return glm::mix(previous_scale_, scale_, alpha);
+    }
+
 } // namespace engine::component 
\ No newline at end of file
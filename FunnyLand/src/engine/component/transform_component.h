@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "./component.h"
+#include "./component_access.h"
 #include <glm/vec2.hpp>
 
 namespace engine::component {
@@ -9,11 +10,20 @@ namespace engine::component {
      * @brief 管理 GameObject 的位置、旋转和缩放。
      */
     class TransformComponent final : public Component {
+        // 注意：请通过 setter 修改变换，setter 会通知空间网格更新包围盒；直接写成员变量不会触发更新
         friend class engine::object::GameObject;        // 友元不能继承，必须每个子类单独添加
     public:
         glm::vec2 position_ = {0.0f, 0.0f};     ///< @brief 位置
         glm::vec2 scale_ = {1.0f, 1.0f};        ///< @brief 缩放
         float rotation_ = 0.0f;                 ///< @brief 角度制，单位：度
+        
+    private:
+        //上一模拟步结束时的状态，渲染时在它和当前状态之间插值
+        glm::vec2 previous_position_ = {0.0f, 0.0f};
+        glm::vec2 previous_scale_ = {1.0f, 1.0f};
+        float previous_rotation_ = 0.0f;
+        
+    public:
 
         /**
          * @brief 构造函数
@@ -22,22 +32,35 @@ namespace engine::component {
          * @param rotation 旋转
          */
         TransformComponent(glm::vec2 position = {0.0f, 0.0f}, glm::vec2 scale = {1.0f, 1.0f}, float rotation = 0.0f)
-            : position_(position), scale_(scale), rotation_(rotation) {}
+            : position_(position), scale_(scale), rotation_(rotation),
+              previous_position_(position), previous_scale_(scale), previous_rotation_(rotation) {}
 
         // 禁止拷贝和移动
         TransformComponent(const TransformComponent&) = delete;
         TransformComponent& operator=(const TransformComponent&) = delete;
         TransformComponent(TransformComponent&&) = delete;
         TransformComponent& operator=(TransformComponent&&) = delete;
+        
+        /// @brief update() 为空，可以在工作线程中批量更新（不作为串行阶段阻挡其他类型）
+        static ComponentAccess declareAccess() { return {}; }
+        /// @brief 写入变换的连带访问：setScale 会更新同一对象上 SpriteComponent 的偏移
+        static ComponentAccess declareWriteEffects();
 
         // Getters and setters 
         const glm::vec2& getPosition() const { return position_; }              ///< @brief 获取位置
         float getRotation() const { return rotation_; }                         ///< @brief 获取旋转
         const glm::vec2& getScale() const { return scale_; }                    ///< @brief 获取缩放
-        void setPosition(const glm::vec2& position) { position_ = position; }   ///< @brief 设置位置
-        void setRotation(float rotation) { rotation_ = rotation; }              ///< @brief 设置旋转
+        void setPosition(const glm::vec2& position);                            ///< @brief 设置位置
+        void setRotation(float rotation);                                       ///< @brief 设置旋转
         void setScale(const glm::vec2& scale);                                  ///< @brief 设置缩放，应用缩放时应同步更新Sprite偏移量
-        void translate(const glm::vec2& offset) { position_ += offset; }        ///< @brief 平移
+        void translate(const glm::vec2& offset);                                ///< @brief 平移
+        void teleport(const glm::vec2& position);                               ///< @brief 瞬移：设置位置并清除插值，避免渲染时出现拖影
+
+        // 渲染插值（alpha 来自 Context::getInterpolationAlpha，1 表示当前状态）
+        void savePreviousState();                                               ///< @brief 记录当前状态为“上一步”，由 Scene 在每个模拟步开始时调用
+        glm::vec2 getInterpolatedPosition(float alpha) const;                   ///< @brief 获取插值后的位置
+        float getInterpolatedRotation(float alpha) const;                       ///< @brief 获取插值后的旋转（沿最短方向）
+        glm::vec2 getInterpolatedScale(float alpha) const;                      ///< @brief 获取插值后的缩放
 
     private:
         void update(float, engine::core::Context&) override {}                  ///< @brief 覆盖纯虚函数，这里不需要实现
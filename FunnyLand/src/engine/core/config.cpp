@@ -77,6 +77,56 @@ namespace engine::core
         {
             const auto& graphics_config = j["graphics"];
             vsync_enabled_ = graphics_config.value("vsync", vsync_enabled_);
+            if (graphics_config.contains("texture_atlas"))
+            {
+                const auto& atlas_config = graphics_config["texture_atlas"];
+                atlas_enabled_ = atlas_config.value("enabled", atlas_enabled_);
+                atlas_directories_ = atlas_config.value("directories", atlas_directories_);
+                atlas_page_size_ = atlas_config.value("page_size", atlas_page_size_);
+                atlas_max_source_size_ = atlas_config.value("max_source_size", atlas_max_source_size_);
+                atlas_padding_ = atlas_config.value("padding", atlas_padding_);
+                atlas_cache_path_ = atlas_config.value("cache_path", atlas_cache_path_);
+                if (atlas_page_size_ <= 0 || atlas_max_source_size_ <= 0 || atlas_padding_ < 0)
+                {
+                    spdlog::warn("纹理图集参数无效，已禁用纹理图集");
+                    atlas_enabled_ = false;
+                }
+            }
+        }
+        if (j.contains("resources"))
+        {
+            const auto& resources_config = j["resources"];
+            archive_path_ = resources_config.value("archive_path", archive_path_);
+        }
+        if (j.contains("streaming"))
+        {
+            const auto& streaming_config = j["streaming"];
+            streaming_prefetch_margin_ = streaming_config.value("prefetch_margin", streaming_prefetch_margin_);
+            streaming_unload_margin_ = streaming_config.value("unload_margin", streaming_unload_margin_);
+            if (streaming_prefetch_margin_ < 0.0f || streaming_unload_margin_ < streaming_prefetch_margin_)
+            {
+                spdlog::warn("流式加载距离无效（需要 0 <= prefetch_margin <= unload_margin），已设置为默认值: 256 / 512");
+                streaming_prefetch_margin_ = 256.0f;
+                streaming_unload_margin_ = 512.0f;
+            }
+            streaming_memory_budget_mb_ = streaming_config.value("memory_budget_mb", streaming_memory_budget_mb_);
+            if (streaming_memory_budget_mb_ < 0)
+            {
+                spdlog::warn("流式加载内存预算不能小于0，已设置为: 0（不限制）");
+                streaming_memory_budget_mb_ = 0;
+            }
+            streaming_max_chunk_loads_per_frame_ = streaming_config.value("max_chunk_loads_per_frame", streaming_max_chunk_loads_per_frame_);
+            if (streaming_max_chunk_loads_per_frame_ < 0)
+            {
+                spdlog::warn("每帧最多载入区块数不能小于0，已设置为: 0（不限制）");
+                streaming_max_chunk_loads_per_frame_ = 0;
+            }
+            streaming_object_cell_size_ = streaming_config.value("object_cell_size", streaming_object_cell_size_);
+            if (streaming_object_cell_size_ <= 0.0f)
+            {
+                spdlog::warn("对象网格边长必须大于0，已设置为默认值: 512");
+                streaming_object_cell_size_ = 512.0f;
+            }
         }
         if (j.contains("performance"))
         {
@@ -87,6 +137,54 @@ namespace engine::core
                 spdlog::warn("目标FPS不能小于0，已设置为默认值: {}", target_fps_);
                 target_fps_ = 0;
             }
+            profile_trace_path_ = performance_config.value("profile_trace_path", profile_trace_path_);
+            fixed_timestep_enabled_ = performance_config.value("fixed_timestep", fixed_timestep_enabled_);
+            tick_rate_ = performance_config.value("tick_rate", tick_rate_);
+            if (tick_rate_ <= 0)
+            {
+                spdlog::warn("模拟频率必须大于0，已设置为默认值: 60");
+                tick_rate_ = 60;
+            }
+            max_steps_per_frame_ = performance_config.value("max_steps_per_frame", max_steps_per_frame_);
+            if (max_steps_per_frame_ <= 0)
+            {
+                spdlog::warn("每帧最大模拟步数必须大于0，已设置为: 1");
+                max_steps_per_frame_ = 1;
+            }
+            asset_loader_threads_ = performance_config.value("asset_loader_threads", asset_loader_threads_);
+            if (asset_loader_threads_ <= 0)
+            {
+                spdlog::warn("异步加载线程数必须大于0，已设置为: 1");
+                asset_loader_threads_ = 1;
+            }
+            job_worker_threads_ = performance_config.value("job_worker_threads", job_worker_threads_);
+            if (job_worker_threads_ < -1)
+            {
+                spdlog::warn("工作线程数不能小于-1，已设置为: -1（按硬件线程数）");
+                job_worker_threads_ = -1;
+            }
+            frame_arena_kb_ = performance_config.value("frame_arena_kb", frame_arena_kb_);
+            if (frame_arena_kb_ <= 0)
+            {
+                spdlog::warn("帧内存池大小必须大于0，已设置为默认值: 256");
+                frame_arena_kb_ = 256;
+            }
+            async_upload_budget_ms_ = performance_config.value("async_upload_budget_ms", async_upload_budget_ms_);
+            if (async_upload_budget_ms_ < 0.0)
+            {
+                spdlog::warn("异步上传时间预算不能小于0，已设置为: 0（每帧只上传一个资源）");
+                async_upload_budget_ms_ = 0.0;
+            }
+        }
+        if (j.contains("memory") && j["memory"].contains("budgets_mb"))
+        {
+            try
+            {
+                memory_budgets_mb_ = j["memory"]["budgets_mb"].get<std::unordered_map<std::string, int>>();
+            }catch (const std::exception& e)
+            {
+                spdlog::warn("配置加载警告：解析 'memory.budgets_mb' 时发生异常。使用默认预算。错误：{}", e.what());
+            }
         }
         if (j.contains("audio"))
         {
@@ -126,10 +224,39 @@ namespace engine::core
                 {"resizable", window_resizable_}
             }},
             {"graphics", {
-                {"vsync", vsync_enabled_}
+                {"vsync", vsync_enabled_},
+                {"texture_atlas", {
+                    {"enabled", atlas_enabled_},
+                    {"directories", atlas_directories_},
+                    {"page_size", atlas_page_size_},
+                    {"max_source_size", atlas_max_source_size_},
+                    {"padding", atlas_padding_},
+                    {"cache_path", atlas_cache_path_}
+                }}
+            }},
+            {"resources", {
+                {"archive_path", archive_path_}
+            }},
+            {"streaming", {
+                {"prefetch_margin", streaming_prefetch_margin_},
+                {"unload_margin", streaming_unload_margin_},
+                {"memory_budget_mb", streaming_memory_budget_mb_},
+                {"max_chunk_loads_per_frame", streaming_max_chunk_loads_per_frame_},
+                {"object_cell_size", streaming_object_cell_size_}
             }},
             {"performance", {
-                {"target_fps", target_fps_}
+                {"target_fps", target_fps_},
+                {"profile_trace_path", profile_trace_path_},
+                {"fixed_timestep", fixed_timestep_enabled_},
+                {"tick_rate", tick_rate_},
+                {"max_steps_per_frame", max_steps_per_frame_},
+                {"asset_loader_threads", asset_loader_threads_},
+                {"job_worker_threads", job_worker_threads_},
+                {"frame_arena_kb", frame_arena_kb_},
+                {"async_upload_budget_ms", async_upload_budget_ms_}
+            }},
+            {"memory", {
+                {"budgets_mb", memory_budgets_mb_}
             }},
             {"audio", {
                 {"music_volume", music_volume_},
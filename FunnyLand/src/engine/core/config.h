@@ -25,9 +25,41 @@ namespace engine::core
         
         //图形设置
         bool vsync_enabled_ = true ;//是否启用垂直同步
+        bool atlas_enabled_ = true;             //是否把小图打包进纹理图集
+        std::vector<std::string> atlas_directories_ = {"assets/textures/Props", "assets/textures/Items", "assets/textures/FX", "assets/textures/UI/buttons"}; //打包的图片目录
+        int atlas_page_size_ = 1024;            //图集页面最大边长
+        int atlas_max_source_size_ = 256;       //超过该宽高的图片不打包
+        int atlas_padding_ = 1;                 //图片间隔
+        std::string atlas_cache_path_ = "assets/cache/texture_atlas"; //图集缓存路径前缀（为空则每次启动都重新打包）
+        
+        //资源设置
+        std::string archive_path_ = "assets.pak"; //FunnyLandCooker 生成的资源包路径，文件存在时挂载（为空或不存在则读取散文件）
+        
+        //流式加载设置（无限地图）
+        float streaming_prefetch_margin_ = 256.0f;      //相机视野外提前载入区块的距离（像素）
+        float streaming_unload_margin_ = 512.0f;        //超出相机视野这个距离后卸载区块（像素，不小于提前载入距离）
+        int streaming_memory_budget_mb_ = 32;           //驻留区块内存上限（MB，0 表示不限制）
+        int streaming_max_chunk_loads_per_frame_ = 16;  //每帧最多载入的区块数（0 表示不限制）
+        float streaming_object_cell_size_ = 512.0f;     //对象按此边长的网格分组载入（像素）
         
         //性能设置
         int target_fps_ = 144;
+        bool fixed_timestep_enabled_ = false;   //是否使用固定步长更新（渲染按插值平滑）
+        int tick_rate_ = 60;                    //固定步长模式下每秒模拟步数
+        int max_steps_per_frame_ = 5;           //每帧最多模拟步数，超出的时间直接丢弃，防止越卡越慢
+        int asset_loader_threads_ = 2;          //异步资源加载线程数
+        int job_worker_threads_ = -1;           //并行更新组件的工作线程数（-1 表示 硬件线程数-1，0 表示只用主线程）
+        int frame_arena_kb_ = 256;              //帧内存池主块的初始大小（KB，一帧用不完时自动扩大）
+        double async_upload_budget_ms_ = 2.0;   //每帧用于上传异步加载结果（创建纹理等）的时间预算（毫秒）
+        std::string profile_trace_path_ = "profile_trace.json"; //退出时导出性能分析 trace 的路径（为空则不导出，仅在编入分析器时有效）
+        
+        //内存统计设置：标签名称 -> 预算（MB），超出时每帧检查给出警告（标签可以是 Textures、Audio 等内置标签，也可以是 Scene:场景名）
+        std::unordered_map<std::string,int> memory_budgets_mb_
+        {
+            {"Textures",256},
+            {"Audio",64},
+            {"Fonts",16}
+        };
         
         //音屏设置
         float music_volume_ = 0.5f;
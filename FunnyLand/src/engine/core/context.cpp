@@ -2,11 +2,16 @@
 #include <spdlog/spdlog.h>
 
 engine::core::Context::Context(engine::input::InputManager& input_manager, engine::render::Renderer& renderer,
-                               engine::render::Camera& camera, engine::resource::ResourceManager& resource_manager)
+                               engine::render::Camera& camera, engine::resource::ResourceManager& resource_manager,
+                               engine::core::Time& time, engine::core::JobSystem& job_system,
+                               engine::core::FrameArena& frame_arena)
     : input_manager_(input_manager),
       renderer_(renderer),
       camera_(camera),
-      resource_manager_(resource_manager)
+      resource_manager_(resource_manager),
+      time_(time),
+      job_system_(job_system),
+      frame_arena_(frame_arena)
 {
-    spdlog::trace("上下文已创建并初始化，包含输入管理器、渲染器、相机和资源管理器。");
+    spdlog::trace("上下文已创建并初始化，包含输入管理器、渲染器、相机、资源管理器、时间、任务调度器和帧内存池。");
 }
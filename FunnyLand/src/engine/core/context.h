@@ -19,6 +19,9 @@ namespace engine::input
 
 namespace engine::core
 {
+    class Time;
+    class JobSystem;
+    class FrameArena;
     
     /**
      * @brief 持有对核心引擎模块引用的上下文对象。
@@ -33,6 +36,10 @@ namespace engine::core
         engine::render::Renderer& renderer_;                    ///< @brief 渲染器
         engine::render::Camera& camera_;                        ///< @brief 相机
         engine::resource::ResourceManager& resource_manager_;   ///< @brief 资源管理器
+        engine::core::Time& time_;                              ///< @brief 时间（帧时间统计）
+        engine::core::JobSystem& job_system_;                   ///< @brief 任务调度器（并行更新组件）
+        engine::core::FrameArena& frame_arena_;                 ///< @brief 帧内存池（每帧开始时重置的临时内存）
+        float interpolation_alpha_ = 1.0f;                      ///< @brief 渲染插值系数：当前时刻位于上一模拟步与当前模拟步之间的比例
         
     public:
         /**
@@ -41,11 +48,17 @@ namespace engine::core
          * @param renderer 对 Renderer 实例的引用。
          * @param camera 对 Camera 实例的引用。
          * @param resource_manager 对 ResourceManager 实例的引用。
+         * @param time 对 Time 实例的引用。
+         * @param job_system 对 JobSystem 实例的引用。
+         * @param frame_arena 对 FrameArena 实例的引用。
          */
         Context(engine::input::InputManager& input_manager,
                 engine::render::Renderer& renderer,
                 engine::render::Camera& camera,
-                engine::resource::ResourceManager& resource_manager);
+                engine::resource::ResourceManager& resource_manager,
+                engine::core::Time& time,
+                engine::core::JobSystem& job_system,
+                engine::core::FrameArena& frame_arena);
         
         //通常只用一个Context实例 禁止拷贝和移动
         Context(const Context&) = delete;
@@ -58,6 +71,13 @@ namespace engine::core
         engine::render::Renderer& getRenderer() const { return renderer_; }
         engine::render::Camera& getCamera() const { return camera_; }
         engine::resource::ResourceManager& getResourceManager() const { return resource_manager_; }
+        engine::core::Time& getTime() const { return time_; }
+        engine::core::JobSystem& getJobSystem() const { return job_system_; }
+        engine::core::FrameArena& getFrameArena() const { return frame_arena_; }
+        float getInterpolationAlpha() const { return interpolation_alpha_; }
+        
+        /// @brief 由 GameApp 每帧设置。固定步长模式下为 累积剩余时间/步长，可变步长模式下恒为 1（直接使用当前状态）
+        void setInterpolationAlpha(float alpha) { interpolation_alpha_ = alpha; }
     };
  
 }
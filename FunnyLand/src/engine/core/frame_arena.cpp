@@ -0,0 +1,93 @@
+﻿#include "frame_arena.h"
+#include "memory_tracker.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    FrameArena::FrameArena(size_t capacity, std::pmr::memory_resource* upstream)
+        : upstream_(upstream ? upstream : std::pmr::new_delete_resource())
+    {
+        main_block_ = allocateBlock(std::max<size_t>(capacity, alignof(std::max_align_t)));
+        current_ = main_block_.data;
+        current_end_ = main_block_.data + main_block_.size;
+        stats_.capacity = main_block_.size;
+    }
+
+    FrameArena::~FrameArena()
+    {
+        for (auto& block : overflow_blocks_) releaseBlock(block);
+        releaseBlock(main_block_);
+    }
+
+    void FrameArena::reset()
+    {
+        if (!overflow_blocks_.empty())
+        {
+            //主块放不下一帧的数据：换成按本帧用量再留一半余量的主块，之后的帧不再溢出
+            for (auto& block : overflow_blocks_) releaseBlock(block);
+            overflow_blocks_.clear();
+            const size_t new_capacity = stats_.used + stats_.used / 2;
+            spdlog::debug("FrameArena: 本帧使用 {} 字节，超出主块 {} 字节，主块扩大到 {} 字节", stats_.used, main_block_.size, new_capacity);
+            releaseBlock(main_block_);
+            main_block_ = allocateBlock(new_capacity);
+            stats_.capacity = main_block_.size;
+        }
+        current_ = main_block_.data;
+        current_end_ = main_block_.data + main_block_.size;
+        stats_.last_frame_used = stats_.used;
+        stats_.used = 0;
+        stats_.allocations = 0;
+    }
+
+    void* FrameArena::do_allocate(size_t bytes, size_t alignment)
+    {
+        void* p = allocateFromCurrent(bytes, alignment);
+        if (!p)
+        {
+            //溢出块至少和主块一样大，避免连续的小分配每次都向上游申请
+            overflow_blocks_.push_back(allocateBlock(std::max(main_block_.size, bytes + alignment)));
+            ++stats_.overflow_blocks;
+            current_ = overflow_blocks_.back().data;
+            current_end_ = current_ + overflow_blocks_.back().size;
+            p = allocateFromCurrent(bytes, alignment);
+        }
+        ++stats_.allocations;
+        return p;
+    }
+
+    void FrameArena::do_deallocate(void*, size_t, size_t)
+    {
+        //单个释放什么都不做，reset() 时整体回收
+    }
+
+    bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    void* FrameArena::allocateFromCurrent(size_t bytes, size_t alignment)
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(current_);
+        const std::uintptr_t aligned = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        const size_t padding = static_cast<size_t>(aligned - address);
+        if (padding + bytes > static_cast<size_t>(current_end_ - current_)) return nullptr;
+        current_ += padding + bytes;
+        stats_.used += padding + bytes;
+        stats_.peak_used = std::max(stats_.peak_used, stats_.used);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    FrameArena::Block FrameArena::allocateBlock(size_t size)
+    {
+        ENGINE_MEMORY_SCOPE(memory_tags::ENGINE);  //溢出发生在场景更新中，主块却一直留到下一次扩容
+        return {static_cast<std::byte*>(upstream_->allocate(size, alignof(std::max_align_t))), size};
+    }
+
+    void FrameArena::releaseBlock(Block& block)
+    {
+        if (!block.data) return;
+        upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+        block = {};
+    }
+}
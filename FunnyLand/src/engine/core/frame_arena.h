@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace engine::core
+{
+    /**
+     * @brief 帧内存池：按帧重置的线性（bump）分配器，用于只在一帧之内有效的临时数据。
+     *
+     * 继承 std::pmr::memory_resource，可直接交给 std::pmr::vector / std::pmr::string 等容器：
+     *     std::pmr::vector<Candidate> candidates(&context.getFrameArena());
+     * 分配只是移动一个偏移量，释放什么都不做；GameApp 在每帧开始时调用 reset() 一次性回收。
+     * 主块用完时向上游申请溢出块，reset() 时按本帧用量扩大主块，之后的帧不再溢出，稳定后不分配内存。
+     *
+     * 注意：
+     * - 从这里分配的内存（以及使用它的容器）不能跨帧保留；
+     * - 不是线程安全的，只在主线程使用（工作线程中的组件更新不要用它）。
+     */
+    class FrameArena final : public std::pmr::memory_resource
+    {
+    public:
+        /// @brief 帧内存池的统计信息
+        struct Stats
+        {
+            size_t capacity = 0;            ///< @brief 主块大小（字节）
+            size_t used = 0;                ///< @brief 本帧已分配的字节数（含对齐填充）
+            size_t last_frame_used = 0;     ///< @brief 上一帧分配的字节数
+            size_t peak_used = 0;           ///< @brief 单帧用量的最高水位
+            size_t allocations = 0;         ///< @brief 本帧的分配次数
+            size_t overflow_blocks = 0;     ///< @brief 累计申请的溢出块数（稳定后不再增加）
+        };
+
+    private:
+        /// @brief 向上游申请的一块内存
+        struct Block
+        {
+            std::byte* data = nullptr;
+            size_t size = 0;
+        };
+
+        std::pmr::memory_resource* upstream_;   ///< @brief 申请主块和溢出块的上游资源
+        Block main_block_;                      ///< @brief 主块，每帧从头开始分配
+        std::vector<Block> overflow_blocks_;    ///< @brief 本帧主块不够时额外申请的块（reset() 时释放）
+        std::byte* current_ = nullptr;          ///< @brief 当前块中下一次分配的位置
+        std::byte* current_end_ = nullptr;      ///< @brief 当前块的末尾
+        Stats stats_;
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param capacity 主块的初始大小（字节）
+         * @param upstream 上游内存资源，默认使用 new/delete
+         */
+        explicit FrameArena(size_t capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+        ~FrameArena() override;
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        FrameArena(FrameArena&&) = delete;
+        FrameArena& operator=(FrameArena&&) = delete;
+
+        /// @brief 回收本帧的所有分配（本帧溢出过时扩大主块），每帧调用一次
+        void reset();
+
+        const Stats& getStats() const { return stats_; }    ///< @brief 获取统计信息
+        size_t getUsedBytes() const { return stats_.used; } ///< @brief 本帧已分配的字节数
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        void* allocateFromCurrent(size_t bytes, size_t alignment);  ///< @brief 在当前块中分配，放不下时返回 nullptr
+        Block allocateBlock(size_t size);                           ///< @brief 向上游申请一块内存
+        void releaseBlock(Block& block);                            ///< @brief 把一块内存还给上游
+    };
+}
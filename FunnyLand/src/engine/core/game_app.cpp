@@ -1,6 +1,7 @@
 ﻿#include "game_app.h"
 #include "time.h"
 #include "../resource/resource_manager.h"
+#include "../resource/texture_atlas.h"
 #include "../render/sprite.h"
 #include "../render/renderer.h"
 #include "../render/camera.h"
@@ -10,7 +11,13 @@
 #include "../component/sprite_component.h"
 #include "config.h"
 #include "context.h"
+#include "frame_arena.h"
+#include "job_system.h"
+#include "memory_tracker.h"
+#include "profiler.h"
 #include <SDL3/SDL.h>
+#include <cmath>
+#include <filesystem>
 #include <spdlog/spdlog.h>
 
 #include "../../game/scene/game_scene.h"
@@ -37,17 +44,46 @@ void GameApp::run()
         return;
     }
     
+    const double ms_per_tick = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    Uint64 frame_start = SDL_GetPerformanceCounter();
     while (is_running_)
     {
+        ENGINE_PROFILE_SCOPE("Frame");
+        frame_arena_->reset();  // 回收上一帧的临时内存
         time_->update();
         float delta_time = time_->getDeltaTime();
-        input_manager_->update();//输入更新管理
         
+        Uint64 phase_start = SDL_GetPerformanceCounter();
+        {
+            ENGINE_PROFILE_SCOPE("InputManager::update");
+            input_manager_->update();//输入更新管理
+        }
+        Uint64 phase_end = SDL_GetPerformanceCounter();
+        frame_timings_.input_ms = (phase_end - phase_start) * ms_per_tick;
+        
+        phase_start = phase_end;
         handleEvents();
+        phase_end = SDL_GetPerformanceCounter();
+        frame_timings_.events_ms = (phase_end - phase_start) * ms_per_tick;
+        
+        phase_start = phase_end;
         update(delta_time);
-        render();
+        phase_end = SDL_GetPerformanceCounter();
+        frame_timings_.update_ms = (phase_end - phase_start) * ms_per_tick;
+        
+        render();   // 内部记录 render_ms / present_ms
+        frame_timings_.frame_arena_bytes = frame_arena_->getUsedBytes();
+        MemoryTracker::checkBudgets();  // 超出预算的标签只在越界时警告一次
         
         //spdlog::info("delta time: {}", delta_time);
+        
+        // 整帧耗时按相邻两帧的起点计算，包含 Time::update 中的帧率限制等待
+        const Uint64 now = SDL_GetPerformanceCounter();
+        frame_timings_.frame_ms = (now - frame_start) * ms_per_tick;
+        frame_start = now;
+        if (frame_callback_) frame_callback_(frame_timings_);
+        ++frame_timings_.frame_index;
+        if (max_frames_ > 0 && frame_timings_.frame_index >= max_frames_) is_running_ = false;
     }
     
     close();
@@ -59,6 +95,9 @@ bool GameApp::init()
     if (!initConfig()) return false;
    if (!initSDL()) return false;
    if (!initTime()) return false;
+   if (!initJobSystem()) return false;
+   if (!initFrameArena()) return false;
+   if (!initMemoryTracker()) return false;
    if (!initResourceManager()) return false;
    if (!initRenderer()) return false;
    if (!initCamera()) return false;
@@ -66,7 +105,9 @@ bool GameApp::init()
    if (!initContext()) return false;
    if (!initSceneManager()) return false;
     
-    auto scene = std::make_unique<game::scene::GameScene>("GameScene",*context_,*scene_manager_);
+    std::unique_ptr<engine::scene::Scene> scene = scene_factory_
+        ? scene_factory_(*context_, *scene_manager_)
+        : std::make_unique<game::scene::GameScene>("GameScene",*context_,*scene_manager_);
     scene_manager_->requestPushScene(std::move(scene));
     
    is_running_ = true;
@@ -82,27 +123,69 @@ void GameApp::handleEvents()
         return;
     }
     
+    ENGINE_PROFILE_SCOPE("GameApp::handleEvents");
     scene_manager_->handleInput();
     
 }
 
 void GameApp::update(float delta_time)
 {
-    scene_manager_->update(delta_time);
+    ENGINE_PROFILE_SCOPE("GameApp::update");
+    if (!config_->fixed_timestep_enabled_)
+    {
+        // 可变步长：直接用帧间隔更新，渲染使用当前状态
+        scene_manager_->update(delta_time);
+        frame_timings_.simulation_steps = 1;
+        context_->setInterpolationAlpha(1.0f);
+        return;
+    }
+    
+    // 固定步长：累积帧间隔，按固定步长消耗，剩余部分用于渲染插值
+    const double step = 1.0 / static_cast<double>(config_->tick_rate_);
+    accumulator_ += delta_time;
+    int steps = 0;
+    while (accumulator_ >= step && steps < config_->max_steps_per_frame_)
+    {
+        scene_manager_->update(static_cast<float>(step));
+        accumulator_ -= step;
+        ++steps;
+    }
+    if (accumulator_ >= step)
+    {
+        // 模拟追不上真实时间（死亡螺旋），丢弃积压的整步，只保留不足一步的部分
+        spdlog::debug("GameApp: 本帧模拟步数达到上限 {}，丢弃 {:.3f}s", config_->max_steps_per_frame_, accumulator_ - std::fmod(accumulator_, step));
+        accumulator_ = std::fmod(accumulator_, step);
+    }
+    frame_timings_.simulation_steps = steps;
+    context_->setInterpolationAlpha(static_cast<float>(accumulator_ / step));
 }
 
 void GameApp::render()
 {
+    ENGINE_PROFILE_SCOPE("GameApp::render");
     //固定流程顺序不要搞错
     
+    // 0. 上传后台加载完成的资源（创建纹理必须在渲染线程，按时间预算分摊到多帧）
+    {
+        ENGINE_PROFILE_SCOPE("ResourceManager::processAsyncLoads");
+        resource_manager_->processAsyncLoads(config_->async_upload_budget_ms_);
+    }
+    
     // 1. 清除屏幕
+    const Uint64 render_start = SDL_GetPerformanceCounter();
     renderer_->clearScreen();
 
-    // 2. 具体渲染代码
+    // 2. 具体渲染代码（只记录绘制命令，不调用 SDL）
     scene_manager_->render();
+    const Uint64 present_start = SDL_GetPerformanceCounter();
 
-    // 3. 更新屏幕显示
+    // 3. 回放本帧的绘制命令并更新屏幕显示
     renderer_->present();
+    frame_timings_.render_commands = renderer_->getSubmittedCommands().size();
+    
+    const double ms_per_tick = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    frame_timings_.render_ms = (present_start - render_start) * ms_per_tick;
+    frame_timings_.present_ms = (SDL_GetPerformanceCounter() - present_start) * ms_per_tick;
     
     
 }
@@ -110,6 +193,24 @@ void GameApp::render()
 void GameApp::close()
 {
     spdlog::trace("GameApp关闭...");
+
+    if (time_)
+    {
+        const FrameTimeStats stats = time_->getFrameTimeStats();
+        spdlog::info("最近 {} 帧帧时间: 平均 {:.3f}ms, 标准差 {:.3f}ms, 最短 {:.3f}ms, 最长 {:.3f}ms, 错过截止时间 {} 次",
+            stats.sample_count, stats.mean * 1000.0, stats.std_dev * 1000.0, stats.min * 1000.0, stats.max * 1000.0, stats.missed_deadlines);
+    }
+
+    // 退出前各子系统、各场景的内存占用
+    MemoryTracker::logSnapshot(MemoryTracker::snapshot());
+
+#if FUNNYLAND_PROFILE
+    // 导出本次运行最近一段时间的性能记录
+    if (config_ && !config_->profile_trace_path_.empty())
+    {
+        engine::core::Profiler::writeChromeTrace(config_->profile_trace_path_);
+    }
+#endif
     
     //为了确保正确的销毁顺序，有些智能指针需要手动管理
     resource_manager_.reset();
@@ -131,6 +232,7 @@ bool GameApp::initConfig()
     try
     {
         config_ = std::make_unique<Config>("assets/config.json");
+        if (config_override_) config_override_(*config_);
     }catch (const std::exception& e)
     {
         spdlog::error("初始化配置失败: {}", e.what());
@@ -188,12 +290,75 @@ bool GameApp::initTime()
     return true;
 }
 
+bool GameApp::initJobSystem()
+{
+    try
+    {
+        job_system_ = std::make_unique<JobSystem>(config_->job_worker_threads_);
+    }catch (const std::exception& e)
+    {
+        spdlog::error("初始化 JobSystem 失败: {}", e.what());
+        return false;
+    }
+    spdlog::trace("初始化 JobSystem 成功，工作线程数: {}", job_system_->getWorkerCount());
+    return true;
+}
+
+bool GameApp::initFrameArena()
+{
+    try
+    {
+        frame_arena_ = std::make_unique<FrameArena>(static_cast<size_t>(config_->frame_arena_kb_) << 10);
+    }catch (const std::exception& e)
+    {
+        spdlog::error("初始化帧内存池失败: {}", e.what());
+        return false;
+    }
+    spdlog::trace("初始化帧内存池成功，大小: {} KB", config_->frame_arena_kb_);
+    return true;
+}
+
+bool GameApp::initMemoryTracker()
+{
+    for (const auto& [name, budget_mb] : config_->memory_budgets_mb_)
+    {
+        if (budget_mb < 0)
+        {
+            spdlog::warn("内存标签 '{}' 的预算不能小于0，已忽略", name);
+            continue;
+        }
+        MemoryTracker::setBudget(MemoryTracker::registerTag(name), static_cast<std::size_t>(budget_mb) << 20);
+    }
+    spdlog::trace("初始化内存统计成功，堆分配跟踪: {}，预算标签数: {}",
+                  MemoryTracker::isHeapTrackingEnabled() ? "开启" : "关闭", config_->memory_budgets_mb_.size());
+    return true;
+}
+
 bool GameApp::initResourceManager()
 {
     try
     {
-        resource_manager_ = std::make_unique<engine::resource::ResourceManager>(sdl_renderer_);
-        
+        resource_manager_ = std::make_unique<engine::resource::ResourceManager>(sdl_renderer_, config_->asset_loader_threads_);
+        //资源包是可选的：开发时直接读取 assets/ 下的散文件
+        if (!config_->archive_path_.empty() && std::filesystem::exists(config_->archive_path_))
+        {
+            resource_manager_->mountArchive(config_->archive_path_);
+        }
+        else
+        {
+            spdlog::info("未找到资源包 {}，从散文件加载资源", config_->archive_path_);
+        }
+        if (config_->atlas_enabled_)
+        {
+            engine::resource::AtlasSettings atlas_settings;
+            atlas_settings.directories = config_->atlas_directories_;
+            atlas_settings.page_size = config_->atlas_page_size_;
+            atlas_settings.max_source_size = config_->atlas_max_source_size_;
+            atlas_settings.padding = config_->atlas_padding_;
+            atlas_settings.cache_path = config_->atlas_cache_path_;
+            resource_manager_->initTextureAtlas(atlas_settings);
+        }
+
     }catch (const std::exception& e)
     {
         spdlog::error("初始化资源管理器失败: {}", e.what());
@@ -250,7 +415,7 @@ bool GameApp::initContext()
 {
     try
     {
-        context_ = std::make_unique<Context>(*input_manager_,*renderer_,*camera_,*resource_manager_);
+        context_ = std::make_unique<Context>(*input_manager_,*renderer_,*camera_,*resource_manager_,*time_,*job_system_,*frame_arena_);
     }catch (const std::exception& e)
     {
         spdlog::error("初始化上下文失败: {}", e.what());
@@ -265,6 +430,14 @@ bool GameApp::initSceneManager()
     try
     {
         scene_manager_ = std::make_unique<engine::scene::SceneManager>(*context_);
+        
+        engine::scene::StreamingSettings streaming_settings;
+        streaming_settings.prefetch_margin = config_->streaming_prefetch_margin_;
+        streaming_settings.unload_margin = config_->streaming_unload_margin_;
+        streaming_settings.memory_budget = static_cast<size_t>(config_->streaming_memory_budget_mb_) << 20;
+        streaming_settings.max_chunk_loads_per_frame = config_->streaming_max_chunk_loads_per_frame_;
+        streaming_settings.object_cell_size = config_->streaming_object_cell_size_;
+        scene_manager_->setStreamingSettings(streaming_settings);
     }catch (const std::exception& e)
     {
         spdlog::error("初始化场景管理器失败: {}", e.what());
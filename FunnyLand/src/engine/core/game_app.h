@@ -1,8 +1,12 @@
 ﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 
 namespace engine::scene
 {
+    class Scene;
     class SceneManager;
 }
 
@@ -30,6 +34,23 @@ namespace  engine::core
     class Context;
     class Config;
     class Time;
+    class JobSystem;
+    class FrameArena;
+
+    /// @brief 一帧中各阶段的耗时（毫秒），由 GameApp 每帧测量
+    struct FrameTimings
+    {
+        std::uint64_t frame_index = 0;  ///< @brief 帧序号（从 0 开始）
+        double input_ms = 0.0;          ///< @brief InputManager::update
+        double events_ms = 0.0;         ///< @brief handleEvents（场景输入处理）
+        double update_ms = 0.0;         ///< @brief 场景更新（固定步长模式下为本帧所有模拟步之和）
+        int simulation_steps = 0;       ///< @brief 本帧执行的模拟步数（可变步长模式下恒为 1）
+        double render_ms = 0.0;         ///< @brief 清屏 + 场景渲染（记录绘制命令）
+        double present_ms = 0.0;        ///< @brief Renderer::present（回放绘制命令并交换缓冲）
+        std::size_t render_commands = 0;    ///< @brief 本帧提交的绘制命令数
+        std::size_t frame_arena_bytes = 0;  ///< @brief 本帧从帧内存池分配的字节数
+        double frame_ms = 0.0;          ///< @brief 整帧（含帧率限制的等待）
+    };
 
 
     class GameApp final // final 表示不能被继承
@@ -42,6 +63,8 @@ namespace  engine::core
         
         //引擎组件
         std::unique_ptr<engine::core::Time> time_;//deltatime 计算
+        std::unique_ptr<engine::core::JobSystem> job_system_;//任务调度器（比场景和上下文活得久）
+        std::unique_ptr<engine::core::FrameArena> frame_arena_;//帧内存池（每帧开始时重置）
         std::unique_ptr<engine::resource::ResourceManager> resource_manager_;
         std::unique_ptr<engine::render::Renderer> renderer_;
         std::unique_ptr<engine::render::Camera> camera_;
@@ -50,6 +73,14 @@ namespace  engine::core
         std::unique_ptr<engine::core::Context> context_;
         std::unique_ptr<engine::scene::SceneManager> scene_manager_;
         
+        //运行参数（基准测试等工具用来驱动引擎）
+        std::function<void(Config&)> config_override_;              // 加载配置文件后对配置的修改
+        std::function<std::unique_ptr<engine::scene::Scene>(engine::core::Context&, engine::scene::SceneManager&)> scene_factory_; // 初始场景（为空时使用 GameScene）
+        std::function<void(const FrameTimings&)> frame_callback_;   // 每帧结束时回调
+        std::uint64_t max_frames_ = 0;                              // 运行的最大帧数（0表示不限制）
+        FrameTimings frame_timings_;                                // 当前帧的阶段耗时
+        double accumulator_ = 0.0;                                  // 固定步长模式下尚未模拟的时间（秒）
+        
     public:
         GameApp();
         ~GameApp();
@@ -57,6 +88,12 @@ namespace  engine::core
         //游戏运行程序中间会调用init(),进入主循环，离开循环后调用close()
         void run();
         
+        //以下设置需在 run() 之前调用
+        void setConfigOverride(std::function<void(Config&)> config_override) { config_override_ = std::move(config_override); }
+        void setSceneFactory(std::function<std::unique_ptr<engine::scene::Scene>(engine::core::Context&, engine::scene::SceneManager&)> scene_factory) { scene_factory_ = std::move(scene_factory); }
+        void setFrameCallback(std::function<void(const FrameTimings&)> frame_callback) { frame_callback_ = std::move(frame_callback); }
+        void setMaxFrames(std::uint64_t max_frames) { max_frames_ = max_frames; }
+        
         //禁用掉拷贝和移动构造函数
         GameApp(const GameApp&) = delete;
         GameApp(GameApp&&) = delete;
@@ -74,6 +111,9 @@ namespace  engine::core
         [[nodiscard]] bool initConfig();
         [[nodiscard]] bool initSDL();
         [[nodiscard]] bool initTime();
+        [[nodiscard]] bool initJobSystem();
+        [[nodiscard]] bool initFrameArena();
+        [[nodiscard]] bool initMemoryTracker();
         [[nodiscard]] bool initResourceManager();
         [[nodiscard]] bool initRenderer();
         [[nodiscard]] bool initCamera();
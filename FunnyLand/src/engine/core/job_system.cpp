@@ -0,0 +1,165 @@
+﻿#include "job_system.h"
+#include "memory_tracker.h"
+#include "profiler.h"
+#include <algorithm>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    namespace
+    {
+        thread_local size_t t_queue_index = 0;  ///< @brief 当前线程拥有的队列（非工作线程共用 0 号）
+    }
+
+    void JobSystem::WorkQueue::push(const Job& job)
+    {
+        if (count == ring.size())
+        {
+            //扩容并把环形数据摊平到新缓冲区开头（队列常驻，不计入提交任务的场景）
+            ENGINE_MEMORY_SCOPE(memory_tags::ENGINE);
+            std::vector<Job> grown(std::max<size_t>(ring.size() * 2, 64));
+            for (size_t i = 0; i < count; ++i) grown[i] = ring[(head + i) % ring.size()];
+            ring = std::move(grown);
+            head = 0;
+        }
+        ring[(head + count) % ring.size()] = job;
+        ++count;
+    }
+
+    bool JobSystem::WorkQueue::popBack(Job& job)
+    {
+        if (count == 0) return false;
+        --count;
+        job = ring[(head + count) % ring.size()];
+        return true;
+    }
+
+    bool JobSystem::WorkQueue::popFront(Job& job)
+    {
+        if (count == 0) return false;
+        job = ring[head];
+        head = (head + 1) % ring.size();
+        --count;
+        return true;
+    }
+
+    JobSystem::JobSystem(int worker_count)
+    {
+        if (worker_count < 0)
+        {
+            const unsigned hardware_threads = std::thread::hardware_concurrency();
+            worker_count = hardware_threads > 1 ? static_cast<int>(hardware_threads) - 1 : 0;
+        }
+        queues_.reserve(static_cast<size_t>(worker_count) + 1);
+        for (int i = 0; i <= worker_count; ++i)
+        {
+            queues_.push_back(std::make_unique<WorkQueue>());
+        }
+        workers_.reserve(static_cast<size_t>(worker_count));
+        for (int i = 1; i <= worker_count; ++i)
+        {
+            workers_.emplace_back(&JobSystem::workerLoop, this, static_cast<size_t>(i));
+        }
+        spdlog::trace("JobSystem 构造完成，工作线程数: {}", worker_count);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        sleep_cv_.notify_all();
+        for (auto& worker : workers_)
+        {
+            if (worker.joinable()) worker.join();
+        }
+        if (queued_jobs_.load() > 0) spdlog::warn("JobSystem 析构时仍有 {} 个任务未执行", queued_jobs_.load());
+        spdlog::trace("JobSystem 析构完成");
+    }
+
+    void JobSystem::schedule(const Job& job)
+    {
+        job.counter->pending_.fetch_add(1, std::memory_order_relaxed);
+        if (workers_.empty())
+        {
+            execute(job);
+            return;
+        }
+        //先计数再入队：任务一入队就可能被其他线程窃取并减计数，反过来计数会短暂下溢
+        queued_jobs_.fetch_add(1, std::memory_order_release);
+        {
+            auto& queue = *queues_[t_queue_index];
+            std::lock_guard lock(queue.mutex);
+            queue.push(job);
+        }
+        //先经过 sleep_mutex_ 再通知：正准备休眠的工作线程要么已看到新任务，要么已在等待，不会错过通知
+        {
+            std::lock_guard lock(sleep_mutex_);
+        }
+        sleep_cv_.notify_one();
+    }
+
+    void JobSystem::wait(JobCounter& counter)
+    {
+        Job job;
+        while (!counter.isDone())
+        {
+            if (tryGetJob(t_queue_index, job)) execute(job);
+            else std::this_thread::yield();     //剩下的任务正在其他线程执行
+        }
+    }
+
+    void JobSystem::workerLoop(size_t queue_index)
+    {
+        t_queue_index = queue_index;
+#if FUNNYLAND_PROFILE
+        Profiler::setThreadName("JobWorker " + std::to_string(queue_index));
+#endif
+        Job job;
+        while (true)
+        {
+            if (tryGetJob(queue_index, job))
+            {
+                execute(job);
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            sleep_cv_.wait(lock, [this] { return stopping_ || queued_jobs_.load(std::memory_order_acquire) > 0; });
+            if (stopping_) return;
+        }
+    }
+
+    bool JobSystem::tryGetJob(size_t queue_index, Job& job)
+    {
+        if (queued_jobs_.load(std::memory_order_acquire) == 0) return false;
+        {
+            auto& own = *queues_[queue_index];
+            std::lock_guard lock(own.mutex);
+            if (own.popBack(job))
+            {
+                queued_jobs_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        //从下一个队列开始轮流窃取，避免所有线程都去抢同一个队列
+        for (size_t offset = 1; offset < queues_.size(); ++offset)
+        {
+            auto& victim = *queues_[(queue_index + offset) % queues_.size()];
+            std::lock_guard lock(victim.mutex);
+            if (victim.popFront(job))
+            {
+                queued_jobs_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void JobSystem::execute(const Job& job)
+    {
+        job.function(job.data, job.begin, job.end);
+        job.counter->pending_.fetch_sub(1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,125 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace engine::core
+{
+    /**
+     * @brief 一组任务的完成计数：提交任务时加一，任务执行完减一，JobSystem::wait() 等到它归零。
+     */
+    class JobCounter final
+    {
+        friend class JobSystem;
+    private:
+        std::atomic<size_t> pending_ = 0;
+
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool isDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+    };
+
+    /**
+     * @brief 工作窃取（work-stealing）任务调度器，用于把一帧内可以并行的计算分给多个核心。
+     *
+     * 每个线程（主线程和每个工作线程）有自己的任务队列：自己从队尾取（后进先出，缓存友好），
+     * 空闲时从其他线程的队首窃取（先进先出，偷走较大的剩余工作）。没有任务时工作线程休眠。
+     * 提交任务的线程在 wait() 中也会执行任务，而不是干等。
+     *
+     * 任务是函数指针 + 数据指针 + 区间，提交时不分配内存（队列容量只在超过历史最大值时增长）。
+     * 任务不能抛出异常；任务中不要调用 SDL、渲染器或修改场景结构，这些只能在主线程进行。
+     */
+    class JobSystem final
+    {
+    public:
+        using JobFunction = void (*)(void* data, size_t begin, size_t end);
+
+        /// @brief 一个任务：function(data, begin, end)，执行完后递减 counter
+        struct Job
+        {
+            JobFunction function = nullptr;
+            void* data = nullptr;
+            size_t begin = 0;
+            size_t end = 0;
+            JobCounter* counter = nullptr;
+        };
+
+    private:
+        /// @brief 单个线程的任务队列（环形缓冲区，互斥锁保护，竞争只发生在窃取时）
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::vector<Job> ring;
+            size_t head = 0;        ///< @brief 队首下标
+            size_t count = 0;       ///< @brief 任务数
+
+            void push(const Job& job);
+            bool popBack(Job& job);
+            bool popFront(Job& job);
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> queues_;    ///< @brief 0 号给主线程（及其他非工作线程），之后每个工作线程一个
+        std::vector<std::thread> workers_;
+        std::atomic<size_t> queued_jobs_ = 0;               ///< @brief 所有队列中等待执行的任务数
+        std::mutex sleep_mutex_;
+        std::condition_variable sleep_cv_;
+        bool stopping_ = false;                             ///< @brief 由 sleep_mutex_ 保护
+
+    public:
+        /**
+         * @brief 构造函数，启动工作线程。
+         * @param worker_count 工作线程数，小于 0 时取 硬件线程数 - 1，为 0 时所有任务都在调用线程中执行
+         */
+        explicit JobSystem(int worker_count = -1);
+        ~JobSystem();   ///< @brief 停止并等待工作线程（调用前应已等待完所有任务）
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        size_t getWorkerCount() const { return workers_.size(); }   ///< @brief 工作线程数（不含主线程）
+
+        /// @brief 提交任务到当前线程的队列（job.counter 必须有效，并在之后对它调用 wait）
+        void schedule(const Job& job);
+        /// @brief 等待计数归零，等待期间执行（或窃取）任务
+        void wait(JobCounter& counter);
+
+        /**
+         * @brief 把 [0, count) 按 batch_size 分段并行执行 function(begin, end)，返回时全部完成。
+         *        没有工作线程或只有一段时直接在当前线程执行。
+         */
+        template<typename Function>
+        void parallelFor(size_t count, size_t batch_size, Function&& function)
+        {
+            if (count == 0) return;
+            if (batch_size == 0) batch_size = 1;
+            if (workers_.empty() || count <= batch_size)
+            {
+                function(size_t{0}, count);
+                return;
+            }
+            using FunctionType = std::remove_reference_t<Function>;
+            JobCounter counter;
+            for (size_t begin = 0; begin < count; begin += batch_size)
+            {
+                schedule({[](void* data, size_t range_begin, size_t range_end) { (*static_cast<FunctionType*>(data))(range_begin, range_end); },
+                          const_cast<void*>(static_cast<const void*>(&function)), begin, std::min(begin + batch_size, count), &counter});
+            }
+            wait(counter);
+        }
+
+    private:
+        void workerLoop(size_t queue_index);
+        bool tryGetJob(size_t queue_index, Job& job);      ///< @brief 先取自己队尾，再窃取其他队列的队首
+        static void execute(const Job& job);
+    };
+}
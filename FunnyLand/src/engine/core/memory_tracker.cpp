@@ -0,0 +1,343 @@
+﻿#include "memory_tracker.h"
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    namespace
+    {
+        /// @brief 一个标签的计数器。全部是常量初始化的原子变量，operator new 在静态初始化之前被调用也是安全的
+        struct TagCounters
+        {
+            std::atomic<std::int64_t> heap_bytes{0};
+            std::atomic<std::int64_t> heap_allocations{0};
+            std::atomic<std::int64_t> resource_bytes{0};
+            std::atomic<std::int64_t> resource_count{0};
+            std::atomic<std::size_t> budget{0};
+            std::atomic<bool> is_over_budget{false};
+        };
+
+        TagCounters g_counters[MemoryTracker::MAX_TAGS];
+        std::atomic<std::uint64_t> g_total_allocations{0};
+        std::atomic<std::uint64_t> g_total_allocated_bytes{0};
+        thread_local MemoryTag t_current_tag = memory_tags::GENERAL;
+
+        /// @brief 标签名称表（注册后不再修改）
+        struct TagRegistry
+        {
+            std::mutex mutex;
+            std::array<std::string, MemoryTracker::MAX_TAGS> names;
+            std::atomic<std::size_t> count{memory_tags::BUILTIN_COUNT};
+
+            TagRegistry()
+            {
+                names[memory_tags::GENERAL] = "General";
+                names[memory_tags::RESOURCES] = "Resources";
+                names[memory_tags::TEXTURES] = "Textures";
+                names[memory_tags::AUDIO] = "Audio";
+                names[memory_tags::FONTS] = "Fonts";
+                names[memory_tags::RENDER] = "Render";
+                names[memory_tags::ENGINE] = "Engine";
+            }
+        };
+
+        TagRegistry& registry()
+        {
+            static TagRegistry instance;
+            return instance;
+        }
+
+        TagCounters& counters(MemoryTag tag)
+        {
+            return g_counters[tag < MemoryTracker::MAX_TAGS ? tag : memory_tags::GENERAL];
+        }
+
+        /// @brief 字节数转换为便于阅读的文本（B / KB / MB）
+        std::string formatBytes(std::int64_t bytes)
+        {
+            char buffer[32];
+            const double value = static_cast<double>(bytes);
+            const double magnitude = value < 0.0 ? -value : value;
+            if (magnitude >= 1024.0 * 1024.0) std::snprintf(buffer, sizeof(buffer), "%.2f MB", value / (1024.0 * 1024.0));
+            else if (magnitude >= 1024.0) std::snprintf(buffer, sizeof(buffer), "%.2f KB", value / 1024.0);
+            else std::snprintf(buffer, sizeof(buffer), "%lld B", static_cast<long long>(bytes));
+            return buffer;
+        }
+    }
+
+    const MemoryTagStats* MemorySnapshot::find(const std::string& name) const
+    {
+        for (const auto& stats : tags)
+        {
+            if (stats.name == name) return &stats;
+        }
+        return nullptr;
+    }
+
+    std::int64_t MemorySnapshot::getTotalBytes() const
+    {
+        std::int64_t total = 0;
+        for (const auto& stats : tags) total += stats.getTotalBytes();
+        return total;
+    }
+
+    std::int64_t MemoryDiff::getTotalBytes() const
+    {
+        std::int64_t total = 0;
+        for (const auto& stats : tags) total += stats.getTotalBytes();
+        return total;
+    }
+
+    MemoryTag MemoryTracker::registerTag(const std::string& name)
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        const std::size_t count = reg.count.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (reg.names[i] == name) return static_cast<MemoryTag>(i);
+        }
+        if (count >= MAX_TAGS)
+        {
+            spdlog::warn("MemoryTracker: 标签数达到上限 {}，'{}' 记入 General", MAX_TAGS, name);
+            return memory_tags::GENERAL;
+        }
+        {
+            ENGINE_MEMORY_SCOPE(memory_tags::ENGINE);   //标签名常驻，不记在调用者（通常是正在更新的场景）名下
+            reg.names[count] = name;
+        }
+        reg.count.store(count + 1, std::memory_order_release);
+        return static_cast<MemoryTag>(count);
+    }
+
+    std::string MemoryTracker::getTagName(MemoryTag tag)
+    {
+        auto& reg = registry();
+        if (tag >= reg.count.load(std::memory_order_acquire)) return {};
+        return reg.names[tag];
+    }
+
+    MemoryTag MemoryTracker::getCurrentTag()
+    {
+        return t_current_tag;
+    }
+
+    void MemoryTracker::setCurrentTag(MemoryTag tag)
+    {
+        t_current_tag = tag;
+    }
+
+    void MemoryTracker::addResource(MemoryTag tag, std::int64_t bytes, std::int64_t count)
+    {
+        auto& c = counters(tag);
+        c.resource_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        c.resource_count.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::onHeapAllocate(MemoryTag tag, std::size_t bytes)
+    {
+        auto& c = counters(tag);
+        c.heap_bytes.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+        c.heap_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_total_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_total_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::onHeapFree(MemoryTag tag, std::size_t bytes)
+    {
+        auto& c = counters(tag);
+        c.heap_bytes.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+        c.heap_allocations.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::setBudget(MemoryTag tag, std::size_t bytes)
+    {
+        auto& c = counters(tag);
+        c.budget.store(bytes, std::memory_order_relaxed);
+        c.is_over_budget.store(false, std::memory_order_relaxed);
+    }
+
+    bool MemoryTracker::checkBudgets()
+    {
+        bool within = true;
+        const std::size_t count = registry().count.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto& c = g_counters[i];
+            const std::size_t budget = c.budget.load(std::memory_order_relaxed);
+            if (budget == 0) continue;
+            const std::int64_t used = c.heap_bytes.load(std::memory_order_relaxed) + c.resource_bytes.load(std::memory_order_relaxed);
+            const bool is_over = used > static_cast<std::int64_t>(budget);
+            within &= !is_over;
+            if (is_over == c.is_over_budget.load(std::memory_order_relaxed)) continue;
+            c.is_over_budget.store(is_over, std::memory_order_relaxed);
+            const std::string name = getTagName(static_cast<MemoryTag>(i));
+            if (is_over) spdlog::warn("MemoryTracker: '{}' 使用 {}，超出预算 {}", name, formatBytes(used), formatBytes(static_cast<std::int64_t>(budget)));
+            else spdlog::info("MemoryTracker: '{}' 回到预算内（{} / {}）", name, formatBytes(used), formatBytes(static_cast<std::int64_t>(budget)));
+        }
+        return within;
+    }
+
+    MemorySnapshot MemoryTracker::snapshot()
+    {
+        MemorySnapshot result;
+        const std::size_t count = registry().count.load(std::memory_order_acquire);
+        result.tags.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& c = g_counters[i];
+            MemoryTagStats& stats = result.tags.emplace_back();
+            stats.tag = static_cast<MemoryTag>(i);
+            stats.name = getTagName(stats.tag);
+            stats.heap_bytes = c.heap_bytes.load(std::memory_order_relaxed);
+            stats.heap_allocations = c.heap_allocations.load(std::memory_order_relaxed);
+            stats.resource_bytes = c.resource_bytes.load(std::memory_order_relaxed);
+            stats.resource_count = c.resource_count.load(std::memory_order_relaxed);
+            stats.budget = c.budget.load(std::memory_order_relaxed);
+        }
+        result.total_allocations = g_total_allocations.load(std::memory_order_relaxed);
+        result.total_allocated_bytes = g_total_allocated_bytes.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    MemoryDiff MemoryTracker::diff(const MemorySnapshot& before, const MemorySnapshot& after)
+    {
+        MemoryDiff result;
+        result.allocations = after.total_allocations - before.total_allocations;
+        result.allocated_bytes = after.total_allocated_bytes - before.total_allocated_bytes;
+        //标签只增不减，after 的标签包含 before 的全部标签（编号相同）
+        for (const auto& current : after.tags)
+        {
+            MemoryTagStats change = current;
+            if (current.tag < before.tags.size())
+            {
+                const auto& previous = before.tags[current.tag];
+                change.heap_bytes -= previous.heap_bytes;
+                change.heap_allocations -= previous.heap_allocations;
+                change.resource_bytes -= previous.resource_bytes;
+                change.resource_count -= previous.resource_count;
+            }
+            if (change.heap_bytes == 0 && change.heap_allocations == 0 && change.resource_bytes == 0 && change.resource_count == 0) continue;
+            result.tags.push_back(std::move(change));
+        }
+        return result;
+    }
+
+    void MemoryTracker::logSnapshot(const MemorySnapshot& snapshot)
+    {
+        spdlog::info("内存统计（堆统计{}）：合计 {}", isHeapTrackingEnabled() ? "开启" : "关闭", formatBytes(snapshot.getTotalBytes()));
+        for (const auto& stats : snapshot.tags)
+        {
+            if (stats.heap_allocations == 0 && stats.resource_count == 0) continue;
+            spdlog::info("  {:<24} 堆 {:>12} ({} 次分配)  资源 {:>12} ({} 个){}", stats.name, formatBytes(stats.heap_bytes), stats.heap_allocations,
+                         formatBytes(stats.resource_bytes), stats.resource_count,
+                         stats.budget > 0 ? "  预算 " + formatBytes(static_cast<std::int64_t>(stats.budget)) : std::string());
+        }
+    }
+
+    void MemoryTracker::logDiff(const MemoryDiff& diff)
+    {
+        spdlog::info("内存变化：净增 {}，期间 {} 次堆分配共 {}", formatBytes(diff.getTotalBytes()), diff.allocations,
+                     formatBytes(static_cast<std::int64_t>(diff.allocated_bytes)));
+        for (const auto& stats : diff.tags)
+        {
+            spdlog::info("  {:<24} 堆 {:>12} ({:+} 次分配)  资源 {:>12} ({:+} 个)", stats.name, formatBytes(stats.heap_bytes), stats.heap_allocations,
+                         formatBytes(stats.resource_bytes), stats.resource_count);
+        }
+    }
+
+    std::uint64_t MemoryTracker::getTotalAllocations()
+    {
+        return g_total_allocations.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t MemoryTracker::getTotalAllocatedBytes()
+    {
+        return g_total_allocated_bytes.load(std::memory_order_relaxed);
+    }
+}
+
+#if FUNNYLAND_MEMORY_TRACKING
+
+// ---------------------------------------------------------------------------
+// 全局 operator new/delete 替换：每块内存前放一个头，记录大小、标签和到 malloc 返回地址的偏移，
+// 释放时从分配时的标签上扣除（与释放时所在的标签无关）。
+// ---------------------------------------------------------------------------
+namespace
+{
+    struct AllocationHeader
+    {
+        std::size_t size;
+        std::uint32_t offset;               ///< @brief 用户指针到 malloc 返回地址的距离
+        engine::core::MemoryTag tag;
+    };
+    constexpr std::size_t HEADER_SIZE = 16; ///< @brief 头占用的空间（保持默认对齐）
+    static_assert(sizeof(AllocationHeader) <= HEADER_SIZE && HEADER_SIZE % alignof(std::max_align_t) == 0);
+
+    void* trackedAlloc(std::size_t size, std::size_t alignment)
+    {
+        if (size == 0) size = 1;
+        std::byte* raw = nullptr;
+        std::byte* user = nullptr;
+        if (alignment <= alignof(std::max_align_t))
+        {
+            raw = static_cast<std::byte*>(std::malloc(size + HEADER_SIZE));
+            if (!raw) return nullptr;
+            user = raw + HEADER_SIZE;
+        }
+        else
+        {
+            raw = static_cast<std::byte*>(std::malloc(size + HEADER_SIZE + alignment));
+            if (!raw) return nullptr;
+            const auto address = reinterpret_cast<std::uintptr_t>(raw) + HEADER_SIZE;
+            user = reinterpret_cast<std::byte*>((address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+        }
+        const engine::core::MemoryTag tag = engine::core::MemoryTracker::getCurrentTag();
+        ::new (user - HEADER_SIZE) AllocationHeader{size, static_cast<std::uint32_t>(user - raw), tag};
+        engine::core::MemoryTracker::onHeapAllocate(tag, size);
+        return user;
+    }
+
+    void trackedFree(void* ptr)
+    {
+        if (!ptr) return;
+        auto* user = static_cast<std::byte*>(ptr);
+        const auto* header = reinterpret_cast<const AllocationHeader*>(user - HEADER_SIZE);
+        engine::core::MemoryTracker::onHeapFree(header->tag, header->size);
+        std::free(user - header->offset);
+    }
+
+    void* trackedAllocOrThrow(std::size_t size, std::size_t alignment)
+    {
+        if (void* ptr = trackedAlloc(size, alignment)) return ptr;
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return trackedAllocOrThrow(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return trackedAllocOrThrow(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return trackedAllocOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return trackedAllocOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return trackedAlloc(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return trackedAlloc(size, static_cast<std::size_t>(alignment)); }
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+
+#endif
@@ -0,0 +1,140 @@
+﻿#pragma once
+
+/**
+ * 分标签的内存统计（子系统 / 场景）。
+ *
+ * 两类数据：
+ * - 堆内存：替换全局 operator new/delete，每次分配记在当前线程的标签上（用 ENGINE_MEMORY_SCOPE 切换），
+ *   释放时从分配时的标签上扣除。开关：FUNNYLAND_MEMORY_TRACKING，未定义时与 FUNNYLAND_PROFILE 一样
+ *   Debug 默认开启、Release 默认关闭；关闭时不替换 operator new，堆内存一栏恒为 0。
+ * - 资源：SDL 纹理、Mix_Chunk、字体等不经过 operator new 的内存，由各资源管理器在加载/释放时显式登记。
+ *   纹理记在发起加载的场景标签上（场景外加载的记在 TEXTURES），场景标签的资源内存即该场景加载的显存。
+ *
+ * 用法：
+ *   ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);   // 到作用域结束前的分配都记在该标签上
+ *   auto before = MemoryTracker::snapshot(); ...切换关卡... MemoryTracker::logDiff(MemoryTracker::diff(before, MemoryTracker::snapshot()));
+ */
+#ifndef FUNNYLAND_MEMORY_TRACKING
+    #ifdef NDEBUG
+        #define FUNNYLAND_MEMORY_TRACKING 0
+    #else
+        #define FUNNYLAND_MEMORY_TRACKING 1
+    #endif
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace engine::core
+{
+    using MemoryTag = std::uint16_t;   ///< @brief 内存标签（registerTag() 返回的编号）
+
+    /// @brief 内置标签
+    namespace memory_tags
+    {
+        inline constexpr MemoryTag GENERAL = 0;     ///< @brief 未指定标签的分配
+        inline constexpr MemoryTag RESOURCES = 1;   ///< @brief 资源管理器自身的堆内存（缓存表、路径等）
+        inline constexpr MemoryTag TEXTURES = 2;    ///< @brief 场景之外加载的 SDL 纹理（显存估算，如图集页面）
+        inline constexpr MemoryTag AUDIO = 3;       ///< @brief Mix_Chunk 音效数据和 Mix_Music
+        inline constexpr MemoryTag FONTS = 4;       ///< @brief TTF 字体（按字体文件大小估算）
+        inline constexpr MemoryTag RENDER = 5;      ///< @brief 渲染器（绘制命令列表、批处理缓冲）
+        inline constexpr MemoryTag ENGINE = 6;      ///< @brief 引擎常驻的其它容器（任务队列、帧内存池）
+        inline constexpr MemoryTag BUILTIN_COUNT = 7;
+    }
+
+    /// @brief 一个标签的统计数据（在 MemoryDiff 中表示变化量）
+    struct MemoryTagStats
+    {
+        MemoryTag tag = memory_tags::GENERAL;
+        std::string name;
+        std::int64_t heap_bytes = 0;            ///< @brief 未释放的堆内存（字节）
+        std::int64_t heap_allocations = 0;      ///< @brief 未释放的堆分配数
+        std::int64_t resource_bytes = 0;        ///< @brief 登记的资源内存（字节）
+        std::int64_t resource_count = 0;        ///< @brief 登记的资源数
+        std::size_t budget = 0;                 ///< @brief 预算（字节，0 表示不限制）
+
+        std::int64_t getTotalBytes() const { return heap_bytes + resource_bytes; }
+    };
+
+    /// @brief 某一时刻所有标签的统计
+    struct MemorySnapshot
+    {
+        std::vector<MemoryTagStats> tags;       ///< @brief 按标签编号排列
+        std::uint64_t total_allocations = 0;    ///< @brief 程序启动以来的堆分配总次数
+        std::uint64_t total_allocated_bytes = 0;///< @brief 程序启动以来的堆分配总字节数
+
+        const MemoryTagStats* find(const std::string& name) const;  ///< @brief 按名称查找标签，没有时返回 nullptr
+        std::int64_t getTotalBytes() const;                         ///< @brief 所有标签的堆内存与资源内存之和
+    };
+
+    /// @brief 两个快照之间的变化（只包含有变化的标签）
+    struct MemoryDiff
+    {
+        std::vector<MemoryTagStats> tags;       ///< @brief 各标签的变化量（after - before）
+        std::uint64_t allocations = 0;          ///< @brief 期间的堆分配次数
+        std::uint64_t allocated_bytes = 0;      ///< @brief 期间的堆分配字节数
+
+        bool empty() const { return tags.empty(); }
+        std::int64_t getTotalBytes() const;     ///< @brief 所有标签净增加的字节数
+    };
+
+    /**
+     * @brief 全局内存统计。
+     *
+     * 计数器都是原子变量，任何线程都可以登记；标签名称在注册后不再改变。
+     * 预算作用于 堆内存 + 资源内存，checkBudgets() 在超出时每个标签警告一次，回到预算内后重新计。
+     */
+    class MemoryTracker final
+    {
+    public:
+        static constexpr std::size_t MAX_TAGS = 64;     ///< @brief 标签数上限（包括内置标签）
+
+        MemoryTracker() = delete;
+
+        /// @brief 注册（或查找同名的）标签，标签用完时返回 GENERAL
+        static MemoryTag registerTag(const std::string& name);
+        static std::string getTagName(MemoryTag tag);
+
+        static MemoryTag getCurrentTag();               ///< @brief 当前线程的标签
+        static void setCurrentTag(MemoryTag tag);       ///< @brief 设置当前线程的标签（一般用 ENGINE_MEMORY_SCOPE）
+
+        /// @brief 登记资源内存（释放时传负数）
+        static void addResource(MemoryTag tag, std::int64_t bytes, std::int64_t count = 1);
+        /// @brief 记录一次堆分配/释放（由 operator new/delete 调用）
+        static void onHeapAllocate(MemoryTag tag, std::size_t bytes);
+        static void onHeapFree(MemoryTag tag, std::size_t bytes);
+
+        static void setBudget(MemoryTag tag, std::size_t bytes);   ///< @brief 设置标签的预算（0 表示不限制）
+        /// @brief 检查预算，新超出预算的标签输出警告，返回是否所有标签都在预算内
+        static bool checkBudgets();
+
+        static MemorySnapshot snapshot();               ///< @brief 读取所有标签的当前统计
+        static MemoryDiff diff(const MemorySnapshot& before, const MemorySnapshot& after);
+        static void logSnapshot(const MemorySnapshot& snapshot);   ///< @brief 以 info 级别输出快照
+        static void logDiff(const MemoryDiff& diff);               ///< @brief 以 info 级别输出变化
+
+        static std::uint64_t getTotalAllocations();     ///< @brief 程序启动以来的堆分配总次数（未开启堆统计时为 0）
+        static std::uint64_t getTotalAllocatedBytes();  ///< @brief 程序启动以来的堆分配总字节数（未开启堆统计时为 0）
+        static constexpr bool isHeapTrackingEnabled() { return FUNNYLAND_MEMORY_TRACKING != 0; }
+    };
+
+    /// @brief RAII：构造时切换当前线程的标签，析构时恢复
+    class MemoryScope final
+    {
+    private:
+        MemoryTag previous_;
+
+    public:
+        explicit MemoryScope(MemoryTag tag) : previous_(MemoryTracker::getCurrentTag()) { MemoryTracker::setCurrentTag(tag); }
+        ~MemoryScope() { MemoryTracker::setCurrentTag(previous_); }
+
+        MemoryScope(const MemoryScope&) = delete;
+        MemoryScope& operator=(const MemoryScope&) = delete;
+    };
+}
+
+#define ENGINE_MEMORY_CONCAT_INNER(a, b) a##b
+#define ENGINE_MEMORY_CONCAT(a, b) ENGINE_MEMORY_CONCAT_INNER(a, b)
+#define ENGINE_MEMORY_SCOPE(tag) ::engine::core::MemoryScope ENGINE_MEMORY_CONCAT(engine_memory_scope_, __LINE__)(tag)
@@ -0,0 +1,174 @@
+﻿#include "profiler.h"
+
+#if FUNNYLAND_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace engine::core
+{
+    namespace
+    {
+        /// @brief 单个线程的环形缓冲区，只由所属线程写入
+        struct ThreadBuffer
+        {
+            std::uint32_t thread_id = 0;
+            std::string thread_name;
+            std::vector<ProfileEvent> events;
+            size_t head = 0;        ///< @brief 下一条记录写入的位置
+            size_t count = 0;       ///< @brief 有效记录数（不超过容量）
+            std::uint32_t depth = 0;
+        };
+
+        /// @brief 所有线程缓冲区的登记表（缓冲区在程序结束前一直存在，线程退出后数据仍可导出）
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+            std::atomic<bool> enabled{true};
+            const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        };
+
+        Registry& registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        ThreadBuffer& threadBuffer()
+        {
+            thread_local ThreadBuffer* buffer = [] {
+                auto& reg = registry();
+                auto owned = std::make_unique<ThreadBuffer>();
+                owned->events.resize(Profiler::RING_CAPACITY);
+                std::lock_guard lock(reg.mutex);
+                owned->thread_id = static_cast<std::uint32_t>(reg.buffers.size() + 1);
+                owned->thread_name = owned->thread_id == 1 ? "Main" : "Thread " + std::to_string(owned->thread_id);
+                reg.buffers.push_back(std::move(owned));
+                return reg.buffers.back().get();
+            }();
+            return *buffer;
+        }
+
+        /// @brief 区段名一般是字面量，这里只处理 JSON 中必须转义的字符
+        void writeJsonString(std::ofstream& out, const char* text)
+        {
+            out << '"';
+            for (const char* c = text; c && *c; ++c)
+            {
+                switch (*c)
+                {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                default: out << *c; break;
+                }
+            }
+            out << '"';
+        }
+    }
+
+    void Profiler::setEnabled(bool enabled)
+    {
+        registry().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::isEnabled()
+    {
+        return registry().enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::setThreadName(const std::string& name)
+    {
+        auto& buffer = threadBuffer();
+        std::lock_guard lock(registry().mutex);
+        buffer.thread_name = name;
+    }
+
+    std::uint64_t Profiler::now()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - registry().epoch;
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    void Profiler::record(const char* name, std::uint64_t start_ns, std::uint64_t end_ns, std::uint32_t depth)
+    {
+        if (!isEnabled()) return;
+        auto& buffer = threadBuffer();
+        buffer.events[buffer.head] = ProfileEvent{name, start_ns, end_ns - start_ns, depth};
+        buffer.head = (buffer.head + 1) % RING_CAPACITY;
+        if (buffer.count < RING_CAPACITY) ++buffer.count;
+    }
+
+    std::uint32_t& Profiler::currentDepth()
+    {
+        return threadBuffer().depth;
+    }
+
+    bool Profiler::writeChromeTrace(const std::string& file_path)
+    {
+        std::ofstream out(file_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            spdlog::error("Profiler: 无法写入 trace 文件 '{}'", file_path);
+            return false;
+        }
+
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        size_t event_count = 0;
+        bool first = true;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (const auto& buffer : reg.buffers)
+        {
+            // 线程名元数据
+            if (!first) out << ",\n";
+            first = false;
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->thread_name.c_str());
+            out << "}}";
+
+            // 环形缓冲区中最旧的记录在 head（写满时）或 0（未写满时）
+            const size_t oldest = buffer->count == RING_CAPACITY ? buffer->head : 0;
+            for (size_t i = 0; i < buffer->count; ++i)
+            {
+                const auto& event = buffer->events[(oldest + i) % RING_CAPACITY];
+                out << ",\n{\"name\":";
+                writeJsonString(out, event.name);
+                // Chrome trace 的时间单位是微秒，保留三位小数以保持纳秒精度
+                out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id
+                    << ",\"ts\":" << event.start_ns / 1000 << '.' << std::to_string(1000 + event.start_ns % 1000).substr(1)
+                    << ",\"dur\":" << event.duration_ns / 1000 << '.' << std::to_string(1000 + event.duration_ns % 1000).substr(1)
+                    << ",\"args\":{\"depth\":" << event.depth << "}}";
+            }
+            event_count += buffer->count;
+        }
+        out << "\n]}\n";
+
+        if (!out.good())
+        {
+            spdlog::error("Profiler: 写入 trace 文件 '{}' 失败", file_path);
+            return false;
+        }
+        spdlog::info("Profiler: 已导出 {} 条记录到 '{}'", event_count, file_path);
+        return true;
+    }
+
+    void Profiler::clear()
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        for (auto& buffer : reg.buffers)
+        {
+            buffer->head = 0;
+            buffer->count = 0;
+        }
+    }
+}
+
+#endif
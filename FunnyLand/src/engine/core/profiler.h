@@ -0,0 +1,115 @@
+﻿#pragma once
+
+/**
+ * 帧性能分析器（作用域计时 + Chrome trace 导出）。
+ *
+ * 开关：FUNNYLAND_PROFILE。未定义时 Debug 构建(未定义 NDEBUG)默认开启、Release 默认关闭；
+ * 关闭时下面的宏全部展开为空，分析器代码不会编入程序。
+ * 需要在发布版本中采集数据时，在工程的预处理器定义里加上 FUNNYLAND_PROFILE=1 即可。
+ *
+ * 用法：
+ *   ENGINE_PROFILE_SCOPE("Scene::update");  // 记录到当前作用域结束
+ *   ENGINE_PROFILE_FUNCTION();              // 以函数名(__FUNCTION__)作为区段名
+ *   ENGINE_PROFILE_DETAIL_SCOPE("GameObject::update");  // 逐对象的细粒度区段，见下
+ *
+ * 逐对象区段（每个 GameObject 一条）在上万个对象时几帧就会写满环形缓冲区、覆盖掉整帧的数据，
+ * 因此默认不记录，需要时另外定义 FUNNYLAND_PROFILE_DETAIL=1；平时请以场景/组件类型为粒度分析。
+ * 导出的 JSON 可直接拖进 chrome://tracing 或 https://ui.perfetto.dev 查看。
+ */
+#ifndef FUNNYLAND_PROFILE
+    #ifdef NDEBUG
+        #define FUNNYLAND_PROFILE 0
+    #else
+        #define FUNNYLAND_PROFILE 1
+    #endif
+#endif
+
+#if FUNNYLAND_PROFILE
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace engine::core
+{
+    /// @brief 一条计时记录（时间单位：纳秒，起点为分析器的时间基准）
+    struct ProfileEvent
+    {
+        const char* name = nullptr;     ///< @brief 区段名，必须是静态存储期的字符串（通常是字面量）
+        std::uint64_t start_ns = 0;     ///< @brief 开始时间
+        std::uint64_t duration_ns = 0;  ///< @brief 持续时间
+        std::uint32_t depth = 0;        ///< @brief 嵌套深度
+    };
+
+    /**
+     * @brief 全局帧性能分析器。
+     *
+     * 每个线程第一次记录时创建自己的环形缓冲区（写入无锁），缓冲区写满后覆盖最旧的记录，
+     * 因此长时间运行也只保留最近一段时间的数据。导出时请确保其他线程没有在记录。
+     */
+    class Profiler final
+    {
+    public:
+        static constexpr size_t RING_CAPACITY = 1u << 18;   ///< @brief 每个线程保留的记录数（每条 32 字节，约 8MB）
+
+        Profiler() = delete;
+
+        static void setEnabled(bool enabled);                ///< @brief 运行时暂停/恢复记录（编译期开关之外的运行时开关）
+        static bool isEnabled();
+        static void setThreadName(const std::string& name);  ///< @brief 设置当前线程在 trace 中显示的名字
+
+        static std::uint64_t now();                          ///< @brief 当前时间（纳秒，相对时间基准）
+        static void record(const char* name, std::uint64_t start_ns, std::uint64_t end_ns, std::uint32_t depth);
+        static std::uint32_t& currentDepth();                ///< @brief 当前线程的嵌套深度
+
+        /**
+         * @brief 把所有线程缓冲区中的记录写成 Chrome trace-event JSON。
+         * @return 成功返回 true
+         */
+        static bool writeChromeTrace(const std::string& file_path);
+        static void clear();                                 ///< @brief 清空所有线程的记录
+    };
+
+    /**
+     * @brief RAII 计时区段，构造时开始、析构时写入当前线程的环形缓冲区。
+     */
+    class ProfileScope final
+    {
+    private:
+        const char* name_;
+        std::uint64_t start_ns_;
+        std::uint32_t depth_;
+
+    public:
+        explicit ProfileScope(const char* name)
+            : name_(name), start_ns_(Profiler::now()), depth_(Profiler::currentDepth()++) {}
+        ~ProfileScope()
+        {
+            --Profiler::currentDepth();
+            Profiler::record(name_, start_ns_, Profiler::now(), depth_);
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope(ProfileScope&&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+        ProfileScope& operator=(ProfileScope&&) = delete;
+    };
+}
+
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+#define ENGINE_PROFILE_SCOPE(name) ::engine::core::ProfileScope ENGINE_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_SCOPE(__FUNCTION__)
+
+#else
+
+#define ENGINE_PROFILE_SCOPE(name) ((void)0)
+#define ENGINE_PROFILE_FUNCTION() ((void)0)
+
+#endif
+
+#if FUNNYLAND_PROFILE && defined(FUNNYLAND_PROFILE_DETAIL) && FUNNYLAND_PROFILE_DETAIL
+#define ENGINE_PROFILE_DETAIL_SCOPE(name) ENGINE_PROFILE_SCOPE(name)
+#else
+#define ENGINE_PROFILE_DETAIL_SCOPE(name) ((void)0)
+#endif
@@ -1,9 +1,18 @@
 ﻿#include "time.h"
 #include <spdlog/spdlog.h>
-#include <SDL3/SDL_timer.h>  
+#include <SDL3/SDL_timer.h>
+#include <SDL3/SDL_atomic.h>
+#include <algorithm>
+#include <cmath>
 
 namespace engine::core
 {
+
+namespace
+{
+    constexpr Uint64 MIN_SPIN_THRESHOLD_NS = 200000;   // 0.2 ms
+    constexpr Uint64 MAX_SPIN_THRESHOLD_NS = 4000000;  // 4 ms
+}
     
 Time::Time()
 {
@@ -15,14 +24,13 @@ Time::Time()
 
 void Time::update()
 {
-    frame_start_time_ = SDL_GetTicksNS();//当前帧的开始时间
-    auto current_delta_time = static_cast<double>(frame_start_time_ - last_time_) / 1000000000.0;
-    if (target_frame_time_ > 0.0)//如果设置了目标帧率 则限制帧率，否则直接使用当前帧时间
-        limitFrameRate(current_delta_time);
-    else
-        delta_time_ = current_delta_time;
+    //如果设置了目标帧率，先等到本帧的截止时间，再把该时刻作为帧开始
+    if (target_frame_ns_ > 0) limitFrameRate();
     
-    last_time_ = SDL_GetTicksNS();//可以理解为上一帧的结束时间
+    frame_start_time_ = SDL_GetTicksNS();//当前帧的开始时间
+    delta_time_ = static_cast<double>(frame_start_time_ - last_time_) / 1000000000.0;
+    last_time_ = frame_start_time_;//下一帧从这里开始计时，上一帧的工作时间已包含在 delta 中
+    recordFrameTime(delta_time_);
 }
 
 float Time::getDeltaTime() const
@@ -48,11 +56,14 @@ void Time::setTargetFPS(int fps)
     if (target_fps_>0)
     {
         target_frame_time_ = 1.0 / static_cast<double>(target_fps_);
+        target_frame_ns_ = static_cast<Uint64>(target_frame_time_ * 1000000000.0);
         spdlog::info("TargetFPS: {} (frametime: {:.6f}s)", target_fps_, target_frame_time_);
     }else{
         target_frame_time_ = 0.0;
+        target_frame_ns_ = 0;
         spdlog::info("不限帧率");
     }
+    next_deadline_ = 0;//帧率变化后重新排程
 }
 
 int Time::getTargetFPS() const
@@ -75,16 +86,80 @@ void Time::setTimeScale(double scale)
     time_scale_ = scale;
 }
 
-void Time::limitFrameRate(double current_delta_time)
+FrameTimeStats Time::getFrameTimeStats() const
 {
-    //当前帧耗费时间小于目标帧时间 则等待剩余时间
-    if (current_delta_time < target_frame_time_)
+    FrameTimeStats stats;
+    stats.missed_deadlines = missed_deadlines_;
+    stats.sample_count = sample_count_;
+    if (sample_count_ == 0) return stats;
+    
+    double sum = 0.0;
+    stats.min = frame_time_samples_[0];
+    stats.max = frame_time_samples_[0];
+    for (std::size_t i = 0; i < sample_count_; ++i)
     {
-        double time_to_wait = target_frame_time_ - current_delta_time;
-        Uint64 ns_to_wait = static_cast<Uint64>(time_to_wait * 1000000000.0);
-        SDL_DelayNS(ns_to_wait);
-        delta_time_ = static_cast<double>(SDL_GetTicksNS() - last_time_) / 1000000000.0;
+        const double sample = frame_time_samples_[i];
+        sum += sample;
+        stats.min = std::min(stats.min, sample);
+        stats.max = std::max(stats.max, sample);
     }
+    stats.mean = sum / static_cast<double>(sample_count_);
     
+    double variance = 0.0;
+    for (std::size_t i = 0; i < sample_count_; ++i)
+    {
+        const double diff = frame_time_samples_[i] - stats.mean;
+        variance += diff * diff;
+    }
+    stats.std_dev = std::sqrt(variance / static_cast<double>(sample_count_));
+    return stats;
+}
+
+void Time::limitFrameRate()
+{
+    Uint64 now = SDL_GetTicksNS();
+    if (next_deadline_ == 0) next_deadline_ = last_time_ + target_frame_ns_;
+    
+    if (now >= next_deadline_)
+    {
+        //已经超时：不补帧，从当前时刻重新排程，避免之后连续多帧不等待
+        ++missed_deadlines_;
+        next_deadline_ = now + target_frame_ns_;
+        return;
+    }
+    
+    //1. 粗睡眠：系统睡眠精度有限，只睡到距截止时间还剩 spin_threshold_ns_ 为止
+    const Uint64 remaining = next_deadline_ - now;
+    if (remaining > spin_threshold_ns_)
+    {
+        const Uint64 requested = remaining - spin_threshold_ns_;
+        SDL_DelayNS(requested);
+        const Uint64 after_sleep = SDL_GetTicksNS();
+        
+        //根据实测睡眠误差调整阈值：误差变大时快速跟上，变小时缓慢回落
+        const Uint64 overshoot = (after_sleep - now > requested) ? (after_sleep - now - requested) : 0;
+        const Uint64 wanted = overshoot + overshoot / 2;
+        spin_threshold_ns_ = wanted > spin_threshold_ns_ ? wanted : (spin_threshold_ns_ * 15 + wanted) / 16;
+        spin_threshold_ns_ = std::clamp(spin_threshold_ns_, MIN_SPIN_THRESHOLD_NS, MAX_SPIN_THRESHOLD_NS);
+        now = after_sleep;
+    }
+    
+    //2. 自旋等待剩余的亚毫秒时间
+    while (now < next_deadline_)
+    {
+        SDL_CPUPauseInstruction();
+        now = SDL_GetTicksNS();
+    }
+    
+    //按绝对时间排程下一帧：本帧睡过头的部分会从下一帧的等待中扣除，不会累积漂移
+    next_deadline_ += target_frame_ns_;
+    if (next_deadline_ <= now) next_deadline_ = now + target_frame_ns_;
+}
+
+void Time::recordFrameTime(double frame_time)
+{
+    frame_time_samples_[sample_cursor_] = frame_time;
+    sample_cursor_ = (sample_cursor_ + 1) % STATS_WINDOW;
+    if (sample_count_ < STATS_WINDOW) ++sample_count_;
+}
 }
-}
\ No newline at end of file
@@ -1,18 +1,36 @@
 ﻿#pragma once
 #include <SDL3/SDL_stdinc.h>
+#include <array>
+#include <cstddef>
 
 
 namespace engine::core
 {
+
+/// @brief 最近若干帧的帧时间统计（秒），由 Time::getFrameTimeStats() 计算
+struct FrameTimeStats
+{
+    std::size_t sample_count = 0;   ///< @brief 参与统计的帧数
+    double mean = 0.0;              ///< @brief 平均帧时间
+    double std_dev = 0.0;           ///< @brief 标准差（帧时间抖动）
+    double min = 0.0;               ///< @brief 最短帧时间
+    double max = 0.0;               ///< @brief 最长帧时间
+    Uint64 missed_deadlines = 0;    ///< @brief 自启动以来错过目标帧截止时间的帧数（仅限帧时有效）
+};
     
 /**
  * @brief 管理游戏循环中的时间，计算帧间时间差 (DeltaTime)。
  *
  * 使用 SDL 的高精度性能计数器来确保时间测量的准确性。
  * 提供获取缩放和未缩放 DeltaTime 的方法，以及设置时间缩放因子的能力。
+ *
+ * 限帧时按绝对截止时间排程：先用系统睡眠等待大部分时间，最后不足
+ * spin 阈值的部分自旋等待，截止时间每帧累加一个目标帧时间，单帧的睡眠误差不会累积。
  */
 class Time final
 {
+public:
+    static constexpr std::size_t STATS_WINDOW = 240;   ///< @brief 帧时间统计窗口（帧数）
     
 private:
     Uint64 last_time_ = 0; // 上一帧的时间戳
@@ -23,6 +41,15 @@ private:
     //帧率限制相关
     int target_fps_ = 0; // 目标帧率(0表示不限制)
     double target_frame_time_ = 0.0; // 目标帧时间(秒)
+    Uint64 target_frame_ns_ = 0; // 目标帧时间(纳秒)
+    Uint64 next_deadline_ = 0; // 下一帧的绝对截止时间(0表示尚未排程)
+    Uint64 spin_threshold_ns_ = 1000000; // 距截止时间小于该值时改为自旋等待，随实测睡眠误差自适应
+    
+    //帧时间统计（环形缓冲）
+    std::array<double, STATS_WINDOW> frame_time_samples_{};
+    std::size_t sample_cursor_ = 0;
+    std::size_t sample_count_ = 0;
+    Uint64 missed_deadlines_ = 0;
     
 public:
     Time();
@@ -70,11 +97,19 @@ public:
     */
     void setTimeScale(double scale); // 设置时间缩放因子
     
+    /**
+    * @brief 计算最近 STATS_WINDOW 帧（未缩放）帧时间的统计信息。
+    * @return 帧时间统计
+    */
+    FrameTimeStats getFrameTimeStats() const;
 
     
 private:
     
-    // 限制帧率
-    void limitFrameRate(double current_delta_time);
+    // 限制帧率：等待到 next_deadline_ 并排程下一帧
+    void limitFrameRate();
+    
+    // 记录一帧的帧时间
+    void recordFrameTime(double frame_time);
 };
 }
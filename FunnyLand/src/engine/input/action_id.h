@@ -0,0 +1,15 @@
+﻿#pragma once
+#include <cstdint>
+
+namespace engine::input
+{
+    /**
+     * @brief 动作ID：InputManager 加载按键映射时为每个动作名称分配的小整数。
+     *
+     * 同一次运行中动作名称与ID一一对应，游戏代码在 init() 时用 InputManager::getActionId() 查好并缓存，
+     * 之后每帧直接用ID索引动作状态数组，不再对动作名称做哈希查找。
+     */
+    using ActionId = std::uint16_t;
+    
+    inline constexpr ActionId INVALID_ACTION_ID = 0xFFFF;   ///< @brief 无效ID（未注册的动作名称）
+}
@@ -1,5 +1,7 @@
 ﻿#include "input_manager.h"
 
+#include <algorithm>
+#include <bit>
 #include <spdlog/spdlog.h>
 
 #include "../core/config.h"
@@ -27,7 +29,7 @@ namespace engine::input
     void InputManager::update()
     {
         //根据上一帧的值更新默认的动作状态
-        for (auto& [action_name,state] : action_states_)
+        for (auto& state : action_states_)
         {
             if (state == ActionState::PRESSED_THIS_FRAME)
                 state = ActionState::HELD_DOWN;//当某个按键一直是按下状态时就不生成SDL_Event
@@ -44,31 +46,19 @@ namespace engine::input
         }
     }
 
-    bool InputManager::isActionDown(const std::string& action_name) const
+    ActionId InputManager::getActionId(const std::string& action_name) const
     {
-        if (auto it = action_states_.find(action_name); it != action_states_.end())
+        if (auto it = action_ids_.find(action_name); it != action_ids_.end())
         {
-            return it->second == ActionState::PRESSED_THIS_FRAME || it->second == ActionState::HELD_DOWN;
+            return it->second;
         }
-        return false;
+        return INVALID_ACTION_ID;
     }
 
-    bool InputManager::isActionPressed(const std::string& action_name) const
+    const std::string& InputManager::getActionName(ActionId action_id) const
     {
-        if (auto it = action_states_.find(action_name); it != action_states_.end())
-        {
-            return it->second == ActionState::PRESSED_THIS_FRAME;
-        }
-        return false;
-    }
-
-    bool InputManager::isActionReleased(const std::string& action_name) const
-    {
-        if (auto it = action_states_.find(action_name); it != action_states_.end())
-        {
-            return it->second == ActionState::RELEASED_THIS_FRAME;
-        }
-        return false;
+        static const std::string empty;
+        return action_id < action_names_.size() ? action_names_[action_id] : empty;
     }
 
     bool InputManager::shouldQuit() const
@@ -105,14 +95,9 @@ namespace engine::input
                 bool is_down = event.key.down;
                 bool is_repeat = event.key.repeat;
                 
-                auto it = input_to_actions_map_.find(scancode);
-                if (it != input_to_actions_map_.end())//如果按键中有对应的action
+                if (static_cast<size_t>(scancode) < scancode_actions_.size())
                 {
-                    const std::vector<std::string>& associate_actions = it->second;
-                    for (const auto& action_name : associate_actions)
-                    {
-                        updateActionStates(action_name, is_down, is_repeat);
-                    }
+                    updateActionStates(scancode_actions_[scancode], is_down, is_repeat);
                 }
                 break;
             }
@@ -121,15 +106,10 @@ namespace engine::input
             {
                 Uint32 button = event.button.button; //获取鼠标按钮索引
                 bool is_down = event.button.down;
-                auto it = input_to_actions_map_.find(button);
-                if (it != input_to_actions_map_.end())//如果鼠标按钮中有对应的action
+                if (button < mouse_button_actions_.size())
                 {
-                    const std::vector<std::string>& associate_actions = it->second;
-                    for (const auto& action_name : associate_actions)
-                    {
-                        //鼠标不考虑重复点击
-                        updateActionStates(action_name, is_down, false);//action状态
-                    }
+                    //鼠标不考虑重复点击
+                    updateActionStates(mouse_button_actions_[button], is_down, false);
                 }
                 //点击时更新鼠标位置
                 mouse_position_ = {event.button.x,event.button.y};
@@ -159,8 +139,11 @@ namespace engine::input
         }
         
         actions_to_keyname_map_ = config->input_mappings_; // 获取配置中的输入映射（动作 -> 按键名称）
-        input_to_actions_map_.clear();
+        action_ids_.clear();
+        action_names_.clear();
         action_states_.clear();
+        scancode_actions_.fill(0);
+        mouse_button_actions_.fill(0);
         
         // 如果配置中没有定义鼠标按钮动作(通常不需要配置)，则默认映射为鼠标按钮索引 用于UI
         if (actions_to_keyname_map_.find("MouseLeftClick") == actions_to_keyname_map_.end())
@@ -174,15 +157,31 @@ namespace engine::input
             actions_to_keyname_map_["MouseRightClick"] = {"MouseRight"};//缺失就补充
         }
         
-        //遍历 动作-> 按键名称的映射
+        //按名称排序后分配ID，同一份配置每次运行得到相同的ID
         for (const auto& [action_name, key_names] : actions_to_keyname_map_)
         {
-            //每个动作对应一个动作状态,初始化为INACTIVE
-            action_states_[action_name] = ActionState::INACTIVE;
-            spdlog::trace("动作映射：{}",action_name);
+            action_names_.push_back(action_name);
+        }
+        std::sort(action_names_.begin(), action_names_.end());
+        if (action_names_.size() > MAX_ACTIONS)
+        {
+            spdlog::warn("输入映射警告: 动作数量 {} 超过上限 {}，多出的动作被忽略.", action_names_.size(), MAX_ACTIONS);
+            action_names_.resize(MAX_ACTIONS);
+        }
+        //每个动作对应一个动作状态,初始化为INACTIVE
+        action_states_.assign(action_names_.size(), ActionState::INACTIVE);
+        
+        //遍历 动作-> 按键名称的映射
+        for (size_t i = 0; i < action_names_.size(); ++i)
+        {
+            const std::string& action_name = action_names_[i];
+            const ActionId action_id = static_cast<ActionId>(i);
+            const ActionMask action_bit = ActionMask{1} << i;
+            action_ids_.emplace(action_name, action_id);
+            spdlog::trace("动作映射：{} (ID: {})",action_name, action_id);
             
             //设置按键->动作的映射
-            for (const auto& key_name : key_names)
+            for (const auto& key_name : actions_to_keyname_map_.at(action_name))
             {
                 SDL_Scancode scancode = scancodeFromString(key_name);//根据名称获取SDL_Scancode
                 Uint32 mouse_button    = mouseButtonUint32FromString(key_name);//根据名称获取鼠标按钮索引
@@ -191,12 +190,12 @@ namespace engine::input
                 
                 if (scancode!=SDL_SCANCODE_UNKNOWN)//如果有效就添加
                 {
-                    input_to_actions_map_[scancode].push_back(action_name);
+                    scancode_actions_[scancode] |= action_bit;
                     spdlog::trace("  映射按键: {} (Scancode: {}) 到动作: {}", key_name, static_cast<int>(scancode), action_name);
                 }
                 else if (mouse_button!=0)//如果鼠标按钮索引有效就添加
                 {
-                    input_to_actions_map_[mouse_button].push_back(action_name);
+                    mouse_button_actions_[mouse_button] |= action_bit;
                     spdlog::trace("  映射鼠标按键: {} (MouseButton: {}) 到动作: {}", key_name, static_cast<int>(mouse_button), action_name);
                 }
                 else
@@ -208,29 +207,29 @@ namespace engine::input
         spdlog::trace("输入映射初始化完成.");
     }
 
-    void InputManager::updateActionStates(const std::string& action_name, bool is_input_active, bool is_repeat_event)
+    void InputManager::updateActionStates(ActionMask actions, bool is_input_active, bool is_repeat_event)
     {
-        auto it = action_states_.find(action_name);
-        if (it == action_states_.end())
-        {
-            spdlog::warn("尝试更新未注册的动作状态: {}", action_name);
-            return;
-        }
-        if (is_input_active)
+        //逐个取出最低位的动作
+        while (actions != 0)
         {
-            if (is_repeat_event)
+            ActionState& state = action_states_[std::countr_zero(actions)];
+            actions &= actions - 1;
+            if (is_input_active)
             {
-                it->second = ActionState::HELD_DOWN;
+                if (is_repeat_event)
+                {
+                    state = ActionState::HELD_DOWN;
+                }
+                else
+                {
+                    state = ActionState::PRESSED_THIS_FRAME;
+                }
             }
             else
             {
-                it->second = ActionState::PRESSED_THIS_FRAME;
+                state = ActionState::RELEASED_THIS_FRAME;
             }
         }
-        else
-        {
-            it->second = ActionState::RELEASED_THIS_FRAME;
-        }
     }
 
     SDL_Scancode InputManager::scancodeFromString(const std::string& key_name)
@@ -1,10 +1,13 @@
 ﻿#pragma once
+#include <array>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
-#include <variant>
 #include <SDL3/SDL_render.h>
+#include <SDL3/SDL_scancode.h>
 #include <glm/vec2.hpp>
+#include "action_id.h"
 
 namespace engine::core {
     class Config;
@@ -25,19 +28,29 @@ namespace engine::input
      * 
      * 该类管理输入事件，将按键转换为动作状态，并提供查询动作状态的功能。
      * 它还处理鼠标位置的逻辑坐标转换。
+     *
+     * 加载映射时每个动作分配一个 ActionId（按名称排序，最多 MAX_ACTIONS 个），状态按ID存放在连续数组中；
+     * 每个 scancode / 鼠标按钮对应一个动作位集，处理事件时直接索引，不做字符串哈希。
+     * 每帧调用的代码应在初始化时用 getActionId() 查好ID并缓存，按名称查询的重载每次都要查找一次。
      */
     class InputManager final
     {
+    public:
+        using ActionMask = std::uint64_t;                       ///< @brief 动作位集（第 i 位对应 ActionId i）
+        static constexpr size_t MAX_ACTIONS = 64;               ///< @brief 动作数量上限（ActionMask 的位数）
+        static constexpr size_t MOUSE_BUTTON_COUNT = 8;         ///< @brief 鼠标按钮表大小（SDL_BUTTON_LEFT=1 ... SDL_BUTTON_X2=5）
     
     private:
         SDL_Renderer* sdl_renderer_;    //用于获取逻辑坐标
         
         std::unordered_map<std::string,std::vector<std::string>> actions_to_keyname_map_; ///< @brief 存储动作名称到按键名称列表的映射
-        std::unordered_map<std::variant<SDL_Scancode,Uint32>, std::vector<std::string>> input_to_actions_map_;   ///< @brief 从输入（SDL_Scancode 或 Uint32）到关联的动作名称列表
-        
-        std::unordered_map<std::string,ActionState> action_states_; ///< @brief 存储每个动作的当前状态
+        std::unordered_map<std::string,ActionId> action_ids_;     ///< @brief 动作名称 -> ID（只在 getActionId() 时查找）
+        std::vector<std::string> action_names_;                   ///< @brief ID -> 动作名称
+        std::vector<ActionState> action_states_;                  ///< @brief 按ID存放的动作状态
+        std::array<ActionMask, SDL_SCANCODE_COUNT> scancode_actions_{};     ///< @brief scancode -> 关联的动作位集
+        std::array<ActionMask, MOUSE_BUTTON_COUNT> mouse_button_actions_{}; ///< @brief 鼠标按钮 -> 关联的动作位集
         
-        bool should_quit_;//是否退出标记
+        bool should_quit_ = false;//是否退出标记
         glm::vec2 mouse_position_; ///< @brief 鼠标当前位置（屏幕坐标）
         
     public:
@@ -51,11 +64,28 @@ namespace engine::input
 
         void update();                                    ///< @brief 更新输入状态，每轮循环最先调用
         
-        //动作状态检查
-        bool isActionDown(const std::string& action_name) const;  ///< @brief 检查指定动作是否当前正在被按下或保持按下
+        //动作ID
+        ActionId getActionId(const std::string& action_name) const;   ///< @brief 查找动作ID，未注册的动作返回 INVALID_ACTION_ID
+        const std::string& getActionName(ActionId action_id) const;   ///< @brief 动作名称（无效ID返回空字符串）
+        size_t getActionCount() const { return action_states_.size(); } ///< @brief 已注册的动作数量
+        
+        //动作状态检查（无效ID视为未按下）
+        ActionState getActionState(ActionId action_id) const
+        {
+            return action_id < action_states_.size() ? action_states_[action_id] : ActionState::INACTIVE;
+        }
+        bool isActionDown(ActionId action_id) const        ///< @brief 检查指定动作是否当前正在被按下或保持按下
+        {
+            const ActionState state = getActionState(action_id);
+            return state == ActionState::PRESSED_THIS_FRAME || state == ActionState::HELD_DOWN;
+        }
+        bool isActionPressed(ActionId action_id) const { return getActionState(action_id) == ActionState::PRESSED_THIS_FRAME; }   ///< @brief 检查指定动作是否在当前帧被按下
+        bool isActionReleased(ActionId action_id) const { return getActionState(action_id) == ActionState::RELEASED_THIS_FRAME; } ///< @brief 检查指定动作是否在当前帧被释放
         
-        bool isActionPressed(const std::string& action_name) const; ///< @brief 检查指定动作是否在当前帧被按下
-        bool isActionReleased(const std::string& action_name) const; ///< @brief 检查指定动作是否在当前帧被释放
+        //按名称查询（每次先查找ID）
+        bool isActionDown(const std::string& action_name) const { return isActionDown(getActionId(action_name)); }
+        bool isActionPressed(const std::string& action_name) const { return isActionPressed(getActionId(action_name)); }
+        bool isActionReleased(const std::string& action_name) const { return isActionReleased(getActionId(action_name)); }
         
         bool shouldQuit() const;//查询退出状态
         void setShouldQuit(bool shouldQuit); ///< @brief 设置是否退出标记
@@ -68,7 +98,7 @@ namespace engine::input
         
         void initializeMapping(const engine::core::Config* config);//初始化按键映射表
         
-        void updateActionStates(const std::string& action_name,bool is_input_active,bool is_repeat_event);//辅助更新动作状态
+        void updateActionStates(ActionMask actions,bool is_input_active,bool is_repeat_event);//辅助更新位集中所有动作的状态
         
         SDL_Scancode scancodeFromString(const std::string& key_name);//将按键名称字符串转换为SDL_Scancode
 
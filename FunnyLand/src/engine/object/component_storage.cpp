@@ -0,0 +1,110 @@
+﻿#include "component_storage.h"
+#include "../core/job_system.h"
+#include "../core/profiler.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::object
+{
+    ComponentStorage::~ComponentStorage()
+    {
+        if (size_t count = getComponentCount(); count > 0)
+        {
+            spdlog::error("ComponentStorage 析构时仍有 {} 个组件存活，使用它的 GameObject 应先销毁", count);
+        }
+    }
+
+    namespace
+    {
+        constexpr size_t MIN_BATCH_SIZE = 128;     ///< @brief 并行更新时每个任务至少处理的组件数（太小时调度开销超过收益）
+    }
+    
+    void ComponentStorage::runUpdateJob(void* data, size_t begin, size_t end)
+    {
+        ENGINE_PROFILE_SCOPE("ComponentStorage::updateRange");
+        const auto& job = *static_cast<const UpdateJob*>(data);
+        job.pool->updateRange(begin, end, job.delta_time, *job.context);
+    }
+    
+    void ComponentStorage::updateAll(float delta_time, engine::core::Context& context, engine::core::JobSystem* job_system)
+    {
+        if (!job_system || job_system->getWorkerCount() == 0)
+        {
+            for (auto* pool : pool_order_)
+            {
+                pool->updateAll(delta_time, context);
+            }
+            return;
+        }
+        
+        if (staged_pool_count_ != pool_order_.size()) buildStages();
+        const size_t thread_count = job_system->getWorkerCount() + 1;
+        for (const auto& stage : stages_)
+        {
+            if (stage.main_thread)
+            {
+                for (auto* pool : stage.pools) pool->updateAll(delta_time, context);
+                continue;
+            }
+            
+            //先填好本阶段所有池的参数（任务持有指向 update_jobs_ 元素的指针，提交后不能再扩容）
+            update_jobs_.clear();
+            for (auto* pool : stage.pools) update_jobs_.push_back({pool, delta_time, &context});
+            
+            engine::core::JobCounter counter;
+            for (auto& update_job : update_jobs_)
+            {
+                //每个池切成大约 线程数*4 段，让先做完的线程还能窃取到工作
+                const size_t count = update_job.pool->getActiveCount();
+                const size_t batch_size = std::max(MIN_BATCH_SIZE, (count + thread_count * 4 - 1) / (thread_count * 4));
+                for (size_t begin = 0; begin < count; begin += batch_size)
+                {
+                    job_system->schedule({&ComponentStorage::runUpdateJob, &update_job, begin, std::min(begin + batch_size, count), &counter});
+                }
+            }
+            job_system->wait(counter);
+        }
+    }
+    
+    size_t ComponentStorage::getStageCount()
+    {
+        if (staged_pool_count_ != pool_order_.size()) buildStages();
+        return stages_.size();
+    }
+    
+    void ComponentStorage::buildStages()
+    {
+        stages_.clear();
+        for (auto* pool : pool_order_)
+        {
+            const auto& access = pool->getAccess();
+            bool start_new_stage = stages_.empty() || access.main_thread || stages_.back().main_thread;
+            if (!start_new_stage)
+            {
+                //只与最后一个阶段比较：更早的阶段已在它之前执行完，冲突的类型仍保持创建顺序
+                for (const auto* staged_pool : stages_.back().pools)
+                {
+                    if (access.conflictsWith(staged_pool->getAccess()))
+                    {
+                        start_new_stage = true;
+                        break;
+                    }
+                }
+            }
+            if (start_new_stage) stages_.push_back({{}, access.main_thread});
+            stages_.back().pools.push_back(pool);
+        }
+        staged_pool_count_ = pool_order_.size();
+        update_jobs_.reserve(pool_order_.size());
+        spdlog::debug("ComponentStorage: {} 个组件池分为 {} 个更新阶段", pool_order_.size(), stages_.size());
+    }
+
+    size_t ComponentStorage::getComponentCount() const
+    {
+        size_t count = 0;
+        for (const auto* pool : pool_order_)
+        {
+            count += pool->size();
+        }
+        return count;
+    }
+}
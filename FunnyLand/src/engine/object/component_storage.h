@@ -0,0 +1,264 @@
+﻿#pragma once
+#include "../component/component.h"
+#include "../component/component_access.h"
+#include "../component/component_type_id.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace engine::core
+{
+    class Context;
+    class JobSystem;
+}
+
+namespace engine::object
+{
+    /**
+     * @brief 组件池的类型擦除基类，ComponentStorage 通过它统一更新和回收不同类型的组件。
+     */
+    class ComponentPoolBase
+    {
+    private:
+        engine::component::ComponentAccess access_;     ///< @brief 组件类型的访问声明
+        
+    public:
+        explicit ComponentPoolBase(const engine::component::ComponentAccess& access) : access_(access) {}
+        virtual ~ComponentPoolBase() = default;
+        
+        ComponentPoolBase(const ComponentPoolBase&) = delete;
+        ComponentPoolBase& operator=(const ComponentPoolBase&) = delete;
+        ComponentPoolBase(ComponentPoolBase&&) = delete;
+        ComponentPoolBase& operator=(ComponentPoolBase&&) = delete;
+        
+        virtual void destroy(engine::component::Component* component) = 0;                  ///< @brief 析构组件并回收槽位
+        virtual void updateAll(float delta_time, engine::core::Context& context) = 0;        ///< @brief 线性更新池中所有启用的组件
+        virtual void setActive(engine::component::Component* component, bool active) = 0;   ///< @brief 启用/停用组件（停用的组件不参与 updateAll）
+        /// @brief 更新启用段中 [begin, end) 的组件（并行更新时每个任务处理一段）
+        virtual void updateRange(size_t begin, size_t end, float delta_time, engine::core::Context& context) = 0;
+        virtual size_t getActiveCount() const = 0;                                           ///< @brief 启用的组件数量
+        virtual size_t size() const = 0;                                                     ///< @brief 存活组件数量
+        virtual size_t capacity() const = 0;                                                 ///< @brief 已分配的槽位数量
+        const engine::component::ComponentAccess& getAccess() const { return access_; }
+    };
+    
+    /**
+     * @brief GameObject 持有组件时使用的删除器：来自组件池的归还给池，否则直接 delete。
+     */
+    struct ComponentDeleter
+    {
+        ComponentPoolBase* pool = nullptr;   ///< @brief 组件所属的池，nullptr 表示普通堆分配
+        
+        void operator()(engine::component::Component* component) const
+        {
+            if (!component) return;
+            if (pool) pool->destroy(component);
+            else delete component;
+        }
+    };
+    
+    using ComponentPtr = std::unique_ptr<engine::component::Component, ComponentDeleter>;
+    
+    /**
+     * @brief 单一组件类型的连续存储池（稀疏集合）。
+     *
+     * 组件放在固定大小的内存块中（地址稳定，组件禁止移动），
+     * dense_ 保存所有存活组件的指针，删除时与末尾交换后弹出，更新时线性遍历 dense_。
+     * dense_ 分为两段：[0, active_count_) 是启用的组件，之后是停用的组件（所在对象在回收池中），
+     * 启用/停用只是与分界处的元素交换，updateAll 只遍历前一段。
+     */
+    template<typename T>
+    class ComponentPool final : public ComponentPoolBase
+    {
+        static_assert(std::is_base_of_v<engine::component::Component, T>, "T 必须继承自 Component");
+        
+    private:
+        static constexpr size_t BLOCK_SIZE = 256;   ///< @brief 每个内存块的组件数量
+        
+        /// @brief 一个槽位：组件本体放在开头，后面记录它在 dense_ 中的下标
+        struct Slot
+        {
+            alignas(T) std::byte storage[sizeof(T)];
+            std::uint32_t dense_index = 0;
+        };
+        
+        std::vector<std::unique_ptr<Slot[]>> blocks_;   ///< @brief 内存块
+        std::vector<Slot*> free_slots_;                 ///< @brief 空闲槽位（栈）
+        std::vector<T*> dense_;                         ///< @brief 存活组件（紧密排列，启用的在前）
+        size_t active_count_ = 0;                       ///< @brief 启用的组件数量
+        
+    public:
+        ComponentPool() : ComponentPoolBase(engine::component::getComponentAccess<T>()) {}
+        ~ComponentPool() override = default;            // 组件由 GameObject 持有，池必须比它们活得久
+        
+        /**
+         * @brief 在池中构造一个组件。
+         * @return 指向新组件的指针，删除器会把它归还给本池
+         */
+        template<typename... Args>
+        std::unique_ptr<T, ComponentDeleter> create(Args&&... args)
+        {
+            if (free_slots_.empty()) allocateBlock();
+            Slot* slot = free_slots_.back();
+            free_slots_.pop_back();
+            
+            T* component = nullptr;
+            try
+            {
+                component = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                free_slots_.push_back(slot);
+                throw;
+            }
+            slot->dense_index = static_cast<std::uint32_t>(dense_.size());
+            dense_.push_back(component);
+            moveTo(component, active_count_++);    //新组件默认启用
+            return std::unique_ptr<T, ComponentDeleter>(component, ComponentDeleter{this});
+        }
+        
+        void destroy(engine::component::Component* component) override
+        {
+            T* typed = static_cast<T*>(component);
+            Slot* slot = reinterpret_cast<Slot*>(typed);    // storage 是 Slot 的第一个成员
+            
+            //启用的组件先换到启用段末尾并停用，再与整个数组末尾交换后弹出，保持两段都紧密
+            if (slot->dense_index < active_count_) moveTo(typed, --active_count_);
+            moveTo(typed, dense_.size() - 1);
+            dense_.pop_back();
+            
+            typed->~T();
+            free_slots_.push_back(slot);
+        }
+        
+        void updateAll(float delta_time, engine::core::Context& context) override
+        {
+            //按下标遍历：更新过程中删除组件只会让被交换过来的组件本帧跳过一次，不会访问失效内存
+            for (size_t i = 0; i < active_count_; ++i)
+            {
+                static_cast<engine::component::Component*>(dense_[i])->update(delta_time, context);
+            }
+        }
+        
+        void updateRange(size_t begin, size_t end, float delta_time, engine::core::Context& context) override
+        {
+            end = std::min(end, active_count_);
+            for (size_t i = begin; i < end; ++i)
+            {
+                static_cast<engine::component::Component*>(dense_[i])->update(delta_time, context);
+            }
+        }
+        
+        void setActive(engine::component::Component* component, bool active) override
+        {
+            T* typed = static_cast<T*>(component);
+            const std::uint32_t index = reinterpret_cast<Slot*>(typed)->dense_index;
+            if (active && index >= active_count_) moveTo(typed, active_count_++);
+            else if (!active && index < active_count_) moveTo(typed, --active_count_);
+        }
+        
+        size_t size() const override { return dense_.size(); }
+        size_t getActiveCount() const override { return active_count_; }
+        size_t capacity() const override { return blocks_.size() * BLOCK_SIZE; }
+        const std::vector<T*>& getComponents() const { return dense_; }   ///< @brief 获取所有存活组件（顺序不固定）
+        
+    private:
+        /// @brief 把组件与 dense_[index] 交换位置
+        void moveTo(T* component, size_t index)
+        {
+            Slot* slot = reinterpret_cast<Slot*>(component);
+            T* other = dense_[index];
+            dense_[slot->dense_index] = other;
+            reinterpret_cast<Slot*>(other)->dense_index = slot->dense_index;
+            dense_[index] = component;
+            slot->dense_index = static_cast<std::uint32_t>(index);
+        }
+        
+        void allocateBlock()
+        {
+            blocks_.push_back(std::make_unique<Slot[]>(BLOCK_SIZE));
+            Slot* block = blocks_.back().get();
+            //倒序压栈，让低地址的槽位先被使用，遍历时更接近顺序访问
+            for (size_t i = BLOCK_SIZE; i > 0; --i)
+            {
+                free_slots_.push_back(&block[i - 1]);
+            }
+        }
+    };
+    
+    /**
+     * @brief 按组件类型划分的组件池集合（可选的数据导向存储后端）。
+     *
+     * 使用方式：构造 GameObject 时传入 ComponentStorage 指针，之后 addComponent 会从对应类型的池中分配。
+     * Scene 拥有一个 ComponentStorage，并在 update 中按类型逐池线性更新这些组件。
+     * 提供 JobSystem 时按组件类型的访问声明（ComponentAccess）把池分成阶段：
+     * 同一阶段内互不冲突的类型、以及同一类型的不同对象段并行更新，阶段之间按池的创建顺序依次执行。
+     * ComponentStorage 必须比使用它的所有 GameObject 活得久。
+     */
+    class ComponentStorage final
+    {
+    private:
+        /// @brief 一个更新阶段：阶段内的池可以同时更新
+        struct UpdateStage
+        {
+            std::vector<ComponentPoolBase*> pools;
+            bool main_thread = false;                   ///< @brief 未声明访问的类型单独成一个阶段，在主线程串行更新
+        };
+        
+        /// @brief 并行更新任务的参数（每帧重填，容量复用）
+        struct UpdateJob
+        {
+            ComponentPoolBase* pool = nullptr;
+            float delta_time = 0.0f;
+            engine::core::Context* context = nullptr;
+        };
+        
+        std::vector<std::unique_ptr<ComponentPoolBase>> pools_;                           ///< @brief 以组件类型ID为下标的池（空位为 nullptr）
+        std::vector<ComponentPoolBase*> pool_order_;                                       ///< @brief 按创建顺序排列的池（更新顺序固定）
+        std::vector<UpdateStage> stages_;                                                  ///< @brief 更新阶段（有新池时重建）
+        size_t staged_pool_count_ = 0;                                                     ///< @brief 构建 stages_ 时的池数量
+        std::vector<UpdateJob> update_jobs_;                                               ///< @brief 当前阶段各池的任务参数
+        
+    public:
+        ComponentStorage() = default;
+        ~ComponentStorage();
+        
+        ComponentStorage(const ComponentStorage&) = delete;
+        ComponentStorage& operator=(const ComponentStorage&) = delete;
+        ComponentStorage(ComponentStorage&&) = delete;
+        ComponentStorage& operator=(ComponentStorage&&) = delete;
+        
+        /// @brief 获取（必要时创建）类型 T 的组件池
+        template<typename T>
+        ComponentPool<T>& getPool()
+        {
+            const auto type_id = engine::component::getComponentTypeId<T>();
+            if (pools_.size() <= type_id) pools_.resize(type_id + 1);
+            auto& pool = pools_[type_id];
+            if (!pool)
+            {
+                pool = std::make_unique<ComponentPool<T>>();
+                pool_order_.push_back(pool.get());
+            }
+            return static_cast<ComponentPool<T>&>(*pool);
+        }
+        
+        /**
+         * @brief 更新所有启用的组件。
+         * @param job_system 为空或没有工作线程时按池的创建顺序逐类型串行更新，否则按阶段并行更新
+         */
+        void updateAll(float delta_time, engine::core::Context& context, engine::core::JobSystem* job_system = nullptr);
+        size_t getStageCount();                                             ///< @brief 当前的更新阶段数（必要时重建阶段）
+        size_t getComponentCount() const;                                   ///< @brief 所有池中存活组件的总数
+        size_t getPoolCount() const { return pool_order_.size(); }          ///< @brief 池的数量
+        
+    private:
+        void buildStages();     ///< @brief 按池的创建顺序贪心分阶段：与当前阶段冲突或未声明访问的类型开始新阶段
+        static void runUpdateJob(void* data, size_t begin, size_t end);    ///< @brief 任务函数：data 指向 UpdateJob
+    };
+}
@@ -2,12 +2,15 @@
 #include "../render/renderer.h"
 #include "../input/input_manager.h" 
 #include "../render/camera.h"
+#include "../scene/spatial_grid.h"
+#include "../core/profiler.h"
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 namespace engine::object
 {
-    GameObject::GameObject(const std::string& name, const std::string& tag)
-        : name_(name), tag_(tag)
+    GameObject::GameObject(const std::string& name, const std::string& tag, ComponentStorage* component_storage)
+        : name_(name), tag_(tag), component_storage_(component_storage)
     {
         spdlog::trace("GameObject created: {} {}", name_, tag_);
     }
@@ -15,35 +18,103 @@ namespace engine::object
 
     void GameObject::update(float delta_time, engine::core::Context& context)
     {
-        for (auto& pair: components_)
+        ENGINE_PROFILE_DETAIL_SCOPE("GameObject::update");   //逐对象区段默认关闭，见 profiler.h
+        for (auto& component: components_)
         {
-            pair.second->update(delta_time,context);
+            if (component) component->update(delta_time,context);
         }
     }
 
     void GameObject::render( engine::core::Context& context)
     {
-        for (auto& pair: components_)
+        ENGINE_PROFILE_DETAIL_SCOPE("GameObject::render");
+        for (auto& component: components_)
         {
-            pair.second->render(context);
+            if (component) component->render(context);
         }
     }
 
     void GameObject::clean()
     {
         spdlog::trace("Cleaning GameObject...");
-        for (auto& pair: components_)
+        for (auto& component: components_)
         {
-            pair.second->clean();
+            if (component) component->clean();
         }
-        components_.clear(); // 清空 map, unique_ptr 会自动释放内存
+        components_.clear(); // 清空列表, unique_ptr 会自动释放内存（或归还组件池）
+        component_mask_.reset();
+    }
+
+    void GameObject::reset()
+    {
+        for (auto& component: components_)
+        {
+            if (component) component->reset();
+        }
+        need_removed_ = false;
+    }
+
+    void GameObject::setActive(bool active)
+    {
+        if (is_active_ == active) return;
+        const bool was_updating = isUpdating();
+        is_active_ = active;
+        if (isUpdating() != was_updating) setPooledComponentsActive(isUpdating());
+    }
+
+    void GameObject::setInScene(bool in_scene)
+    {
+        if (in_scene_ == in_scene) return;
+        const bool was_updating = isUpdating();
+        in_scene_ = in_scene;
+        if (isUpdating() != was_updating) setPooledComponentsActive(isUpdating());
+    }
+
+    void GameObject::setPooledComponentsActive(bool active)
+    {
+        if (!component_storage_) return;
+        for (auto& component: components_)
+        {
+            if (component && component.get_deleter().pool) component.get_deleter().pool->setActive(component.get(), active);
+        }
+    }
+
+    void GameObject::markBoundsDirty()
+    {
+        //已在脏列表中；exchange 保证同时标记的多个线程中只有一个登记到空间网格
+        if (bounds_dirty_.load(std::memory_order_relaxed) || bounds_dirty_.exchange(true, std::memory_order_acq_rel)) return;
+        if (spatial_grid_)
+        {
+            spatial_grid_->markDirty(this);
+        }
+    }
+
+    std::optional<engine::utils::Rect> GameObject::getRenderBounds() const
+    {
+        std::optional<engine::utils::Rect> result;
+        for (const auto& component: components_)
+        {
+            if (!component) continue;
+            auto bounds = component->getRenderBounds();
+            if (!bounds.has_value()) continue;
+            if (!result.has_value())
+            {
+                result = bounds;
+                continue;
+            }
+            //合并两个矩形
+            glm::vec2 min_pos = glm::min(result->position, bounds->position);
+            glm::vec2 max_pos = glm::max(result->position + result->size, bounds->position + bounds->size);
+            result = engine::utils::Rect{min_pos, max_pos - min_pos};
+        }
+        return result;
     }
 
     void GameObject::handleInput( engine::core::Context& context)
     {
-        for (auto& pair: components_)
+        for (auto& component: components_)
         {
-            pair.second->handleInput(context);
+            if (component) component->handleInput(context);
         }
     }
 }
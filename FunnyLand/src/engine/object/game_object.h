@@ -1,8 +1,12 @@
 ﻿#pragma once
 #include "../component/component.h" 
+#include "../component/component_type_id.h"
+#include "component_storage.h"
+#include <atomic>
+#include <bitset>
 #include <memory>
-#include <unordered_map>
-#include <typeindex>        // 用于类型索引
+#include <optional>
+#include <vector>
 #include <utility>          // 用于完美转发
 #include <spdlog/spdlog.h>
 namespace engine::core
@@ -10,9 +14,16 @@ namespace engine::core
     class Context;
 }
 
+namespace engine::scene
+{
+    class SpatialGrid;
+}
+
 
 namespace engine::object
 {
+    class GameObjectPool;
+    
     /**
    * @brief 游戏对象类，负责管理游戏对象的组件。
    * 
@@ -24,11 +35,23 @@ namespace engine::object
         private:
         std::string name_; ///< @brief 游戏对象的名称
         std::string tag_; ///< @brief 游戏对象的标签
-        std::unordered_map<std::type_index,std::unique_ptr<engine::component::Component>> components_; ///< @brief 组件列表
+        std::vector<ComponentPtr> components_; ///< @brief 组件列表，以组件类型ID为下标，空位为 nullptr（删除器负责归还到组件池或 delete）
+        std::bitset<engine::component::MAX_COMPONENT_TYPES> component_mask_; ///< @brief 已有组件的类型位集，hasComponent 只需测试一位
+        ComponentStorage* component_storage_ = nullptr; ///< @brief 可选的组件池存储（非拥有），为空时组件单独堆分配
         bool need_removed_ = false; ///< @brief 延迟删除的标识,将来由场景类负责删除
+        engine::scene::SpatialGrid* spatial_grid_ = nullptr; ///< @brief 登记本对象的空间网格（非拥有），包围盒变化时通知它
+        std::atomic<bool> bounds_dirty_{false}; ///< @brief 包围盒是否已变化但尚未同步到空间网格（不同类型的组件可能在不同工作线程中同时标记）
+        GameObjectPool* pool_ = nullptr; ///< @brief 创建本对象的回收池（非拥有），场景移除对象时归还给它而不是销毁
+        bool is_active_ = true; ///< @brief 是否启用（在回收池中等待复用时为 false，组件池中的组件不参与批量更新）
+        bool in_scene_ = false; ///< @brief 是否已加入场景（在待添加队列中时为 false，组件池中的组件同样不参与批量更新）
         
         public:
-        GameObject(const std::string& name = "", const std::string& tag = ""); ///< @brief 构造函数，初始化游戏对象的名称和标签
+        /**
+         * @brief 构造函数，初始化游戏对象的名称和标签
+         * @param component_storage 可选：组件池存储。提供时组件从按类型连续排列的池中分配，
+         *        并由 Scene 按类型批量更新（GameObject::update 不再被调用）。存储必须比本对象活得久。
+         */
+        GameObject(const std::string& name = "", const std::string& tag = "", ComponentStorage* component_storage = nullptr);
         
         
         //禁止拷贝和移动，确保唯一性 (通常游戏对象不应随意拷贝)
@@ -44,6 +67,18 @@ namespace engine::object
         const std::string& getTag() const {return tag_;} ///< @brief 获取游戏对象的标签
         void setNeedRemoved(bool need_remove){need_removed_ = need_remove;}
         bool isNeedRemoved() const {return need_removed_;}
+        ComponentStorage* getComponentStorage() const {return component_storage_;} ///< @brief 获取组件池存储（为空表示组件单独堆分配）
+        void setSpatialGrid(engine::scene::SpatialGrid* spatial_grid){spatial_grid_ = spatial_grid;} ///< @brief 由 SpatialGrid 在登记/移除时设置
+        void setBoundsDirty(bool dirty){bounds_dirty_.store(dirty, std::memory_order_relaxed);}
+        bool isBoundsDirty() const {return bounds_dirty_.load(std::memory_order_relaxed);}
+        void setPool(GameObjectPool* pool){pool_ = pool;} ///< @brief 由 GameObjectPool 在创建对象时设置
+        GameObjectPool* getPool() const {return pool_;} ///< @brief 获取回收池（为空表示不回收）
+        bool isActive() const {return is_active_;}
+        void setInScene(bool in_scene);                                             ///< @brief 由 Scene 在对象加入/移出场景时调用
+        bool isInScene() const {return in_scene_;}
+        
+        void markBoundsDirty();                                                     ///< @brief 包围盒发生变化（移动、缩放、换图等），通知空间网格
+        std::optional<engine::utils::Rect> getRenderBounds() const;                 ///< @brief 所有组件渲染包围盒的并集，没有任何组件提供时返回 std::nullopt
         
         /**
      * @brief 添加组件 (里面会完成组件的init())
@@ -59,21 +94,27 @@ namespace engine::object
             // 检测组件是否合法。  /*  static_assert(condition, message)：静态断言，在编译期检测，无任何性能影响 */
             /* std::is_base_of<Base, Derived>::value -- 判断 Base 类型是否是 Derived 类型的基类 */
             static_assert(std::is_base_of_v<engine::component::Component, T>, "T 必须继承自 Component");
-            // 获取类型标识。     /* typeid(T) -- 用于获取一个表达式或类型的运行时类型信息 (RTTI), 返回 std::type_info& */
-            /* std::type_index -- 针对std::type_info对象的包装器，主要设计用来作为关联容器（如 std::map）的键。*/
-            auto type_index = std::type_index(typeid(T));
+            // 获取类型ID（静态计数器分配，不依赖 RTTI），直接作为 components_ 的下标
+            const auto type_id = engine::component::getComponentTypeId<T>();
             //如果组件已经存在，则直接返回组件 （避免重复添加）
             if (hasComponent<T>()) 
             {
                 return getComponent<T>();
             }
             //如果不存在 /* std::forward -- 用于实现完美转发。传递多个参数的时候使用...标识 */
-            auto new_component = std::make_unique<T>(std::forward<Args>(args)...);
+            //有组件池时从对应类型的池中构造，否则单独堆分配
+            std::unique_ptr<T, ComponentDeleter> new_component = component_storage_
+                ? component_storage_->getPool<T>().create(std::forward<Args>(args)...)
+                : std::unique_ptr<T, ComponentDeleter>(new T(std::forward<Args>(args)...));
             T* ptr= new_component.get(); //先获取指针方便返回
+            if (!isUpdating() && new_component.get_deleter().pool) new_component.get_deleter().pool->setActive(ptr, false); //停用或尚未加入场景的对象上添加的组件同样不参与批量更新
             new_component->setOwner(this); //设置组件的所有者
-            components_[type_index] = std::move(new_component); //将组件添加到组件列表
+            if (components_.size() <= type_id) components_.resize(type_id + 1);
+            components_[type_id] = std::move(new_component); //将组件添加到组件列表
+            component_mask_.set(type_id);
             ptr->init(); //初始化组件
-            spdlog::debug("GameObject::addComponent: {} ;added component: {}", name_, typeid(T).name());
+            markBoundsDirty(); //新组件可能改变渲染范围
+            spdlog::debug("GameObject::addComponent: {} ;added component: {}", name_, engine::component::getComponentTypeName<T>());
             return ptr; //返回组件指针
         }
         
@@ -88,14 +129,9 @@ namespace engine::object
         T* getComponent() const
         {
             static_assert(std::is_base_of_v<engine::component::Component, T>, "T 必须继承自 Component");
-            auto type_index = std::type_index(typeid(T));
-            auto it = components_.find(type_index);
-            //返回组件指针
-            if (it != components_.end())
-            {
-                return static_cast<T*>(it->second.get());
-            }
-            return nullptr;
+            const auto type_id = engine::component::getComponentTypeId<T>();
+            //位集命中时 components_ 一定覆盖该下标
+            return component_mask_[type_id] ? static_cast<T*>(components_[type_id].get()) : nullptr;
         }
         
         /**
@@ -108,8 +144,7 @@ namespace engine::object
         bool hasComponent() const
         {
             static_assert(std::is_base_of_v<engine::component::Component, T>, "T 必须继承自 Component");
-            // contains方法为 C++20 新增
-            return components_.contains(std::type_index(typeid(T)));
+            return component_mask_[engine::component::getComponentTypeId<T>()];
         }
         
         /**
@@ -120,11 +155,12 @@ namespace engine::object
         template <typename T>
         void removeComponent() {
             static_assert(std::is_base_of_v<engine::component::Component, T>, "T 必须继承自 Component");
-            auto type_index = std::type_index(typeid(T));
-            auto it = components_.find(type_index);
-            if (it != components_.end()) {
-                it->second->clean();
-                components_.erase(it);
+            const auto type_id = engine::component::getComponentTypeId<T>();
+            if (component_mask_[type_id]) {
+                components_[type_id]->clean();
+                components_[type_id].reset();
+                component_mask_.reset(type_id);
+                markBoundsDirty();
             }
         }
 
@@ -132,6 +168,12 @@ namespace engine::object
         void update(float delta_time, engine::core::Context& context);               ///< @brief 更新所有组件
         void render(engine::core::Context& context);                                ///< @brief 渲染所有组件
         void clean();                                                               ///< @brief 清理所有组件
+        void reset();                                                               ///< @brief 调用所有组件的 reset() 并清除删除标记（归还回收池时调用）
+        void setActive(bool active);                                                ///< @brief 启用/停用对象（同步组件池中组件的启用状态）
         void handleInput(engine::core::Context& context);                           ///< @brief 处理输入
+        
+    private:
+        bool isUpdating() const {return is_active_ && in_scene_;}                   ///< @brief 组件池中的组件是否参与批量更新
+        void setPooledComponentsActive(bool active);                                ///< @brief 同步组件池中所有组件的启用状态
     };
 }
@@ -0,0 +1,81 @@
+#include "game_object_pool.h"
+#include "game_object.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::object
+{
+    GameObjectPool::GameObjectPool(Factory factory)
+        : factory_(std::move(factory))
+    {
+    }
+
+    GameObjectPool::~GameObjectPool()
+    {
+        for (auto& game_object : free_objects_)
+        {
+            game_object->clean();
+        }
+    }
+
+    std::unique_ptr<GameObject> GameObjectPool::acquire()
+    {
+        std::unique_ptr<GameObject> game_object;
+        if (!free_objects_.empty())
+        {
+            game_object = std::move(free_objects_.back());
+            free_objects_.pop_back();
+            --stats_.free;
+            ++stats_.reused;
+        }
+        else
+        {
+            game_object = create();
+            if (!game_object) return nullptr;
+        }
+        game_object->setActive(true);
+        ++stats_.acquired;
+        ++stats_.active;
+        stats_.peak_active = std::max(stats_.peak_active, stats_.active);
+        return game_object;
+    }
+
+    void GameObjectPool::release(std::unique_ptr<GameObject>&& game_object)
+    {
+        if (!game_object) return;
+        if (game_object->getPool() != this)
+        {
+            spdlog::warn("GameObjectPool: 对象 '{}' 不是本池创建的，直接销毁", game_object->getName());
+            game_object->clean();
+            return;
+        }
+        game_object->reset();
+        game_object->setActive(false);
+        free_objects_.push_back(std::move(game_object));
+        if (stats_.active > 0) --stats_.active;
+        ++stats_.free;
+    }
+
+    void GameObjectPool::prewarm(size_t count)
+    {
+        while (free_objects_.size() < count)
+        {
+            auto game_object = create();
+            if (!game_object) return;
+            game_object->setActive(false);
+            free_objects_.push_back(std::move(game_object));
+            ++stats_.free;
+        }
+    }
+
+    std::unique_ptr<GameObject> GameObjectPool::create()
+    {
+        auto game_object = factory_ ? factory_() : nullptr;
+        if (!game_object) return nullptr;
+        game_object->setPool(this);
+        ++stats_.created;
+        //空闲列表的容量跟上创建数，之后归还对象时不会再扩容
+        if (free_objects_.capacity() < stats_.created) free_objects_.reserve(std::max(stats_.created, free_objects_.capacity() * 2));
+        return game_object;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine::object
+{
+    class GameObject;
+
+    /**
+     * @brief 回收同一种游戏对象的对象池。
+     *
+     * acquire() 优先返回之前归还的对象（组件保留，由使用者重置状态），没有时才调用工厂新建。
+     * 池创建的对象记录了池指针，Scene 移除它们时调用 release() 归还而不是销毁：
+     * 归还时调用各组件的 reset() 并停用对象，取出时重新启用，整个过程不分配内存。
+     * 可以用 prewarm() 预先创建对象，让之后的生成完全不分配。
+     * 池必须比它创建的、仍在场景中的对象活得久。
+     */
+    class GameObjectPool final
+    {
+    public:
+        using Factory = std::function<std::unique_ptr<GameObject>()>;   ///< @brief 新建一个完整的对象（含组件）
+
+        /// @brief 池的统计信息
+        struct Stats
+        {
+            size_t created = 0;         ///< @brief 工厂创建过的对象数
+            size_t active = 0;          ///< @brief 当前取出（在场景中）的对象数
+            size_t free = 0;            ///< @brief 空闲对象数
+            size_t peak_active = 0;     ///< @brief 同时取出对象数的最高水位
+            size_t acquired = 0;        ///< @brief acquire() 成功的总次数
+            size_t reused = 0;          ///< @brief 其中复用空闲对象的次数
+        };
+
+    private:
+        Factory factory_;
+        std::vector<std::unique_ptr<GameObject>> free_objects_;         ///< @brief 已归还、等待复用的对象（容量不小于创建数，归还时不扩容）
+        Stats stats_;
+
+    public:
+        explicit GameObjectPool(Factory factory);
+        ~GameObjectPool();
+
+        GameObjectPool(const GameObjectPool&) = delete;
+        GameObjectPool& operator=(const GameObjectPool&) = delete;
+        GameObjectPool(GameObjectPool&&) = delete;
+        GameObjectPool& operator=(GameObjectPool&&) = delete;
+
+        /// @brief 取出一个对象（复用或新建），工厂返回空时返回空
+        std::unique_ptr<GameObject> acquire();
+        /// @brief 归还对象（调用组件的 reset()、清除删除标记并停用后放回空闲列表）
+        void release(std::unique_ptr<GameObject>&& game_object);
+        /// @brief 预先创建对象，直到空闲对象不少于 count 个
+        void prewarm(size_t count);
+
+        size_t getFreeCount() const { return free_objects_.size(); }    ///< @brief 空闲对象数
+        size_t getCreatedCount() const { return stats_.created; }       ///< @brief 工厂创建过的对象数
+        const Stats& getStats() const { return stats_; }                ///< @brief 获取统计信息
+
+    private:
+        std::unique_ptr<GameObject> create();                           ///< @brief 调用工厂新建对象并登记到本池
+    };
+}
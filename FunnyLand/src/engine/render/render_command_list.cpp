@@ -0,0 +1,51 @@
+﻿#include "render_command_list.h"
+#include "../core/memory_tracker.h"
+#include <algorithm>
+
+namespace engine::render
+{
+    void RenderCommandList::addSprite(engine::resource::TextureHandle texture, const SDL_FRect& src_rect, const SDL_FRect& dest_rect,
+                                      float angle, bool is_flipped, bool is_batched, int layer)
+    {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RENDER);    //列表常驻在渲染器中，扩容不计入正在渲染的场景
+        if (!commands_.empty() && layer < commands_.back().layer) is_layer_sorted_ = false;
+        RenderCommand& command = commands_.emplace_back();
+        command.type = RenderCommandType::SPRITE;
+        command.texture = texture;
+        command.layer = layer;
+        command.src_rect = src_rect;
+        command.dest_rect = dest_rect;
+        command.angle = angle;
+        command.is_flipped = is_flipped;
+        command.is_batched = is_batched;
+    }
+
+    void RenderCommandList::addGeometry(engine::resource::TextureHandle texture, const std::vector<SDL_Vertex>& vertices,
+                                        const SDL_Point& origin, int layer)
+    {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RENDER);
+        if (!commands_.empty() && layer < commands_.back().layer) is_layer_sorted_ = false;
+        RenderCommand& command = commands_.emplace_back();
+        command.type = RenderCommandType::GEOMETRY;
+        command.texture = texture;
+        command.layer = layer;
+        command.vertices = vertices.data();
+        command.vertex_count = static_cast<std::uint32_t>(vertices.size());
+        command.origin = origin;
+    }
+
+    void RenderCommandList::clear()
+    {
+        commands_.clear();
+        is_layer_sorted_ = true;
+    }
+
+    void RenderCommandList::sortByLayer()
+    {
+        if (is_layer_sorted_) return;
+        //几何体命令直接引用图层的顶点缓冲，重排命令不影响它们
+        std::stable_sort(commands_.begin(), commands_.end(),
+            [](const RenderCommand& a, const RenderCommand& b) { return a.layer < b.layer; });
+        is_layer_sorted_ = true;
+    }
+}
@@ -0,0 +1,67 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include <SDL3/SDL_render.h>
+#include "../resource/texture_handle.h"
+
+namespace engine::render
+{
+    /// @brief 绘制命令的类型
+    enum class RenderCommandType : std::uint8_t
+    {
+        SPRITE,     ///< @brief 纹理四边形（源矩形 -> 目标矩形，可旋转、翻转）
+        GEOMETRY,   ///< @brief 一组纹理四边形（引用图层烘焙好的顶点，回放时通过视口平移到屏幕）
+    };
+
+    /**
+     * @brief 一条绘制命令。精灵命令是纯数据（纹理句柄和屏幕坐标），记录之后对象移动或销毁都不影响回放；
+     *        几何体命令引用图层烘焙好的顶点缓冲，回放紧接在记录之后（同一帧、场景更新之前），期间图层不会重新烘焙或卸载区块。
+     */
+    struct RenderCommand
+    {
+        RenderCommandType type = RenderCommandType::SPRITE;
+        engine::resource::TextureHandle texture = engine::resource::INVALID_TEXTURE_HANDLE;    ///< @brief 纹理句柄
+        int layer = 0;                  ///< @brief 绘制层，回放时按层从小到大绘制，同层保持记录顺序
+        SDL_FRect src_rect{};           ///< @brief 源矩形（像素坐标，SPRITE）
+        SDL_FRect dest_rect{};          ///< @brief 目标矩形（屏幕坐标，SPRITE）
+        float angle = 0.0f;             ///< @brief 旋转角度（度），绕目标矩形中心旋转（SPRITE）
+        bool is_flipped = false;        ///< @brief 是否水平翻转（SPRITE）
+        bool is_batched = false;        ///< @brief 是否允许与相邻的批处理精灵合并（按纹理重排）提交（SPRITE）
+        const SDL_Vertex* vertices = nullptr;   ///< @brief 四边形顶点，每 4 个一组（GEOMETRY，不拷贝，只在本帧回放前有效）
+        std::uint32_t vertex_count = 0;         ///< @brief 顶点数量（GEOMETRY）
+        SDL_Point origin{};                     ///< @brief 顶点坐标原点对应的屏幕坐标（GEOMETRY，回放时作为视口左上角，取整到像素）
+    };
+
+    /**
+     * @brief 一帧的绘制命令列表。
+     *
+     * 场景渲染时由 Renderer 填充，Renderer::present() 时整体回放。
+     * 几何体命令只记录顶点缓冲的位置和原点的屏幕坐标，顶点保持图层烘焙时的坐标，不逐帧拷贝和平移。
+     * clear() 只重置大小、保留容量，稳定后每帧记录不分配内存。
+     */
+    class RenderCommandList final
+    {
+    private:
+        std::vector<RenderCommand> commands_;   ///< @brief 按记录顺序排列的命令
+        bool is_layer_sorted_ = true;           ///< @brief 命令的层是否单调不减（是则回放时不需要排序）
+
+    public:
+        /// @brief 记录一个精灵四边形
+        void addSprite(engine::resource::TextureHandle texture, const SDL_FRect& src_rect, const SDL_FRect& dest_rect,
+                       float angle, bool is_flipped, bool is_batched, int layer);
+        /**
+         * @brief 记录一组纹理四边形
+         *
+         * @param vertices 局部坐标下的顶点，每 4 个构成一个四边形（左上、右上、右下、左下），回放前不能修改或释放
+         * @param origin 局部坐标原点对应的屏幕坐标
+         */
+        void addGeometry(engine::resource::TextureHandle texture, const std::vector<SDL_Vertex>& vertices, const SDL_Point& origin, int layer);
+
+        void clear();                   ///< @brief 清空命令（保留容量）
+        void sortByLayer();             ///< @brief 按层稳定排序（已有序时什么都不做）
+
+        bool empty() const { return commands_.empty(); }
+        size_t size() const { return commands_.size(); }
+        const std::vector<RenderCommand>& getCommands() const { return commands_; }
+    };
+}
@@ -1,5 +1,9 @@
 ﻿#include "renderer.h"
 #include "../resource/resource_manager.h"
+#include "../core/memory_tracker.h"
+#include "../core/profiler.h"
+#include <algorithm>
+#include <cmath>
 #include <spdlog/spdlog.h>
 
 #include "camera.h"
@@ -27,8 +31,8 @@ namespace engine::render
     void Renderer::drawSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& position,
         const glm::vec2& scale, float angle)
     {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture)
+        auto texture = getSpriteTexture(sprite);
+        if (texture == engine::resource::INVALID_TEXTURE_HANDLE)
         {
             spdlog::error("无法为ID{}获取纹理", sprite.getTextureId());
             return; 
@@ -52,20 +56,15 @@ namespace engine::render
             return;
         }
         
-        //执行绘制
-        if (!SDL_RenderTextureRotated(renderer_,texture,&src_rect.value(),&dest_rect,angle,nullptr,sprite.isFlipped()?SDL_FLIP_HORIZONTAL:SDL_FLIP_NONE))
-        {
-            spdlog::error("渲染 Sprite 失败 (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
-        }
-        
-        
+        //只记录命令，在 present() 时回放（批处理模式下的精灵回放时按纹理合并）
+        recordingList().addSprite(texture, src_rect.value(), dest_rect, angle, sprite.isFlipped(), is_batching_, render_layer_);
     }
 
     void Renderer::drawParallax(const Camera& camera, const Sprite& sprite, const glm::vec2& position,
         const glm::vec2& scroll_factor, const glm::bvec2& repeat, const glm::vec2& scale)
     {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture)
+        auto texture = getSpriteTexture(sprite);
+        if (texture == engine::resource::INVALID_TEXTURE_HANDLE)
         {
             spdlog::error("无法为ID{}获取纹理", sprite.getTextureId());
             return; 
@@ -106,24 +105,22 @@ namespace engine::render
             stop.y = glm::min(screen_pos.y + scaled_tex_h,viewport_size.y);
         }
 
+        //不参与批处理：回放时先提交之前收集的精灵，保证绘制顺序
+        auto& commands = recordingList();
         for (float y = start.y; y < stop.y; y+=scaled_tex_h)
         {
             for (float x = start.x; x < stop.x; x+=scaled_tex_w)
             {
                 SDL_FRect dest_rect = {x,y,scaled_tex_w,scaled_tex_h};//确定目标矩形左上角坐标
-                //执行绘制
-                if (!SDL_RenderTexture(renderer_,texture,nullptr,&dest_rect))
-                {
-                    spdlog::error("渲染 Sprite 失败 (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
-                }
+                commands.addSprite(texture, src_rect.value(), dest_rect, 0.0f, false, false, render_layer_);
             }
         }
     }
 
     void Renderer::drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size)
     {
-        auto texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture)
+        auto texture = getSpriteTexture(sprite);
+        if (texture == engine::resource::INVALID_TEXTURE_HANDLE)
         {
             spdlog::error("无法为ID{}获取纹理", sprite.getTextureId());
             return; 
@@ -148,15 +145,55 @@ namespace engine::render
             dest_rect.h = src_rect.value().h;
         }       
         
-        //执行绘制
-        if (!SDL_RenderTextureRotated(renderer_,texture,&src_rect.value(),&dest_rect,0.0,nullptr,sprite.isFlipped()?SDL_FLIP_HORIZONTAL:SDL_FLIP_NONE))
+        recordingList().addSprite(texture, src_rect.value(), dest_rect, 0.0f, sprite.isFlipped(), false, render_layer_);
+    }
+
+    void Renderer::drawGeometry(const Camera& camera, engine::resource::TextureHandle texture_handle,
+        const std::vector<SDL_Vertex>& vertices, const glm::vec2& position)
+    {
+        if (vertices.size() < 4) return;
+        
+        if (texture_handle == engine::resource::INVALID_TEXTURE_HANDLE)
         {
-            spdlog::error("渲染 UI Sprite 失败 (ID: {}): {}", sprite.getTextureId(), SDL_GetError());
+            spdlog::error("无法为句柄{}获取纹理", texture_handle);
+            return;
         }
+        
+        //只记录顶点缓冲和原点的屏幕坐标，平移由回放时的视口完成；视口只能按整像素平移
+        const glm::vec2 origin = glm::round(camera.worldToScreen(position));
+        recordingList().addGeometry(texture_handle, vertices, SDL_Point{static_cast<int>(origin.x), static_cast<int>(origin.y)}, render_layer_);
+    }
+
+    void Renderer::beginSpriteBatch()
+    {
+        if (!sprite_batch_enabled_) return;
+        is_batching_ = true;
+    }
+
+    void Renderer::endSpriteBatch()
+    {
+        is_batching_ = false;
+    }
+
+    void Renderer::setSpriteBatchEnabled(bool enabled)
+    {
+        if (!enabled)
+        {
+            endSpriteBatch();
+        }
+        sprite_batch_enabled_ = enabled;
     }
 
     void Renderer::present()
     {
+        ENGINE_PROFILE_SCOPE("Renderer::present");
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RENDER);
+        //交换双缓冲：刚记录完的列表用于回放，另一个清空后记录下一帧
+        auto& submitted = command_lists_[record_index_];
+        record_index_ ^= 1;
+        command_lists_[record_index_].clear();
+        
+        replayCommands(submitted);
         SDL_RenderPresent(renderer_);
     }
 
@@ -184,14 +221,31 @@ namespace engine::render
         }
     }
 
+    engine::resource::TextureHandle Renderer::getSpriteTexture(const Sprite& sprite)
+    {
+        //优先使用已解析的句柄，未解析时回退到字符串查找（未加载时会加载）
+        if (sprite.getTextureHandle() != engine::resource::INVALID_TEXTURE_HANDLE)
+        {
+            return sprite.getTextureHandle();
+        }
+        return resource_manager_->getTextureHandle(sprite.getTextureId());
+    }
+
     std::optional<SDL_FRect> Renderer::getSpriteSrcRect(const Sprite& sprite)
     {
-        SDL_Texture* texture = resource_manager_->getTexture(sprite.getTextureId());
-        if (!texture)
+        //在图集中：原图坐标的源矩形平移到页面坐标，没有源矩形时就是原图所在的整块区域
+        if (const auto& atlas_rect = sprite.getAtlasRect(); atlas_rect.has_value())
         {
-            spdlog::error("无法为ID{}获取纹理", sprite.getTextureId());
-            return std::nullopt; 
+            const auto& src = sprite.getSourceRect();
+            if (!src.has_value()) return atlas_rect;
+            if (src.value().w <= 0 || src.value().h <= 0)
+            {
+                spdlog::error("源尺寸无效，id:{}",sprite.getTextureId());
+                return std::nullopt;
+            }
+            return SDL_FRect{atlas_rect.value().x + src.value().x, atlas_rect.value().y + src.value().y, src.value().w, src.value().h};
         }
+        
         auto src_rect = sprite.getSourceRect();
         if (src_rect.has_value())//如果提供了源矩形，就用提供的源矩形
         {
@@ -202,15 +256,17 @@ namespace engine::render
             }
             return src_rect;
         }
-        else //否则获取纹理尺寸并返回整个纹理大小
+        else //否则返回整个纹理大小（使用 TextureManager 加载时记录的尺寸）
         {
-            SDL_FRect result = {0,0,0,0};
-            if (!SDL_GetTextureSize(texture,&result.w,&result.h))
+            glm::vec2 size = sprite.getTextureHandle() != engine::resource::INVALID_TEXTURE_HANDLE
+                ? resource_manager_->getTextureSize(sprite.getTextureHandle())
+                : resource_manager_->getTextureSize(sprite.getTextureId());
+            if (size.x <= 0 || size.y <= 0)
             {
                 spdlog::error("获取纹理尺寸失败，id:{}",sprite.getTextureId());
                 return std::nullopt;
             }
-            return result;
+            return SDL_FRect{0, 0, size.x, size.y};
         }
     }
 
@@ -222,6 +278,199 @@ namespace engine::render
             rect.y+rect.h>=0 && rect.y <= viewport_size.y;
         
     }
-}
 
+    void Renderer::replayCommands(RenderCommandList& commands)
+    {
+        if (commands.empty()) return;
+        ENGINE_PROFILE_SCOPE("Renderer::replayCommands");
+        commands.sortByLayer();
+        SDL_GetRenderViewport(renderer_, &full_viewport_);
+        
+        //相邻命令多半使用同一纹理，缓存上一次的解析结果
+        engine::resource::TextureHandle cached_handle = engine::resource::INVALID_TEXTURE_HANDLE;
+        SDL_Texture* cached_texture = nullptr;
+        int layer = commands.getCommands().front().layer;
+        for (const RenderCommand& command : commands.getCommands())
+        {
+            //批处理只在同一层内合并
+            if (command.layer != layer)
+            {
+                flushSpriteBatch();
+                layer = command.layer;
+            }
+            if (command.texture != cached_handle)
+            {
+                cached_handle = command.texture;
+                cached_texture = resource_manager_->getTexture(command.texture);
+            }
+            if (!cached_texture)
+            {
+                spdlog::error("回放时无法为句柄{}获取纹理", command.texture);
+                continue;
+            }
+            
+            if (command.type == RenderCommandType::SPRITE && command.is_batched)
+            {
+                batch_commands_.push_back({cached_texture, command.src_rect, command.dest_rect, command.angle, command.is_flipped});
+                continue;
+            }
+            
+            //不参与批处理的绘制要先提交之前收集的精灵，保证绘制顺序
+            flushSpriteBatch();
+            if (command.type == RenderCommandType::SPRITE)
+            {
+                resetViewport();
+                if (!SDL_RenderTextureRotated(renderer_, cached_texture, &command.src_rect, &command.dest_rect, command.angle, nullptr,
+                                              command.is_flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE))
+                {
+                    spdlog::error("渲染 Sprite 失败 (句柄: {}): {}", command.texture, SDL_GetError());
+                }
+            }
+            else if (setViewportOrigin(command.origin))
+            {
+                //顶点保持图层局部坐标，视口左上角放在原点的屏幕位置，所有四边形共用预生成的索引
+                const size_t quad_count = command.vertex_count / 4;
+                ensureBatchIndices(quad_count);
+                if (!SDL_RenderGeometry(renderer_, cached_texture, command.vertices, static_cast<int>(quad_count * 4),
+                                        batch_indices_.data(), static_cast<int>(quad_count * 6)))
+                {
+                    spdlog::error("渲染几何体失败: {}", SDL_GetError());
+                }
+            }
+        }
+        flushSpriteBatch();
+        resetViewport();
+    }
+
+    bool Renderer::setViewportOrigin(const SDL_Point& origin)
+    {
+        //视口同时裁剪绘制区域：保留原点右下方直到目标边缘的部分，原点在目标右侧或下方时什么都看不到
+        const SDL_Rect viewport = {full_viewport_.x + origin.x, full_viewport_.y + origin.y, full_viewport_.w - origin.x, full_viewport_.h - origin.y};
+        if (viewport.w <= 0 || viewport.h <= 0) return false;
+        if (is_viewport_offset_ && viewport_origin_.x == origin.x && viewport_origin_.y == origin.y) return true;
+        if (!SDL_SetRenderViewport(renderer_, &viewport))
+        {
+            spdlog::error("设置渲染视口失败: {}", SDL_GetError());
+            return false;
+        }
+        viewport_origin_ = origin;
+        is_viewport_offset_ = true;
+        return true;
+    }
+
+    void Renderer::resetViewport()
+    {
+        if (!is_viewport_offset_) return;
+        SDL_SetRenderViewport(renderer_, nullptr);   //引擎其他地方不设置视口，恢复为整个目标
+        is_viewport_offset_ = false;
+    }
+
+    void Renderer::flushSpriteBatch()
+    {
+        if (batch_commands_.empty()) return;
+        ENGINE_PROFILE_SCOPE("Renderer::flushSpriteBatch");
+        resetViewport();
+        
+        //按纹理排序，stable_sort 保证同一纹理内部的绘制顺序不变
+        std::stable_sort(batch_commands_.begin(), batch_commands_.end(),
+            [](const SpriteDrawCommand& a, const SpriteDrawCommand& b) { return a.texture < b.texture; });
+        
+        size_t group_begin = 0;
+        while (group_begin < batch_commands_.size())
+        {
+            //找到同一纹理的连续区间 [group_begin, group_end)
+            SDL_Texture* texture = batch_commands_[group_begin].texture;
+            size_t group_end = group_begin + 1;
+            while (group_end < batch_commands_.size() && batch_commands_[group_end].texture == texture) ++group_end;
+            
+            //SDL_Texture 的 w/h 是只读公开字段，直接读取，不需要调用 SDL_GetTextureSize
+            auto texture_w = static_cast<float>(texture->w);
+            auto texture_h = static_cast<float>(texture->h);
+            if (texture_w <= 0.0f || texture_h <= 0.0f)
+            {
+                spdlog::error("批处理时纹理尺寸无效");
+                group_begin = group_end;
+                continue;
+            }
+            
+            size_t quad_count = group_end - group_begin;
+            batch_vertices_.clear();
+            for (size_t i = group_begin; i < group_end; ++i)
+            {
+                appendQuadVertices(batch_commands_[i], texture_w, texture_h);
+            }
+            ensureBatchIndices(quad_count);
+            
+            //同一纹理的所有四边形一次提交
+            if (!SDL_RenderGeometry(renderer_, texture, batch_vertices_.data(), static_cast<int>(batch_vertices_.size()),
+                                    batch_indices_.data(), static_cast<int>(quad_count * 6)))
+            {
+                spdlog::error("批量渲染 Sprite 失败: {}", SDL_GetError());
+            }
+            group_begin = group_end;
+        }
+        batch_commands_.clear();
+    }
+
+    void Renderer::ensureBatchIndices(size_t quad_count)
+    {
+        size_t current_quads = batch_indices_.size() / 6;
+        if (current_quads >= quad_count) return;
+        
+        //每个四边形两个三角形：(0,1,2) (2,3,0)
+        batch_indices_.reserve(quad_count * 6);
+        for (size_t quad = current_quads; quad < quad_count; ++quad)
+        {
+            int base = static_cast<int>(quad * 4);
+            batch_indices_.insert(batch_indices_.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+        }
+    }
+
+    void Renderer::appendQuadVertices(const SpriteDrawCommand& command, float texture_w, float texture_h)
+    {
+        const SDL_FRect& src = command.src_rect;
+        const SDL_FRect& dst = command.dest_rect;
+        const SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+        
+        //纹理坐标归一化，水平翻转只需要交换左右两侧的 u
+        float u0 = src.x / texture_w;
+        float u1 = (src.x + src.w) / texture_w;
+        float v0 = src.y / texture_h;
+        float v1 = (src.y + src.h) / texture_h;
+        if (command.is_flipped) std::swap(u0, u1);
+        
+        //顶点顺序：左上、右上、右下、左下
+        SDL_FPoint corners[4];
+        if (command.angle == 0.0f)
+        {
+            //快速路径：没有旋转，直接使用目标矩形的四个角，不做三角函数运算
+            corners[0] = {dst.x, dst.y};
+            corners[1] = {dst.x + dst.w, dst.y};
+            corners[2] = {dst.x + dst.w, dst.y + dst.h};
+            corners[3] = {dst.x, dst.y + dst.h};
+        }
+        else
+        {
+            //与 SDL_RenderTextureRotated 一致：绕目标矩形中心顺时针旋转
+            float radians = command.angle * (SDL_PI_F / 180.0f);
+            float c = std::cos(radians);
+            float s = std::sin(radians);
+            float half_w = dst.w * 0.5f;
+            float half_h = dst.h * 0.5f;
+            float center_x = dst.x + half_w;
+            float center_y = dst.y + half_h;
+            const SDL_FPoint local[4] = {{-half_w, -half_h}, {half_w, -half_h}, {half_w, half_h}, {-half_w, half_h}};
+            for (int i = 0; i < 4; ++i)
+            {
+                corners[i] = {center_x + local[i].x * c - local[i].y * s,
+                              center_y + local[i].x * s + local[i].y * c};
+            }
+        }
+        
+        batch_vertices_.push_back({corners[0], white, {u0, v0}});
+        batch_vertices_.push_back({corners[1], white, {u1, v0}});
+        batch_vertices_.push_back({corners[2], white, {u1, v1}});
+        batch_vertices_.push_back({corners[3], white, {u0, v1}});
+    }
+}
 
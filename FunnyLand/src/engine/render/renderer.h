@@ -1,7 +1,11 @@
 ﻿#pragma once
+#include <array>
 #include <optional>
+#include <vector>
 #include <glm/glm.hpp>
 #include <SDL3/SDL_render.h>
+#include "../resource/texture_handle.h"
+#include "render_command_list.h"
 
 struct SDL_Renderer;
 struct SDL_FRect;
@@ -21,14 +25,54 @@ namespace engine::render
      * 包装 SDL_Renderer 并提供清除屏幕、绘制精灵和呈现最终图像的方法。
      * 在构造时初始化。依赖于一个有效的 SDL_Renderer 和 ResourceManager。
      * 构造失败会抛出异常。
+     *
+     * 绘制函数不直接调用 SDL：它们完成相机变换和视野剔除后，把纯数据的命令（纹理句柄、源/目标矩形、
+     * 角度、翻转、层）记录到双缓冲中的记录列表。present() 交换两个列表，回放刚记录完的一帧并呈现，
+     * 上一帧提交的列表保留到下一次 present()，可通过 getSubmittedCommands() 查看。
+     * 所有 SDL 调用都集中在回放阶段，并且都在创建 SDL_Renderer 的主线程中执行。
+     *
+     * 图块图层的几何体不拷贝顶点：命令引用图层烘焙好的顶点缓冲，回放时把视口左上角移到顶点原点的屏幕位置，
+     * 由 SDL 完成平移，每帧不在 CPU 上逐个平移顶点。
+     *
+     * 支持精灵批处理模式：beginSpriteBatch() 与 endSpriteBatch() 之间记录的精灵在回放时
+     * 与相邻的批处理精灵一起按纹理排序，同一纹理的所有四边形通过一次 SDL_RenderGeometry 提交。
      */
     class Renderer final
     {
         
     private:
+        /**
+         * @brief 回放时收集的一条批处理精灵命令（纹理句柄已解析为纹理指针）
+         */
+        struct SpriteDrawCommand
+        {
+            SDL_Texture* texture = nullptr;     ///< @brief 纹理指针，用于排序和分组
+            SDL_FRect src_rect;                 ///< @brief 源矩形（像素坐标）
+            SDL_FRect dest_rect;                ///< @brief 目标矩形（屏幕坐标）
+            float angle = 0.0f;                 ///< @brief 旋转角度（度），绕目标矩形中心旋转
+            bool is_flipped = false;            ///< @brief 是否水平翻转
+        };
+        
         //他们的生命周期不归该类管理
         SDL_Renderer* renderer_ = nullptr;
         engine::resource::ResourceManager* resource_manager_ = nullptr;
+        
+        //命令列表（双缓冲）
+        std::array<RenderCommandList, 2> command_lists_;    ///< @brief 一个记录本帧命令，另一个是上一次提交的命令
+        size_t record_index_ = 0;                           ///< @brief 当前记录列表的下标
+        int render_layer_ = 0;                              ///< @brief 之后记录的命令所在的层
+        
+        //精灵批处理相关
+        bool sprite_batch_enabled_ = true;                  ///< @brief 是否启用批处理模式
+        bool is_batching_ = false;                          ///< @brief 当前是否处于 begin/end 之间
+        std::vector<SpriteDrawCommand> batch_commands_;     ///< @brief 回放时本批次收集的绘制命令
+        std::vector<SDL_Vertex> batch_vertices_;            ///< @brief 顶点缓冲（复用，避免每帧分配）
+        std::vector<int> batch_indices_;                    ///< @brief 预生成的索引缓冲，每个四边形 6 个索引（几何体命令也使用）
+        
+        //几何体回放时的视口
+        SDL_Rect full_viewport_{};                          ///< @brief 回放开始时的完整视口（渲染坐标）
+        SDL_Point viewport_origin_{};                       ///< @brief 当前视口左上角相对完整视口的偏移
+        bool is_viewport_offset_ = false;                   ///< @brief 视口是否被几何体命令移动过
     public:
         /**
          * @brief 构造函数
@@ -75,8 +119,40 @@ namespace engine::render
         */
         void drawUISprite(const Sprite& sprite,const glm::vec2& position,const std::optional<glm::vec2>& size = std::nullopt);
         
+        /**
+        * @brief 绘制预先烘焙好的纹理四边形（例如图块区块）
+        *
+        * 顶点不拷贝，回放前（本帧 present() 之前）不能修改或释放。回放时通过视口平移，原点取整到像素；
+        * 视口同时裁剪，顶点坐标不能为负（在原点左侧或上方的部分不会显示）。
+        *
+        * @param texture_handle 纹理句柄
+        * @param vertices 局部坐标下的顶点，每 4 个构成一个四边形（左上、右上、右下、左下）
+        * @param position 局部坐标原点对应的世界坐标
+        */
+        void drawGeometry(const Camera& camera, engine::resource::TextureHandle texture_handle, const std::vector<SDL_Vertex>& vertices,
+                          const glm::vec2& position = {0.0f, 0.0f});
+        
+        /**
+        * @brief 开始批处理，之后记录的精灵在回放时可以按纹理合并提交。
+        *        未启用批处理模式时不做任何事。
+        */
+        void beginSpriteBatch();
         
-        void present();  //更新屏幕 包装SDL_RenderPresent 函数
+        /**
+        * @brief 结束批处理，之后记录的精灵按原顺序逐个绘制。
+        */
+        void endSpriteBatch();
+        
+        void setSpriteBatchEnabled(bool enabled);                                   ///< @brief 设置是否启用批处理模式（关闭时同时结束当前批次）
+        bool isSpriteBatchEnabled() const { return sprite_batch_enabled_; }         ///< @brief 获取是否启用批处理模式
+        
+        void setRenderLayer(int layer) { render_layer_ = layer; }                   ///< @brief 设置之后记录的命令所在的层（回放时层小的先画）
+        int getRenderLayer() const { return render_layer_; }                        ///< @brief 获取当前记录的层
+        
+        const RenderCommandList& getRecordingCommands() const { return command_lists_[record_index_]; }     ///< @brief 本帧正在记录的命令
+        const RenderCommandList& getSubmittedCommands() const { return command_lists_[record_index_ ^ 1]; } ///< @brief 上一次 present() 回放的命令
+        
+        void present();  //交换命令列表并回放本帧记录的命令，再调用 SDL_RenderPresent 更新屏幕
         void clearScreen();  //清除屏幕 包装SDL_RenderClear 函数
         void setDrawColor(Uint8 r,Uint8 g,Uint8 b,Uint8 a = 255);  //设置绘制颜色 包装SDL_SetRenderDrawColor 函数
         void setDrawColorFloat(float r,float g,float b,float a = 1.f);//设置绘制颜色 包装SDL_SetRenderDrawColorFloat 函数 浮点数版本
@@ -85,8 +161,17 @@ namespace engine::render
         SDL_Renderer* getRenderer() const {return renderer_;}
         
     private:
+        engine::resource::TextureHandle getSpriteTexture(const Sprite& sprite);  //获取精灵纹理句柄，优先使用已解析的句柄
         std::optional<SDL_FRect> getSpriteSrcRect(const Sprite& sprite);  //获取精灵源矩形，用于具体绘制，如果返回std::nullopt，就跳过绘制
         bool isRectInViewport(const Camera& camera,const SDL_FRect& rect);  //判断矩形是否在相机视野内 
+        
+        RenderCommandList& recordingList() { return command_lists_[record_index_]; }   //当前记录列表
+        void replayCommands(RenderCommandList& commands);                   //按层回放一帧的命令（只在这里调用 SDL 绘制函数）
+        void flushSpriteBatch();                                            //提交已收集的绘制命令，清空命令列表
+        void ensureBatchIndices(size_t quad_count);                         //确保预生成的索引缓冲至少能容纳 quad_count 个四边形
+        bool setViewportOrigin(const SDL_Point& origin);                    //把视口左上角移到 origin（相对完整视口），什么都看不到时返回 false
+        void resetViewport();                                               //恢复完整视口
+        void appendQuadVertices(const SpriteDrawCommand& command, float texture_w, float texture_h); //将一条命令转换为 4 个顶点追加到顶点缓冲
     };  
 }
 
@@ -2,6 +2,7 @@
 #include <optional>
 #include <string>
 #include <SDL3/SDL_render.h>
+#include "../resource/texture_handle.h"
 
 
 namespace engine::render
@@ -12,6 +13,9 @@ namespace engine::render
      * @brief 表示要绘制的视觉精灵的数据。
      *
      * 包含纹理标识符、要绘制的纹理部分（源矩形）以及翻转状态。
+     * 纹理句柄由使用者（例如 SpriteComponent）解析后写入，渲染时优先使用句柄。
+ * 纹理被打包进图集时，句柄指向图集页面，atlas_rect_ 记录原图在页面中的位置，
+ * source_rect_ 仍然使用原图坐标，由渲染器换算到页面坐标。
      * 位置、缩放和旋转由外部（例如 SpriteComponent）标识。
      * 渲染工作由 Renderer 类完成。（传入Sprite作为参数）
      */
@@ -21,7 +25,9 @@ namespace engine::render
         
     private:
         std::string texture_id_;                      ///< @brief 纹理资源的标识符
+        engine::resource::TextureHandle texture_handle_ = engine::resource::INVALID_TEXTURE_HANDLE; ///< @brief 已解析的纹理句柄（无效时渲染器回退到 texture_id_）
         std::optional<SDL_FRect> source_rect_;        ///< @brief 可选：要绘制的纹理部分
+        std::optional<SDL_FRect> atlas_rect_;         ///< @brief 可选：原图在图集页面中的矩形（不在图集中时为空）
         bool is_flipped_ = false;                     ///< @brief 是否水平翻转
     public:
         
@@ -38,7 +44,13 @@ namespace engine::render
         
         //getter and setter
         const std::string& getTextureId() const { return texture_id_; }
-        void setTextureId(const std::string& texture_id) { texture_id_ = texture_id; }
+        void setTextureId(const std::string& texture_id) { texture_id_ = texture_id; texture_handle_ = engine::resource::INVALID_TEXTURE_HANDLE; atlas_rect_.reset(); } // 更换纹理后句柄需要重新解析
+        
+        engine::resource::TextureHandle getTextureHandle() const { return texture_handle_; }
+        void setTextureHandle(engine::resource::TextureHandle texture_handle) { texture_handle_ = texture_handle; }
+        
+        const std::optional<SDL_FRect>& getAtlasRect() const { return atlas_rect_; }
+        void setAtlasRect(const std::optional<SDL_FRect>& atlas_rect) { atlas_rect_ = atlas_rect; }
         
         const std::optional<SDL_FRect>& getSourceRect() const { return source_rect_; }
         void setSourceRect(const std::optional<SDL_FRect>& source_rect) { source_rect_ = source_rect; }
@@ -0,0 +1,231 @@
+#include "asset_archive.h"
+#include <cstring>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::resource
+{
+    AssetArchive::~AssetArchive()
+    {
+        close();
+    }
+
+    bool AssetArchive::open(const std::string& archive_path)
+    {
+        close();
+        if (!mapFile(archive_path))
+        {
+            return false;
+        }
+        archive_path_ = archive_path;
+        base_dir_ = std::filesystem::current_path().generic_string();
+        if (!readToc())
+        {
+            close();
+            return false;
+        }
+        spdlog::info("挂载资源包 {}：{} 个条目，{:.2f} MB", archive_path, entries_.size(),
+                     static_cast<double>(mapped_size_) / (1024.0 * 1024.0));
+        return true;
+    }
+
+    void AssetArchive::close()
+    {
+        entries_.clear();
+        unmapFile();
+        archive_path_.clear();
+        base_dir_.clear();
+    }
+
+    const ArchiveEntry* AssetArchive::find(const std::string& file_path) const
+    {
+        if (entries_.empty()) return nullptr;
+        auto it = entries_.find(normalizePath(file_path, base_dir_));
+        return it != entries_.end() ? &it->second : nullptr;
+    }
+
+    SDL_IOStream* AssetArchive::openIOStream(const std::string& file_path) const
+    {
+        if (const ArchiveEntry* entry = find(file_path))
+        {
+            return SDL_IOFromConstMem(entry->data, entry->size);
+        }
+        return SDL_IOFromFile(file_path.c_str(), "rb");
+    }
+
+    SDL_Surface* AssetArchive::createSurface(const ArchiveEntry& entry)
+    {
+        if (entry.type != ArchiveEntryType::Texture)
+        {
+            SDL_SetError("资源包条目不是纹理");
+            return nullptr;
+        }
+        //映射内存是只读的，Surface 只用于创建纹理（只读像素），这里去掉 const 是安全的
+        return SDL_CreateSurfaceFrom(entry.width, entry.height, entry.format,
+                                     const_cast<std::uint8_t*>(entry.data), entry.pitch);
+    }
+
+    std::string AssetArchive::normalizePath(const std::string& file_path, const std::string& base_dir)
+    {
+        std::filesystem::path path(file_path);
+        if (path.is_absolute() && !base_dir.empty())
+        {
+            //LevelLoader 解析出的是绝对路径，转换回相对工作目录的形式
+            path = path.lexically_relative(base_dir);
+        }
+        return path.lexically_normal().generic_string();
+    }
+
+    bool AssetArchive::mapFile(const std::string& archive_path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(std::filesystem::path(archive_path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            spdlog::error("无法打开资源包 {}", archive_path);
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+        {
+            spdlog::error("无法读取资源包大小 {}", archive_path);
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            spdlog::error("无法映射资源包 {}", archive_path);
+            return false;
+        }
+        //视图会保持映射对象存活，句柄可以直接关闭
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view)
+        {
+            spdlog::error("无法映射资源包 {}", archive_path);
+            return false;
+        }
+        mapped_data_ = static_cast<const std::uint8_t*>(view);
+        mapped_size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+        const int fd = ::open(archive_path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            spdlog::error("无法打开资源包 {}", archive_path);
+            return false;
+        }
+        struct stat file_stat {};
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+        {
+            spdlog::error("无法读取资源包大小 {}", archive_path);
+            ::close(fd);
+            return false;
+        }
+        //映射会保持文件存活，描述符可以直接关闭
+        void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            spdlog::error("无法映射资源包 {}", archive_path);
+            return false;
+        }
+        mapped_data_ = static_cast<const std::uint8_t*>(view);
+        mapped_size_ = static_cast<size_t>(file_stat.st_size);
+#endif
+        return true;
+    }
+
+    void AssetArchive::unmapFile()
+    {
+        if (!mapped_data_) return;
+#ifdef _WIN32
+        UnmapViewOfFile(mapped_data_);
+#else
+        munmap(const_cast<std::uint8_t*>(mapped_data_), mapped_size_);
+#endif
+        mapped_data_ = nullptr;
+        mapped_size_ = 0;
+    }
+
+    bool AssetArchive::readToc()
+    {
+        //只校验头、目录和各条目的范围，条目内容在使用时由对应的加载函数检查
+        ArchiveHeader header;
+        if (mapped_size_ < sizeof(header))
+        {
+            spdlog::error("资源包 {} 已损坏：文件过小", archive_path_);
+            return false;
+        }
+        std::memcpy(&header, mapped_data_, sizeof(header));
+        if (std::memcmp(header.magic, ARCHIVE_MAGIC, sizeof(header.magic)) != 0)
+        {
+            spdlog::error("{} 不是资源包文件", archive_path_);
+            return false;
+        }
+        if (header.version != ARCHIVE_VERSION)
+        {
+            spdlog::error("资源包 {} 版本 {} 与引擎版本 {} 不一致，请重新生成", archive_path_, header.version, ARCHIVE_VERSION);
+            return false;
+        }
+        const std::uint64_t toc_size = static_cast<std::uint64_t>(header.entry_count) * sizeof(ArchiveTocEntry);
+        if (header.toc_offset > mapped_size_ || toc_size > mapped_size_ - header.toc_offset ||
+            header.strings_offset > mapped_size_ || header.strings_size > mapped_size_ - header.strings_offset)
+        {
+            spdlog::error("资源包 {} 已损坏：目录超出文件范围", archive_path_);
+            return false;
+        }
+
+        const char* strings = reinterpret_cast<const char*>(mapped_data_ + header.strings_offset);
+        entries_.reserve(header.entry_count);
+        for (std::uint32_t i = 0; i < header.entry_count; ++i)
+        {
+            ArchiveTocEntry toc;
+            std::memcpy(&toc, mapped_data_ + header.toc_offset + i * sizeof(ArchiveTocEntry), sizeof(toc));
+            if (toc.path_offset > header.strings_size || toc.path_length > header.strings_size - toc.path_offset ||
+                toc.data_offset > mapped_size_ || toc.data_size > mapped_size_ - toc.data_offset)
+            {
+                spdlog::error("资源包 {} 已损坏：第 {} 个条目超出文件范围", archive_path_, i);
+                entries_.clear();
+                return false;
+            }
+
+            ArchiveEntry entry;
+            entry.type = toc.type;
+            entry.data = mapped_data_ + toc.data_offset;
+            entry.size = static_cast<size_t>(toc.data_size);
+            if (toc.type == ArchiveEntryType::Texture)
+            {
+                if (static_cast<std::uint64_t>(toc.pitch) * toc.height > toc.data_size)
+                {
+                    spdlog::error("资源包 {} 已损坏：第 {} 个条目的像素数据不完整", archive_path_, i);
+                    entries_.clear();
+                    return false;
+                }
+                entry.width = static_cast<int>(toc.width);
+                entry.height = static_cast<int>(toc.height);
+                entry.pitch = static_cast<int>(toc.pitch);
+                entry.format = static_cast<SDL_PixelFormat>(toc.format);
+            }
+            entries_.emplace(std::string(strings + toc.path_offset, toc.path_length), entry);
+        }
+        return true;
+    }
+}
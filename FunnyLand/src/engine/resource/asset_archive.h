@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <SDL3/SDL_iostream.h>
+#include <SDL3/SDL_surface.h>
+
+namespace engine::resource
+{
+    /// @brief 资源包条目的内容类型
+    enum class ArchiveEntryType : std::uint32_t
+    {
+        Raw = 0,        ///< @brief 原始文件字节（音频、字体等，交给对应库的 IO 接口解码）
+        Texture = 1,    ///< @brief 预解码的 RGBA32 像素，可直接创建 Surface
+        MsgPack = 2,    ///< @brief 预解析的 JSON（图块集、配置等），以 MessagePack 存储
+        Level = 3,      ///< @brief 二进制关卡（由 Tiled 地图转换，见 engine/scene/binary_level.h）
+    };
+
+    //---------------- 磁盘布局（小端，cooker 与运行时共用） ----------------
+    // [ArchiveHeader][数据区（每项按 ARCHIVE_ALIGNMENT 对齐）][路径字符串表][ArchiveTocEntry * entry_count]
+
+    inline constexpr char ARCHIVE_MAGIC[4] = {'F', 'L', 'P', 'K'};
+    inline constexpr std::uint32_t ARCHIVE_VERSION = 2;
+    inline constexpr std::uint64_t ARCHIVE_ALIGNMENT = 16;
+
+    /// @brief 资源包文件头
+    struct ArchiveHeader
+    {
+        char magic[4];                      ///< @brief 固定为 ARCHIVE_MAGIC
+        std::uint32_t version;              ///< @brief 格式版本，不一致时拒绝挂载
+        std::uint32_t entry_count;          ///< @brief 目录项数量
+        std::uint32_t reserved;
+        std::uint64_t strings_offset;       ///< @brief 路径字符串表的偏移
+        std::uint64_t strings_size;         ///< @brief 路径字符串表的大小
+        std::uint64_t toc_offset;           ///< @brief 目录的偏移
+    };
+
+    /// @brief 资源包目录项
+    struct ArchiveTocEntry
+    {
+        std::uint64_t path_offset;          ///< @brief 路径在字符串表中的偏移（路径为相对工作目录的 generic 形式，如 assets/textures/a.png）
+        std::uint32_t path_length;          ///< @brief 路径长度（不含结尾 0）
+        ArchiveEntryType type;              ///< @brief 内容类型
+        std::uint64_t data_offset;          ///< @brief 数据相对文件开头的偏移
+        std::uint64_t data_size;            ///< @brief 数据大小
+        std::uint32_t width;                ///< @brief 纹理宽度（仅 Texture）
+        std::uint32_t height;               ///< @brief 纹理高度（仅 Texture）
+        std::uint32_t pitch;                ///< @brief 纹理行字节数（仅 Texture）
+        std::uint32_t format;               ///< @brief 纹理像素格式 SDL_PixelFormat（仅 Texture）
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 40, "ArchiveHeader 布局改变时需要提升 ARCHIVE_VERSION");
+    static_assert(sizeof(ArchiveTocEntry) == 48, "ArchiveTocEntry 布局改变时需要提升 ARCHIVE_VERSION");
+
+    /// @brief 挂载后的条目，data 直接指向映射内存
+    struct ArchiveEntry
+    {
+        ArchiveEntryType type = ArchiveEntryType::Raw;
+        const std::uint8_t* data = nullptr;
+        size_t size = 0;
+        int width = 0;
+        int height = 0;
+        int pitch = 0;
+        SDL_PixelFormat format = SDL_PIXELFORMAT_UNKNOWN;
+    };
+
+    /**
+     * @brief 只读资源包：把 FunnyLandCooker 生成的单个文件整体内存映射，按路径查找条目。
+     *
+     * 条目数据不做拷贝：纹理像素直接作为 Surface 的像素，其他条目通过 SDL_IOFromConstMem
+     * 交给 SDL_image / SDL_mixer / SDL_ttf 的 IO 接口。因此资源包必须比所有从它加载的资源活得更久
+     * （ResourceManager 中最先声明），挂载应在加载任何资源之前完成。
+     * 挂载后内容不再变化，find()/openIOStream() 可以在工作线程调用。
+     */
+    class AssetArchive final
+    {
+    private:
+        const std::uint8_t* mapped_data_ = nullptr;                 ///< @brief 映射的文件内容
+        size_t mapped_size_ = 0;                                    ///< @brief 映射大小
+        std::string archive_path_;                                  ///< @brief 资源包路径（用于日志）
+        std::string base_dir_;                                      ///< @brief 挂载时的工作目录，用于把绝对路径转换为包内路径
+        std::unordered_map<std::string, ArchiveEntry> entries_;     ///< @brief 包内路径 -> 条目
+
+    public:
+        AssetArchive() = default;
+        ~AssetArchive();
+
+        AssetArchive(const AssetArchive&) = delete;
+        AssetArchive(AssetArchive&&) = delete;
+        AssetArchive& operator=(const AssetArchive&) = delete;
+        AssetArchive& operator=(AssetArchive&&) = delete;
+
+        /// @brief 映射并校验资源包，失败时记录日志并保持未挂载状态
+        bool open(const std::string& archive_path);
+        void close();
+
+        bool isOpen() const { return mapped_data_ != nullptr; }
+        size_t getEntryCount() const { return entries_.size(); }
+
+        /// @brief 查找条目，支持相对路径和（工作目录下的）绝对路径，不在包中或未挂载时返回 nullptr
+        const ArchiveEntry* find(const std::string& file_path) const;
+
+        /**
+         * @brief 打开文件的 IO 流：包中有该条目时返回指向映射内存的只读流，否则回退到磁盘文件。
+         * 调用者负责关闭（通常传给加载函数并设置 closeio = true）。失败返回 nullptr。
+         */
+        SDL_IOStream* openIOStream(const std::string& file_path) const;
+
+        /// @brief 以 Texture 条目的像素创建 Surface（不拷贝像素，Surface 只能读取）
+        static SDL_Surface* createSurface(const ArchiveEntry& entry);
+
+        /// @brief 把路径规范化为包内路径：相对于 base_dir，去掉 . 和 ..，使用 '/' 分隔
+        static std::string normalizePath(const std::string& file_path, const std::string& base_dir);
+
+    private:
+        bool mapFile(const std::string& archive_path);
+        void unmapFile();
+        bool readToc();
+    };
+}
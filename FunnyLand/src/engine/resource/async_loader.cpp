@@ -0,0 +1,93 @@
+﻿#include "async_loader.h"
+#include <SDL3/SDL_timer.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource
+{
+    AsyncLoader::AsyncLoader(int thread_count)
+    {
+        if (thread_count < 1) thread_count = 1;
+        workers_.reserve(static_cast<std::size_t>(thread_count));
+        for (int i = 0; i < thread_count; ++i)
+        {
+            workers_.emplace_back(&AsyncLoader::workerLoop, this);
+        }
+        spdlog::trace("AsyncLoader 构造完成，工作线程数: {}", thread_count);
+    }
+
+    AsyncLoader::~AsyncLoader()
+    {
+        {
+            std::lock_guard lock(jobs_mutex_);
+            stopping_ = true;
+            jobs_.clear();
+        }
+        jobs_cv_.notify_all();
+        for (auto& worker : workers_)
+        {
+            if (worker.joinable()) worker.join();
+        }
+        //未上传的结果随 std::function 析构释放（见 PendingResource）
+        std::lock_guard lock(uploads_mutex_);
+        if (!uploads_.empty())
+        {
+            spdlog::debug("AsyncLoader 析构，丢弃{}个未上传的资源", uploads_.size());
+            uploads_.clear();
+        }
+        spdlog::trace("AsyncLoader 析构完成");
+    }
+
+    void AsyncLoader::enqueue(std::function<void()> job)
+    {
+        in_flight_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(jobs_mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        jobs_cv_.notify_one();
+    }
+
+    void AsyncLoader::postUpload(std::function<void()> upload)
+    {
+        std::lock_guard lock(uploads_mutex_);
+        uploads_.push_back(std::move(upload));
+    }
+
+    std::size_t AsyncLoader::processUploads(double budget_ms)
+    {
+        const Uint64 start = SDL_GetTicksNS();
+        const auto budget_ns = static_cast<Uint64>(budget_ms * 1000000.0);
+        std::size_t processed = 0;
+        while (true)
+        {
+            std::function<void()> upload;
+            {
+                std::lock_guard lock(uploads_mutex_);
+                if (uploads_.empty()) break;
+                upload = std::move(uploads_.front());
+                uploads_.pop_front();
+            }
+            upload();
+            in_flight_.fetch_sub(1, std::memory_order_relaxed);
+            ++processed;
+            if (SDL_GetTicksNS() - start >= budget_ns) break;
+        }
+        return processed;
+    }
+
+    void AsyncLoader::workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(jobs_mutex_);
+                jobs_cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (stopping_) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+}
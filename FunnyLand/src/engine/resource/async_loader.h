@@ -0,0 +1,86 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::resource
+{
+    /**
+     * @brief 后台解码得到、尚未交给管理器的资源。
+     *
+     * 以 shared_ptr 持有后在线程间传递：主线程接管时 release() 取走指针，
+     * 若任务在接管前被丢弃（卸载、关闭），析构时用 Deleter 释放，不会泄漏。
+     */
+    template <typename T, typename Deleter>
+    class PendingResource final
+    {
+    private:
+        T* resource_ = nullptr;
+        
+    public:
+        explicit PendingResource(T* resource) : resource_(resource) {}
+        ~PendingResource() { if (resource_) Deleter{}(resource_); }
+        
+        PendingResource(const PendingResource&) = delete;
+        PendingResource& operator=(const PendingResource&) = delete;
+        
+        T* get() const { return resource_; }
+        T* release() { T* resource = resource_; resource_ = nullptr; return resource; }
+    };
+    
+    /**
+     * @brief 异步资源加载器：后台线程池 + 主线程上传队列。
+     *
+     * 工作线程执行 enqueue() 提交的任务（磁盘 I/O 和解码），任务完成后通过 postUpload()
+     * 把需要在主线程完成的部分（创建 SDL_Texture、写入缓存）放入上传队列，
+     * 由主线程每帧调用 processUploads() 在时间预算内处理。仅供 ResourceManager 内部使用。
+     */
+    class AsyncLoader final
+    {
+    private:
+        std::vector<std::thread> workers_;
+        
+        std::deque<std::function<void()>> jobs_;        ///< @brief 等待工作线程执行的任务
+        std::mutex jobs_mutex_;
+        std::condition_variable jobs_cv_;
+        bool stopping_ = false;
+        
+        std::deque<std::function<void()>> uploads_;     ///< @brief 等待主线程执行的上传
+        std::mutex uploads_mutex_;
+        
+        std::atomic<std::size_t> in_flight_ = 0;        ///< @brief 已提交但上传尚未执行的任务数
+        
+    public:
+        explicit AsyncLoader(int thread_count);
+        ~AsyncLoader();//停止工作线程，丢弃未执行的任务和上传
+        
+        AsyncLoader(const AsyncLoader&) = delete;
+        AsyncLoader(AsyncLoader&&) = delete;
+        AsyncLoader& operator=(const AsyncLoader&) = delete;
+        AsyncLoader& operator=(AsyncLoader&&) = delete;
+        
+        /// @brief 提交后台任务。任务结束前必须调用且只调用一次 postUpload()
+        void enqueue(std::function<void()> job);
+        
+        /// @brief 由后台任务调用，把结果交回主线程
+        void postUpload(std::function<void()> upload);
+        
+        /**
+         * @brief 在主线程执行上传，至少执行一个，之后超出时间预算即停止，剩余的留到下一帧。
+         * @param budget_ms 时间预算（毫秒）
+         * @return 本次执行的上传数
+         */
+        std::size_t processUploads(double budget_ms);
+        
+        /// @brief 尚未完成（含正在解码和等待上传）的任务数
+        std::size_t getPendingCount() const { return in_flight_.load(std::memory_order_relaxed); }
+        
+    private:
+        void workerLoop();
+    };
+}
@@ -1,10 +1,26 @@
 ﻿#include "audio_manager.h"
+#include "async_loader.h"
+#include "asset_archive.h"
 #include <stdexcept>
 #include <spdlog/spdlog.h>
 
 namespace engine::resource
 {
-    AudioManager::AudioManager()
+    namespace
+    {
+        struct MixChunkFreer
+        {
+            void operator()(Mix_Chunk* chunk) const
+            {
+                Mix_FreeChunk(chunk);
+            }
+        };
+        
+        using PendingChunk = PendingResource<Mix_Chunk, MixChunkFreer>;
+    }
+    
+    AudioManager::AudioManager(const AssetArchive& archive)
+        : archive_(archive)
     {
         //初始化SDL_mixer ogg和mp3
         MIX_InitFlags flags = MIX_INIT_OGG|MIX_INIT_MP3;
@@ -48,13 +64,14 @@ namespace engine::resource
         
         //加载音效
         spdlog::debug("加载音效 {}", file_path);
-        Mix_Chunk* raw_chunk = Mix_LoadWAV(file_path.c_str());
+        Mix_Chunk* raw_chunk = Mix_LoadWAV_IO(archive_.openIOStream(file_path), true);
         if (!raw_chunk)
         {
             throw std::runtime_error("AudioManager loadSound 函数：加载音效失败");
             return nullptr;
         }
         sounds_.emplace(file_path, std::unique_ptr<Mix_Chunk,SDLMixChunkDeleter>(raw_chunk));
+        engine::core::MemoryTracker::addResource(engine::core::memory_tags::AUDIO, static_cast<std::int64_t>(raw_chunk->alen));
         spdlog::debug("成功加载并缓存音效: {}", file_path);
         return raw_chunk;
     }
@@ -73,6 +90,11 @@ namespace engine::resource
 
     void AudioManager::unloadSound(const std::string& file_path)
     {
+        if (pending_sounds_.erase(file_path) > 0)
+        {
+            spdlog::debug("取消异步加载音效: {}", file_path);
+        }
+        
         auto it = sounds_.find(file_path);
         if (it != sounds_.end())
         {
@@ -87,6 +109,7 @@ namespace engine::resource
 
     void AudioManager::clearSounds()
     {
+        pending_sounds_.clear();
         if (!sounds_.empty())
         {
             spdlog::debug("正在清除所有{}个音效", sounds_.size());
@@ -95,6 +118,65 @@ namespace engine::resource
             
     }
 
+    std::shared_future<Mix_Chunk*> AudioManager::loadSoundAsync(const std::string& file_path, AsyncLoader& loader)
+    {
+        auto it = sounds_.find(file_path);
+        if (it != sounds_.end())
+        {
+            std::promise<Mix_Chunk*> ready;
+            ready.set_value(it->second.get());
+            return ready.get_future().share();
+        }
+        auto pending_it = pending_sounds_.find(file_path);
+        if (pending_it != pending_sounds_.end())
+        {
+            return pending_it->second.future;
+        }
+        
+        auto promise = std::make_shared<std::promise<Mix_Chunk*>>();
+        auto future = promise->get_future().share();
+        pending_sounds_.emplace(file_path, PendingSound{promise, future});
+        
+        loader.enqueue([this, &loader, promise, path = file_path]()
+        {
+            //工作线程：读取并解码为设备格式的 PCM 缓冲
+            auto chunk = std::make_shared<PendingChunk>(Mix_LoadWAV_IO(archive_.openIOStream(path), true));
+            std::string error = chunk->get() ? std::string() : std::string(SDL_GetError());
+            
+            loader.postUpload([this, promise, chunk, path, error = std::move(error)]()
+            {
+                //主线程：写入缓存并兑现 future
+                auto pending_it = pending_sounds_.find(path);
+                if (pending_it == pending_sounds_.end() || pending_it->second.promise != promise)
+                {
+                    promise->set_value(nullptr);//已取消
+                    return;
+                }
+                pending_sounds_.erase(pending_it);
+                
+                auto it = sounds_.find(path);
+                if (it != sounds_.end())
+                {
+                    promise->set_value(it->second.get());//期间已被同步加载
+                    return;
+                }
+                if (!chunk->get())
+                {
+                    spdlog::error("异步加载音效失败 {} : {}", path, error);
+                    promise->set_value(nullptr);
+                    return;
+                }
+                Mix_Chunk* raw_chunk = chunk->release();
+                sounds_.emplace(path, std::unique_ptr<Mix_Chunk,SDLMixChunkDeleter>(raw_chunk));
+                engine::core::MemoryTracker::addResource(engine::core::memory_tags::AUDIO, static_cast<std::int64_t>(raw_chunk->alen));
+                spdlog::debug("成功异步加载并缓存音效: {}", path);
+                promise->set_value(raw_chunk);
+            });
+        });
+        spdlog::debug("开始异步加载音效 {}", file_path);
+        return future;
+    }
+
     Mix_Music* AudioManager::loadMusic(const std::string& file_path)
     {
         auto it = musics_.find(file_path);
@@ -105,13 +187,15 @@ namespace engine::resource
         
         //加载音乐
         spdlog::debug("加载音乐 {}", file_path);
-        Mix_Music* raw_music = Mix_LoadMUS(file_path.c_str());
+        //音乐是流式解码的，资源包中的条目在播放期间一直引用映射内存
+        Mix_Music* raw_music = Mix_LoadMUS_IO(archive_.openIOStream(file_path), true);
         if (!raw_music)
         {
             throw std::runtime_error("AudioManager loadMusic 函数：加载音乐失败");
             return nullptr;
         }
         musics_.emplace(file_path, std::unique_ptr<Mix_Music,SDLMixMusicDeleter>(raw_music));
+        engine::core::MemoryTracker::addResource(engine::core::memory_tags::AUDIO, 0);
         spdlog::debug("成功加载并缓存音乐: {}", file_path);
         return raw_music;
     }
@@ -1,15 +1,22 @@
 ﻿#pragma once
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <SDL3_mixer/SDL_mixer.h>
+#include "../core/memory_tracker.h"
 
 namespace engine::resource
 {
+    class AsyncLoader;
+    class AssetArchive;
+    
     /**
  * @brief 管理 SDL_mixer 音效 (Mix_Chunk) 和音乐 (Mix_Music)。
  *
  * 提供音频资源的加载和缓存功能。构造失败时会抛出异常。
+ * 音效可以通过 loadSoundAsync() 在后台线程解码。
+ * 文件通过资源包的 IO 流读取，包中没有的回退到磁盘文件。
  * 仅供 ResourceManager 内部使用。
  */
     class AudioManager final
@@ -18,24 +25,26 @@ namespace engine::resource
         friend class ResourceManager;
         
     private:
-        //自定义Mix_Chunk删除器
+        //自定义Mix_Chunk删除器（同时注销内存统计，缓存音效时登记）
         struct SDLMixChunkDeleter
         {
             void operator()(Mix_Chunk* chunk) const
             {
                 if (chunk)
                 {
+                    engine::core::MemoryTracker::addResource(engine::core::memory_tags::AUDIO, -static_cast<std::int64_t>(chunk->alen), -1);
                     Mix_FreeChunk(chunk);
                 }
             }
         };
-        //自定义Mix_Music删除器
+        //自定义Mix_Music删除器（音乐流式解码，只统计数量）
         struct SDLMixMusicDeleter
         {
             void operator()(Mix_Music* music) const
             {
                 if (music)
                 {
+                    engine::core::MemoryTracker::addResource(engine::core::memory_tags::AUDIO, 0, -1);
                     Mix_FreeMusic(music);
                 }
             }
@@ -46,8 +55,18 @@ namespace engine::resource
         //音乐缓存
         std::unordered_map<std::string, std::unique_ptr<Mix_Music, SDLMixMusicDeleter>> musics_;
         
+        //正在异步加载的音效：promise 在主线程上传时兑现，卸载或清空时从表中移除即视为取消
+        struct PendingSound
+        {
+            std::shared_ptr<std::promise<Mix_Chunk*>> promise;
+            std::shared_future<Mix_Chunk*> future;
+        };
+        std::unordered_map<std::string, PendingSound> pending_sounds_;
+        
+        const AssetArchive& archive_;   //资源包（未挂载时直接读取磁盘文件）
+        
     public:
-        AudioManager();
+        explicit AudioManager(const AssetArchive& archive);
         ~AudioManager();//析构函数,清理所有音效和音乐资源
         
         //只需要一个实例
@@ -62,6 +81,7 @@ namespace engine::resource
         Mix_Chunk* getSound(const std::string& file_path);//尝试获取的音效指针，如果不存在就尝试加载
         void unloadSound(const std::string& file_path);//卸载音效
         void clearSounds();//清除所有音效
+        std::shared_future<Mix_Chunk*> loadSoundAsync(const std::string& file_path, AsyncLoader& loader);//在后台加载音效，上传后兑现（失败或取消为 nullptr）
         
         //music相关
         Mix_Music* loadMusic(const std::string& file_path);//加载音乐
@@ -1,12 +1,15 @@
 ﻿#include "font_manager.h"
+#include "asset_archive.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <spdlog/spdlog.h>
 
 
 namespace engine::resource
 {
-    FontManager::FontManager()
+    FontManager::FontManager(const AssetArchive& archive)
+        : archive_(archive)
     {
         if (!TTF_WasInit()&&!TTF_Init())
         {
@@ -45,13 +48,16 @@ namespace engine::resource
         }
         //缓存中没有，加载字体
         spdlog::debug("加载字体 {} ，点大小 {}", file_path, point_size);
-        TTF_Font* raw_font = TTF_OpenFont(file_path.c_str(), static_cast<float>(point_size));
+        SDL_IOStream* stream = archive_.openIOStream(file_path);
+        const std::int64_t memory_bytes = stream ? std::max<Sint64>(SDL_GetIOSize(stream), 0) : 0;
+        TTF_Font* raw_font = TTF_OpenFontIO(stream, true, static_cast<float>(point_size));
         if (!raw_font)
         {
             throw std::runtime_error("FontManager loadFont 函数：加载字体失败");
             return nullptr;
         }
-        fonts_.emplace(key, std::unique_ptr<TTF_Font,SDLFontDeleter>(raw_font));
+        fonts_.emplace(key, std::unique_ptr<TTF_Font,SDLFontDeleter>(raw_font, SDLFontDeleter{memory_bytes}));
+        engine::core::MemoryTracker::addResource(engine::core::memory_tags::FONTS, memory_bytes);
         spdlog::debug("成功加载并缓存字体: {} ，点大小 {}", file_path, point_size);
         return raw_font;
         
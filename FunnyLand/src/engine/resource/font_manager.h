@@ -6,10 +6,13 @@
 #include <functional>   // 用于 std::hash
 
 #include <SDL3_ttf/SDL_ttf.h> // SDL_ttf 主头文件
+#include "../core/memory_tracker.h"
 
 
 namespace engine::resource
 {
+  class AssetArchive;
+  
   using FontKey = std::pair<std::string, int>;  //将字体路径和字号合并成一个单元
   
   //FontKey的自定义哈希函数
@@ -28,6 +31,7 @@ namespace engine::resource
  * @brief 管理 SDL_ttf 字体资源（TTF_Font）。
  *
  * 提供字体的加载和缓存功能，通过文件路径和点大小来标识。
+ * 字体文件通过资源包的 IO 流读取，包中没有的回退到磁盘文件。
  * 构造失败会抛出异常。仅供 ResourceManager 内部使用。
  */
 class FontManager
@@ -35,13 +39,16 @@ class FontManager
     friend class ResourceManager;
     
 private:
-    //SDL_Font的删除器函数对象,用于智能指针管理
+    //SDL_Font的删除器函数对象,用于智能指针管理（记录加载时登记的内存，关闭时注销）
     struct SDLFontDeleter
     {
+        std::int64_t memory_bytes = 0;  //登记的内存（字体文件大小，近似 FreeType 持有的数据）
+        
         void operator()(TTF_Font* font) const
         {
             if (font)
             {
+                engine::core::MemoryTracker::addResource(engine::core::memory_tags::FONTS, -memory_bytes, -1);
                 TTF_CloseFont(font);
             }
         }
@@ -50,9 +57,11 @@ private:
     // unordered_map 的键需要能转换为哈希值，对于基础数据类型，系统会自动转换
     // 但是对于对于自定义类型（系统无法自动转化），则需要提供自定义哈希函数（第三个模版参数）
     std::unordered_map<FontKey, std::unique_ptr<TTF_Font, SDLFontDeleter>, FontKeyHash> fonts_;
+    
+    const AssetArchive& archive_;   //资源包（未挂载时直接读取磁盘文件）
 
 public:
-    FontManager();
+    explicit FontManager(const AssetArchive& archive);
     
     ~FontManager();//清理资源并关闭SDL_ttf
     
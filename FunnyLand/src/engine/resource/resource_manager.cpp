@@ -1,7 +1,12 @@
 ﻿#include "resource_manager.h"
+#include "asset_archive.h"
+#include "async_loader.h"
 #include "font_manager.h"
 #include "audio_manager.h"
 #include "texture_manager.h"
+#include "texture_atlas.h"
+#include "../core/memory_tracker.h"
+#include <SDL3/SDL_render.h>
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <glm/glm.hpp>
@@ -10,13 +15,26 @@
 
 namespace engine::resource
 {
+    namespace
+    {
+        /// @brief 新加载的纹理显存记在发起加载的场景名下（需在切换到 RESOURCES 标签之前读取），场景外的加载记在 Textures 标签
+        engine::core::MemoryTag textureOwnerTag()
+        {
+            const auto tag = engine::core::MemoryTracker::getCurrentTag();
+            return tag < engine::core::memory_tags::BUILTIN_COUNT ? engine::core::memory_tags::TEXTURES : tag;
+        }
+    }
     
-    
-    ResourceManager::ResourceManager(SDL_Renderer* renderer)
+    ResourceManager::ResourceManager(SDL_Renderer* renderer, int loader_threads)
     {
-        texture_manager_ = std::make_unique<TextureManager>(renderer);
-        font_manager_ = std::make_unique<FontManager>();
-        audio_manager_ = std::make_unique<AudioManager>();
+        //资源管理器的缓存表等堆内存记入 Resources 标签，而不是发起加载的场景
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
+        archive_ = std::make_unique<AssetArchive>();
+        texture_manager_ = std::make_unique<TextureManager>(renderer, *archive_);
+        font_manager_ = std::make_unique<FontManager>(*archive_);
+        audio_manager_ = std::make_unique<AudioManager>(*archive_);
+        texture_atlas_ = std::make_unique<TextureAtlas>();
+        async_loader_ = std::make_unique<AsyncLoader>(loader_threads);
         
         spdlog::trace("ResourceManager 构造完成");
     }
@@ -31,14 +49,29 @@ namespace engine::resource
         spdlog::trace("ResourceManager 清除所有资源完成");
     }
 
+    bool ResourceManager::mountArchive(const std::string& archive_path)
+    {
+        //已加载的资源可能引用旧的映射内存，只允许在启动时挂载一次
+        if (archive_->isOpen())
+        {
+            spdlog::warn("资源包已挂载，忽略 {}", archive_path);
+            return false;
+        }
+        return archive_->open(archive_path);
+    }
+
     SDL_Texture* ResourceManager::loadTexture(const std::string& file_path)
     {
-        return texture_manager_->loadTexture(file_path);
+        const auto owner = textureOwnerTag();
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
+        return texture_manager_->loadTexture(file_path, owner);
     }
 
     SDL_Texture* ResourceManager::getTexture(const std::string& file_path)
     {
-        return texture_manager_->getTexture(file_path);
+        const auto owner = textureOwnerTag();
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
+        return texture_manager_->getTexture(file_path, owner);
     }
 
     void ResourceManager::unloadTexture(const std::string& file_path)
@@ -48,7 +81,7 @@ namespace engine::resource
 
     glm::vec2 ResourceManager::getTextureSize(const std::string& file_path)
     {
-        return texture_manager_->getTextureSize(file_path);
+        return texture_manager_->getTextureSize(file_path, textureOwnerTag());
     }
 
     void ResourceManager::clearTextures()
@@ -56,13 +89,138 @@ namespace engine::resource
         texture_manager_->clearTextures();
     }
 
+    TextureHandle ResourceManager::getTextureHandle(const std::string& file_path)
+    {
+        const auto owner = textureOwnerTag();
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
+        return texture_manager_->getTextureHandle(file_path, owner);
+    }
+
+    SDL_Texture* ResourceManager::getTexture(TextureHandle handle)
+    {
+        return texture_manager_->getTexture(handle);
+    }
+
+    glm::vec2 ResourceManager::getTextureSize(TextureHandle handle)
+    {
+        return texture_manager_->getTextureSize(handle);
+    }
+
+    const TextureInfo* ResourceManager::getTextureInfo(TextureHandle handle) const
+    {
+        return texture_manager_->getTextureInfo(handle);
+    }
+
+    size_t ResourceManager::getTextureMemoryUsage() const
+    {
+        return texture_manager_->getTotalMemoryBytes();
+    }
+
+    void ResourceManager::logTextureMemoryReport() const
+    {
+        texture_manager_->logMemoryReport();
+    }
+
+    TextureHandle ResourceManager::loadTextureAsync(const std::string& file_path)
+    {
+        const auto owner = textureOwnerTag();
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
+        return texture_manager_->loadTextureAsync(file_path, owner, *async_loader_);
+    }
+
+    bool ResourceManager::isTextureReady(TextureHandle handle) const
+    {
+        return texture_manager_->isTextureReady(handle);
+    }
+
+    bool ResourceManager::isTextureLoading(TextureHandle handle) const
+    {
+        return texture_manager_->isTextureLoading(handle);
+    }
+
+    std::shared_future<Mix_Chunk*> ResourceManager::loadSoundAsync(const std::string& file_path)
+    {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
+        return audio_manager_->loadSoundAsync(file_path, *async_loader_);
+    }
+
+    size_t ResourceManager::processAsyncLoads(double budget_ms)
+    {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
+        return async_loader_->processUploads(budget_ms);
+    }
+
+    size_t ResourceManager::getPendingAsyncLoads() const
+    {
+        return async_loader_->getPendingCount();
+    }
+
+    bool ResourceManager::initTextureAtlas(const AtlasSettings& settings)
+    {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
+        //页面尺寸不能超过渲染器支持的最大纹理尺寸
+        AtlasSettings effective = settings;
+        const auto max_texture_size = static_cast<int>(SDL_GetNumberProperty(
+            SDL_GetRendererProperties(texture_manager_->renderer_), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0));
+        if (max_texture_size > 0 && effective.page_size > max_texture_size)
+        {
+            spdlog::info("图集页面尺寸 {} 超过渲染器上限，改为 {}", effective.page_size, max_texture_size);
+            effective.page_size = max_texture_size;
+        }
+        
+        const auto sources = TextureAtlas::collectSourceImages(effective.directories);
+        std::vector<TextureHandle> page_handles;
+        
+        //1. 优先读取缓存：只需加载少量页面图片
+        if (!effective.cache_path.empty() && texture_atlas_->loadIndex(effective.cache_path, sources, effective))
+        {
+            for (const auto& page_file : texture_atlas_->page_files_)
+            {
+                page_handles.push_back(texture_manager_->getTextureHandle(page_file, engine::core::memory_tags::TEXTURES));
+            }
+            texture_atlas_->assignPages(page_handles);
+            return true;
+        }
+        
+        //2. 重新打包，写入缓存后上传页面
+        if (!texture_atlas_->build(sources, effective))
+        {
+            return false;
+        }
+        const bool saved = !effective.cache_path.empty() && texture_atlas_->save(effective.cache_path, effective);
+        for (size_t page = 0; page < texture_atlas_->page_surfaces_.size(); ++page)
+        {
+            //已缓存的页面以文件路径登记，卸载后可以按路径重新加载
+            const std::string page_id = saved ? effective.cache_path + "_" + std::to_string(page) + ".png"
+                                              : "atlas#" + std::to_string(page);
+            SDL_Texture* texture = SDL_CreateTextureFromSurface(texture_manager_->renderer_, texture_atlas_->page_surfaces_[page].get());
+            if (!texture)
+            {
+                spdlog::error("创建图集页面纹理失败: {}", SDL_GetError());
+                page_handles.push_back(INVALID_TEXTURE_HANDLE);
+                continue;
+            }
+            page_handles.push_back(texture_manager_->adoptTexture(page_id, texture));
+        }
+        texture_atlas_->releaseSurfaces();
+        texture_atlas_->assignPages(page_handles);
+        return true;
+    }
+
+    const AtlasRegion* ResourceManager::findAtlasRegion(const std::string& file_path) const
+    {
+        return texture_atlas_->findRegion(file_path);
+    }
+
     Mix_Chunk* ResourceManager::loadSound(const std::string& file_path)
     {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
         return audio_manager_->loadSound(file_path);
     }
 
     Mix_Chunk* ResourceManager::getSound(const std::string& file_path)
     {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
         return audio_manager_->getSound(file_path);
     }
 
@@ -78,11 +236,13 @@ namespace engine::resource
 
     Mix_Music* ResourceManager::loadMusic(const std::string& file_path)
     {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
         return audio_manager_->loadMusic(file_path);
     }
 
     Mix_Music* ResourceManager::getMusic(const std::string& file_path)
     {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
         return audio_manager_->getMusic(file_path);
     }
 
@@ -98,11 +258,13 @@ namespace engine::resource
 
     TTF_Font* ResourceManager::loadFont(const std::string& file_path, int font_size)
     {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
         return font_manager_->loadFont(file_path, font_size);
     }
 
     TTF_Font* ResourceManager::getFont(const std::string& file_path, int font_size)
     {
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::RESOURCES);
         return font_manager_->getFont(file_path, font_size);
     }
 
@@ -1,7 +1,10 @@
 ﻿#pragma once
+#include <cstddef>
+#include <future>
 #include <memory>
 #include <string>
 #include <glm/glm.hpp>
+#include "texture_handle.h"
 
 struct SDL_Texture;
 struct SDL_Renderer;
@@ -15,6 +18,12 @@ namespace engine::resource
     class FontManager;
     class TextureManager;
     class AudioManager;
+    class AsyncLoader;
+    class AssetArchive;
+    class TextureAtlas;
+    struct AtlasSettings;
+    struct AtlasRegion;
+    struct TextureInfo;
     
 /**
  * @brief 作为访问各种资源管理器的中央控制点（外观模式 Facade）。
@@ -25,12 +34,15 @@ class ResourceManager final
  
 private:
     //使用unique_ptr管理资源管理器的实例
+    std::unique_ptr<AssetArchive> archive_;//最先声明，最后析构：音乐和字体在使用期间一直引用资源包的映射内存
     std::unique_ptr<TextureManager> texture_manager_;
     std::unique_ptr<FontManager> font_manager_;
     std::unique_ptr<AudioManager> audio_manager_;
+    std::unique_ptr<TextureAtlas> texture_atlas_;
+    std::unique_ptr<AsyncLoader> async_loader_;//最后声明，最先析构：先停掉工作线程再释放各管理器
 
 public:
-    explicit  ResourceManager(SDL_Renderer* renderer);//单个参数的构造函数，防止隐式转换
+    explicit  ResourceManager(SDL_Renderer* renderer, int loader_threads = 2);//loader_threads 为异步加载线程数
     
     //只有一个资源管理器实例
     ResourceManager(const ResourceManager&) = delete;
@@ -43,6 +55,10 @@ public:
     
     void clear();//清除所有资源
     
+    //archive 由 FunnyLandCooker 生成的资源包，挂载后各类资源优先从包中读取，不在包中的仍读取散文件
+    bool mountArchive(const std::string& archive_path);//挂载资源包（应在加载任何资源之前调用），失败时继续使用散文件
+    const AssetArchive& getArchive() const { return *archive_; }//供不经过管理器读取文件的模块（如 LevelLoader）使用
+    
     //资源访问统一接口
     //texture
     SDL_Texture* loadTexture(const std::string& file_path); //加载纹理
@@ -51,6 +67,26 @@ public:
     glm::vec2 getTextureSize(const std::string& file_path);//获取纹理大小
     void clearTextures();//清除所有纹理
     
+    //texture handle 热路径使用句柄，避免字符串哈希
+    TextureHandle getTextureHandle(const std::string& file_path);//获取纹理句柄，未加载会尝试加载，失败返回 INVALID_TEXTURE_HANDLE
+    SDL_Texture* getTexture(TextureHandle handle);//按句柄获取纹理指针
+    glm::vec2 getTextureSize(TextureHandle handle);//按句柄获取纹理大小
+    const TextureInfo* getTextureInfo(TextureHandle handle) const;//按句柄获取纹理元数据（尺寸、格式、显存占用）
+    size_t getTextureMemoryUsage() const;//获取已加载纹理的显存占用总和（字节），按场景的占用见 MemoryTracker 中场景标签的资源内存
+    void logTextureMemoryReport() const;//输出每个纹理的显存占用报告，以及按场景的合计
+    
+    //async 后台解码，主线程在 processAsyncLoads() 中按预算上传
+    TextureHandle loadTextureAsync(const std::string& file_path);//异步加载纹理，立即返回句柄，上传前按句柄获取到的是占位纹理
+    bool isTextureReady(TextureHandle handle) const;//纹理是否已上传
+    bool isTextureLoading(TextureHandle handle) const;//纹理是否仍在异步加载（加载失败后为 false 且未就绪）
+    std::shared_future<Mix_Chunk*> loadSoundAsync(const std::string& file_path);//异步加载音效，上传后兑现（失败为 nullptr）
+    size_t processAsyncLoads(double budget_ms);//在主线程执行已解码资源的上传，返回本次处理数，每帧由 GameApp 调用
+    size_t getPendingAsyncLoads() const;//尚未完成的异步加载数
+    
+    //atlas 把小图打包到共享的图集页面，同一页的精灵可以合批绘制
+    bool initTextureAtlas(const AtlasSettings& settings);//读取缓存的图集，缓存不存在或过期时重新打包并写入缓存
+    const AtlasRegion* findAtlasRegion(const std::string& file_path) const;//查找图片所在的图集区域，不在图集中返回 nullptr
+    
     //sound
     Mix_Chunk* loadSound(const std::string& file_path);//加载音效
     Mix_Chunk* getSound(const std::string& file_path);//尝试获取的音效指针，如果不存在就尝试加载
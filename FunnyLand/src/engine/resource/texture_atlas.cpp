@@ -0,0 +1,381 @@
+﻿#include "texture_atlas.h"
+#include <SDL3_image/SDL_image.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+
+namespace engine::resource
+{
+    namespace
+    {
+        constexpr int INDEX_VERSION = 1;
+
+        /**
+         * @brief Skyline 装箱器（bottom-left 规则）。
+         *
+         * 用一条由水平线段组成的"天际线"记录每个 x 区间已占用到的高度，
+         * 新矩形放在能让其底边最低的位置，适合大量尺寸相近的小图。
+         */
+        class SkylinePacker
+        {
+        private:
+            struct Node
+            {
+                int x;
+                int y;
+                int width;
+            };
+
+            int width_;
+            int height_;
+            std::vector<Node> nodes_;
+
+        public:
+            SkylinePacker(int width, int height) : width_(width), height_(height), nodes_{{0, 0, width}} {}
+
+            /// @brief 放入一个矩形，成功时返回左上角坐标
+            bool insert(int w, int h, SDL_Point& out)
+            {
+                int best_bottom = INT_MAX;
+                int best_width = INT_MAX;
+                size_t best_index = nodes_.size();
+                for (size_t i = 0; i < nodes_.size(); ++i)
+                {
+                    const int y = fit(i, w, h);
+                    if (y < 0) continue;
+                    //底边更低优先，相同时选更窄的线段，减少浪费
+                    if (y + h < best_bottom || (y + h == best_bottom && nodes_[i].width < best_width))
+                    {
+                        best_bottom = y + h;
+                        best_width = nodes_[i].width;
+                        best_index = i;
+                        out = {nodes_[i].x, y};
+                    }
+                }
+                if (best_index == nodes_.size()) return false;
+
+                addNode(best_index, out.x, out.y + h, w);
+                return true;
+            }
+
+        private:
+            //矩形左边放在第 index 段起点时的 y，放不下返回 -1
+            int fit(size_t index, int w, int h) const
+            {
+                const int x = nodes_[index].x;
+                if (x + w > width_) return -1;
+                int y = nodes_[index].y;
+                int remaining = w;
+                for (size_t i = index; remaining > 0; ++i)
+                {
+                    if (i >= nodes_.size()) return -1;
+                    y = std::max(y, nodes_[i].y);
+                    if (y + h > height_) return -1;
+                    remaining -= nodes_[i].width;
+                }
+                return y;
+            }
+
+            void addNode(size_t index, int x, int y, int w)
+            {
+                nodes_.insert(nodes_.begin() + static_cast<std::ptrdiff_t>(index), Node{x, y, w});
+
+                //新线段覆盖的后续线段被截短或删除
+                for (size_t i = index + 1; i < nodes_.size();)
+                {
+                    const Node& prev = nodes_[i - 1];
+                    const int prev_right = prev.x + prev.width;
+                    if (nodes_[i].x >= prev_right) break;
+                    const int shrink = prev_right - nodes_[i].x;
+                    nodes_[i].x += shrink;
+                    nodes_[i].width -= shrink;
+                    if (nodes_[i].width > 0) break;
+                    nodes_.erase(nodes_.begin() + static_cast<std::ptrdiff_t>(i));
+                }
+
+                //合并高度相同的相邻线段
+                for (size_t i = 0; i + 1 < nodes_.size();)
+                {
+                    if (nodes_[i].y == nodes_[i + 1].y)
+                    {
+                        nodes_[i].width += nodes_[i + 1].width;
+                        nodes_.erase(nodes_.begin() + static_cast<std::ptrdiff_t>(i + 1));
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+        };
+
+        //原图的大小和修改时间，用于判断缓存是否过期
+        nlohmann::json fingerprint(const std::string& path)
+        {
+            std::error_code size_ec;
+            std::error_code time_ec;
+            const auto size = std::filesystem::file_size(path, size_ec);
+            const auto mtime = std::filesystem::last_write_time(path, time_ec);
+            return {{"path", path},
+                    {"size", size_ec ? 0 : static_cast<std::uint64_t>(size)},
+                    {"mtime", time_ec ? 0 : static_cast<std::int64_t>(mtime.time_since_epoch().count())}};
+        }
+
+        nlohmann::json settingsJson(const AtlasSettings& settings)
+        {
+            return {{"page_size", settings.page_size}, {"max_source_size", settings.max_source_size}, {"padding", settings.padding}};
+        }
+
+        std::string pageFilePath(const std::string& cache_path, size_t page)
+        {
+            return cache_path + "_" + std::to_string(page) + ".png";
+        }
+    }
+
+    const AtlasRegion* TextureAtlas::findRegion(const std::string& file_path) const
+    {
+        auto it = regions_.find(file_path);
+        return it != regions_.end() ? &it->second : nullptr;
+    }
+
+    std::vector<std::string> TextureAtlas::collectSourceImages(const std::vector<std::string>& directories)
+    {
+        std::vector<std::string> paths;
+        for (const auto& directory : directories)
+        {
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+            {
+                if (!entry.is_regular_file() || entry.path().extension() != ".png") continue;
+                paths.push_back(entry.path().generic_string());
+            }
+            if (ec)
+            {
+                spdlog::warn("无法读取图集目录 {}: {}", directory, ec.message());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    bool TextureAtlas::build(const std::vector<std::string>& source_paths, const AtlasSettings& settings)
+    {
+        clear();
+        sources_ = source_paths;
+
+        //1. 读取小图并统一转换成 RGBA32
+        struct SourceImage
+        {
+            std::string path;
+            std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface;
+        };
+        std::vector<SourceImage> sources;
+        for (const auto& path : source_paths)
+        {
+            std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> loaded(IMG_Load(path.c_str()));
+            if (!loaded)
+            {
+                spdlog::warn("图集跳过无法加载的图片 {}: {}", path, SDL_GetError());
+                continue;
+            }
+            if (loaded->w > settings.max_source_size || loaded->h > settings.max_source_size ||
+                loaded->w + settings.padding > settings.page_size || loaded->h + settings.padding > settings.page_size)
+            {
+                continue;//大图不打包
+            }
+            std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> converted(SDL_ConvertSurface(loaded.get(), SDL_PIXELFORMAT_RGBA32));
+            if (!converted)
+            {
+                spdlog::warn("图集跳过无法转换格式的图片 {}: {}", path, SDL_GetError());
+                continue;
+            }
+            sources.push_back({path, std::move(converted)});
+        }
+        if (sources.empty())
+        {
+            spdlog::info("图集没有可打包的图片");
+            return false;
+        }
+
+        //2. 按高度从高到低装箱，Skyline 在这种顺序下浪费最少
+        std::stable_sort(sources.begin(), sources.end(), [](const SourceImage& a, const SourceImage& b)
+        {
+            return a.surface->h != b.surface->h ? a.surface->h > b.surface->h : a.surface->w > b.surface->w;
+        });
+
+        std::vector<SkylinePacker> packers;
+        std::vector<int> page_heights;
+        for (const auto& source : sources)
+        {
+            const int w = source.surface->w + settings.padding;
+            const int h = source.surface->h + settings.padding;
+            SDL_Point pos = {0, 0};
+            size_t page = 0;
+            while (page < packers.size() && !packers[page].insert(w, h, pos)) ++page;
+            if (page == packers.size())
+            {
+                packers.emplace_back(settings.page_size, settings.page_size);
+                page_heights.push_back(0);
+                packers.back().insert(w, h, pos);
+            }
+            page_heights[page] = std::max(page_heights[page], pos.y + h);
+            images_.push_back({source.path, static_cast<int>(page),
+                               SDL_FRect{static_cast<float>(pos.x), static_cast<float>(pos.y),
+                                         static_cast<float>(source.surface->w), static_cast<float>(source.surface->h)}});
+        }
+
+        //3. 生成页面（高度裁剪到实际使用的部分），不混合地拷贝像素，保留透明度
+        for (size_t page = 0; page < packers.size(); ++page)
+        {
+            std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface(
+                SDL_CreateSurface(settings.page_size, page_heights[page], SDL_PIXELFORMAT_RGBA32));
+            if (!surface)
+            {
+                spdlog::error("创建图集页面失败: {}", SDL_GetError());
+                clear();
+                return false;
+            }
+            SDL_FillSurfaceRect(surface.get(), nullptr, 0);
+            page_surfaces_.push_back(std::move(surface));
+        }
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            const auto& image = images_[i];
+            SDL_Surface* source = sources[i].surface.get();
+            SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+            SDL_Rect dest = {static_cast<int>(image.rect.x), static_cast<int>(image.rect.y), source->w, source->h};
+            if (!SDL_BlitSurface(source, nullptr, page_surfaces_[image.page].get(), &dest))
+            {
+                spdlog::error("拷贝图片 {} 到图集失败: {}", image.path, SDL_GetError());
+            }
+        }
+
+        spdlog::info("图集打包完成：{} 张图片，{} 页", images_.size(), page_surfaces_.size());
+        return true;
+    }
+
+    bool TextureAtlas::save(const std::string& cache_path, const AtlasSettings& settings) const
+    {
+        std::error_code ec;
+        const auto parent = std::filesystem::path(cache_path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+
+        nlohmann::json index;
+        index["version"] = INDEX_VERSION;
+        index["settings"] = settingsJson(settings);
+        index["pages"] = nlohmann::json::array();
+        for (size_t page = 0; page < page_surfaces_.size(); ++page)
+        {
+            const std::string page_file = pageFilePath(cache_path, page);
+            if (!IMG_SavePNG(page_surfaces_[page].get(), page_file.c_str()))
+            {
+                spdlog::error("保存图集页面 {} 失败: {}", page_file, SDL_GetError());
+                return false;
+            }
+            index["pages"].push_back(page_file);
+        }
+        index["images"] = nlohmann::json::array();
+        for (const auto& image : images_)
+        {
+            index["images"].push_back({{"path", image.path}, {"page", image.page},
+                                       {"x", image.rect.x}, {"y", image.rect.y}, {"w", image.rect.w}, {"h", image.rect.h}});
+        }
+        index["sources"] = nlohmann::json::array();
+        for (const auto& source : sources_)
+        {
+            index["sources"].push_back(fingerprint(source));
+        }
+
+        std::ofstream index_file(cache_path + ".json");
+        if (!index_file.is_open())
+        {
+            spdlog::error("无法写入图集索引 {}.json", cache_path);
+            return false;
+        }
+        index_file << index.dump(4);
+        spdlog::info("图集已缓存到 {}.json", cache_path);
+        return true;
+    }
+
+    bool TextureAtlas::loadIndex(const std::string& cache_path, const std::vector<std::string>& source_paths,
+                                 const AtlasSettings& settings)
+    {
+        clear();
+        std::ifstream index_file(cache_path + ".json");
+        if (!index_file.is_open()) return false;
+
+        nlohmann::json index;
+        try
+        {
+            index_file >> index;
+        }
+        catch (const nlohmann::json::parse_error& e)
+        {
+            spdlog::warn("图集索引 {}.json 解析失败，将重新打包: {}", cache_path, e.what());
+            return false;
+        }
+
+        //原图增删、修改或页面尺寸变化都需要重建
+        if (index.value("version", 0) != INDEX_VERSION || !index.contains("sources") || !index.contains("pages") ||
+            !index.contains("images") || index.value("settings", nlohmann::json()) != settingsJson(settings))
+        {
+            return false;
+        }
+        const auto& cached_sources = index["sources"];
+        if (cached_sources.size() != source_paths.size()) return false;
+        for (size_t i = 0; i < source_paths.size(); ++i)
+        {
+            if (cached_sources[i] != fingerprint(source_paths[i])) return false;
+        }
+
+        for (const auto& page_json : index["pages"])
+        {
+            page_files_.push_back(page_json.get<std::string>());
+            if (!std::filesystem::exists(page_files_.back()))
+            {
+                clear();
+                return false;
+            }
+        }
+        for (const auto& image_json : index["images"])
+        {
+            PackedImage image;
+            image.path = image_json.value("path", "");
+            image.page = image_json.value("page", 0);
+            image.rect = {image_json.value("x", 0.0f), image_json.value("y", 0.0f),
+                          image_json.value("w", 0.0f), image_json.value("h", 0.0f)};
+            if (image.page < 0 || static_cast<size_t>(image.page) >= page_files_.size())
+            {
+                clear();
+                return false;
+            }
+            images_.push_back(std::move(image));
+        }
+        sources_ = source_paths;
+        spdlog::info("从缓存读取图集索引 {}.json：{} 张图片，{} 页", cache_path, images_.size(), page_files_.size());
+        return true;
+    }
+
+    void TextureAtlas::assignPages(const std::vector<TextureHandle>& page_handles)
+    {
+        regions_.clear();
+        for (const auto& image : images_)
+        {
+            const AtlasRegion region{page_handles[image.page], image.rect};
+            if (region.page == INVALID_TEXTURE_HANDLE) continue;
+            regions_[image.path] = region;
+        }
+    }
+
+    void TextureAtlas::clear()
+    {
+        page_surfaces_.clear();
+        page_files_.clear();
+        images_.clear();
+        sources_.clear();
+        regions_.clear();
+    }
+}
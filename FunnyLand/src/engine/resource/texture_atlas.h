@@ -0,0 +1,103 @@
+﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_surface.h>
+#include "texture_handle.h"
+
+namespace engine::resource
+{
+    /// @brief 图集构建参数
+    struct AtlasSettings
+    {
+        std::vector<std::string> directories;   ///< @brief 收集图片的目录（不递归）
+        int page_size = 1024;                   ///< @brief 图集页的最大边长（像素），会被渲染器支持的最大纹理尺寸限制
+        int max_source_size = 256;              ///< @brief 宽或高超过该值的图片不打包（大图单独成纹理更合适）
+        int padding = 1;                        ///< @brief 图片之间的间隔（像素），避免采样时混入相邻图片
+        std::string cache_path;                 ///< @brief 缓存路径前缀，生成 <cache_path>.json 和 <cache_path>_N.png（为空则不缓存）
+    };
+
+    /// @brief 一张原始图片在图集中的位置
+    struct AtlasRegion
+    {
+        TextureHandle page = INVALID_TEXTURE_HANDLE;    ///< @brief 图集页纹理句柄
+        SDL_FRect rect = {0, 0, 0, 0};                  ///< @brief 在图集页中的矩形（即原图在页内的源矩形）
+    };
+
+    /**
+     * @brief 运行时纹理图集：把多张小图打包到少量大纹理（页）中，让它们可以在同一批次中绘制。
+     *
+     * 使用 Skyline（bottom-left）算法装箱。build() 在 CPU 上生成页面 Surface，
+     * save()/loadIndex() 负责磁盘缓存，页面纹理的创建和句柄分配由 ResourceManager 完成。
+     * 区域按原始图片路径查找，路径为相对工作目录的 generic 形式（assets/textures/Props/crate.png），
+     * 与 LevelLoader 解析出的纹理 ID 一致。
+     */
+    class TextureAtlas final
+    {
+        friend class ResourceManager;
+
+    private:
+        struct SDLSurfaceDeleter
+        {
+            void operator()(SDL_Surface* surface) const
+            {
+                if (surface)
+                {
+                    SDL_DestroySurface(surface);
+                }
+            }
+        };
+
+        //打包结果：原图路径 + 所在页序号 + 页内矩形
+        struct PackedImage
+        {
+            std::string path;
+            int page = 0;
+            SDL_FRect rect = {0, 0, 0, 0};
+        };
+
+        std::vector<std::unique_ptr<SDL_Surface, SDLSurfaceDeleter>> page_surfaces_;   ///< @brief build() 生成的页面（上传后释放）
+        std::vector<std::string> page_files_;                                         ///< @brief loadIndex() 读取的页面图片路径
+        std::vector<PackedImage> images_;                                             ///< @brief 打包的图片
+        std::vector<std::string> sources_;                                            ///< @brief 参与打包判断的所有原图（含未打包的大图），用于缓存校验
+        std::unordered_map<std::string, AtlasRegion> regions_;                        ///< @brief 原图路径 -> 区域（页句柄分配后可用）
+
+    public:
+        TextureAtlas() = default;
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas(TextureAtlas&&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(TextureAtlas&&) = delete;
+
+        /// @brief 查找原图所在的图集区域，不在图集中返回 nullptr
+        const AtlasRegion* findRegion(const std::string& file_path) const;
+
+        size_t getPageCount() const { return page_surfaces_.empty() ? page_files_.size() : page_surfaces_.size(); }
+        size_t getImageCount() const { return images_.size(); }
+
+    private://仅允许ResourceManager访问
+        /// @brief 列出目录下的 png 图片（generic 路径，按名称排序）
+        static std::vector<std::string> collectSourceImages(const std::vector<std::string>& directories);
+
+        /// @brief 读取并打包图片，生成页面 Surface
+        bool build(const std::vector<std::string>& source_paths, const AtlasSettings& settings);
+
+        /// @brief 把页面写成 PNG，并写出索引 JSON（记录构建参数，参数变化时缓存失效）
+        bool save(const std::string& cache_path, const AtlasSettings& settings) const;
+
+        /// @brief 读取索引 JSON。原图列表、大小或修改时间与缓存不一致时返回 false（需要重建）
+        bool loadIndex(const std::string& cache_path, const std::vector<std::string>& source_paths, const AtlasSettings& settings);
+
+        /// @brief 页面纹理创建后登记句柄，生成查找表
+        void assignPages(const std::vector<TextureHandle>& page_handles);
+
+        /// @brief 释放 CPU 端的页面 Surface
+        void releaseSurfaces() { page_surfaces_.clear(); }
+
+        void clear();
+    };
+}
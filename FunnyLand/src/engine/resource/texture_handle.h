@@ -0,0 +1,15 @@
+﻿#pragma once
+#include <cstdint>
+
+namespace engine::resource
+{
+    /**
+     * @brief 纹理句柄：由 TextureManager 分配的稳定整数索引。
+     *
+     * 同一文件路径始终对应同一个句柄（卸载后重新加载也不变），
+     * 渲染时直接用它索引纹理数组，避免每次绘制都对字符串做哈希查找。
+     */
+    using TextureHandle = std::uint32_t;
+    
+    inline constexpr TextureHandle INVALID_TEXTURE_HANDLE = 0;   ///< @brief 无效句柄（0 号槽位保留不用）
+}
@@ -1,95 +1,356 @@
 ﻿#include "texture_manager.h"
+#include "async_loader.h"
+#include "asset_archive.h"
+#include "../core/memory_tracker.h"
 #include <SDL3_image/SDL_image.h>
+#include <array>
 #include <stdexcept>
 #include <spdlog/spdlog.h>
 
 namespace engine::resource
 {
-    TextureManager::TextureManager(SDL_Renderer* renderer)
-        :renderer_(renderer)
+    namespace
+    {
+        //后台解码得到的 SDL_Surface 的删除器
+        struct SDLSurfaceDeleter
+        {
+            void operator()(SDL_Surface* surface) const
+            {
+                SDL_DestroySurface(surface);
+            }
+        };
+        
+        using PendingSurface = PendingResource<SDL_Surface, SDLSurfaceDeleter>;
+    }
+    
+    TextureManager::TextureManager(SDL_Renderer* renderer, const AssetArchive& archive)
+        :renderer_(renderer), archive_(archive)
     {
         if (!renderer_)
         {
             //抛出异常 可以被GameApp中的 try-catch 捕获
             throw std::runtime_error("TextureManager 构造函数：渲染器不能为空");
         }
+        //0 号槽位保留给无效句柄
+        textures_.emplace_back();
+        createPlaceholder();
         //SDL3中不需要IMG_INI
         spdlog::trace("TextureManager 构造完成");
     }
 
-    SDL_Texture* TextureManager::loadTexture(const std::string& file_path)
+    SDL_Texture* TextureManager::loadTexture(const std::string& file_path, engine::core::MemoryTag owner)
     {
+        TextureHandle handle = acquireHandle(file_path);
+        
         //检查是否已加载
-        auto it = textures_.find(file_path);
-        if (it != textures_.end())
-            return it->second.get();
+        if (textures_[handle].texture)
+            return textures_[handle].texture.get();
         
-        //如果没加载到尝试加载纹理
-        SDL_Texture* raw_texture = IMG_LoadTexture(renderer_, file_path.c_str());
-        if (raw_texture == nullptr)
+        //如果没加载到尝试加载纹理（正在异步加载的直接改为同步加载）
+        cancelPending(textures_[handle]);
+        textures_[handle].info.memory_tag = owner;
+        return loadEntry(handle);
+    }
+
+    SDL_Texture* TextureManager::getTexture(const std::string& file_path, engine::core::MemoryTag owner)
+    {
+        //检查现有纹理
+        auto it = handles_.find(file_path);
+        if (it != handles_.end() && textures_[it->second].texture)
+            return textures_[it->second].texture.get();
+        
+        spdlog::warn("纹理未加载 {}", file_path);
+        return loadTexture(file_path, owner);
+    }
+
+    glm::vec2 TextureManager::getTextureSize(const std::string& file_path, engine::core::MemoryTag owner)
+    {
+        return getTextureSize(getTextureHandle(file_path, owner));
+    }
+
+    void TextureManager::unloadTexture(const std::string& file_path)
+    {
+        auto it = handles_.find(file_path);
+        if (it != handles_.end() && textures_[it->second].pending)
         {
-            spdlog::debug("纹理记载失败 {} : {}", file_path, SDL_GetError());
-            return nullptr;
+            spdlog::debug("取消异步加载纹理 {}", file_path);
+            cancelPending(textures_[it->second]);
         }
+        else if (it != handles_.end() && textures_[it->second].texture)
+        {
+            spdlog::debug("成功卸载纹理 {}", file_path);
+            releaseEntry(textures_[it->second]);//此处会走自定义删除器删除，句柄保留
+        }
+        else
+        {
+            spdlog::warn("尝试卸载，但纹理未加载 {}", file_path);
+        }
+    }
+
+    TextureHandle TextureManager::getTextureHandle(const std::string& file_path, engine::core::MemoryTag owner)
+    {
+        TextureHandle handle = acquireHandle(file_path);
+        if (textures_[handle].texture) return handle;
         
-        //加载到了正式存储
-        textures_.emplace(file_path, std::unique_ptr<SDL_Texture,SDLTextureDeleter>(raw_texture));
-        spdlog::debug("成功加载并缓存纹理 {}", file_path);
-        
-        return raw_texture;
-       
+        //调用者需要立即可用的纹理（例如要读取尺寸），正在异步加载的也同步完成
+        cancelPending(textures_[handle]);
+        textures_[handle].info.memory_tag = owner;
+        if (!loadEntry(handle))
+        {
+            return INVALID_TEXTURE_HANDLE;
+        }
+        return handle;
     }
 
-    SDL_Texture* TextureManager::getTexture(const std::string& file_path)
+    SDL_Texture* TextureManager::getTexture(TextureHandle handle)
     {
-        //检查现有纹理
-        auto it = textures_.find(file_path);
-        if (it != textures_.end())
-            return it->second.get();
+        if (handle == INVALID_TEXTURE_HANDLE || handle >= textures_.size())
+        {
+            return nullptr;
+        }
+        auto& entry = textures_[handle];
+        if (entry.texture)
+            return entry.texture.get();
+        if (entry.pending)
+            return placeholder_.get();//上传完成前绘制占位纹理，不阻塞
         
-        spdlog::warn("纹理未加载 {}", file_path);
-        return loadTexture(file_path);
+        spdlog::warn("纹理未加载 {}", entry.info.file_path);
+        return loadEntry(handle);
     }
 
-    glm::vec2 TextureManager::getTextureSize(const std::string& file_path)
+    glm::vec2 TextureManager::getTextureSize(TextureHandle handle)
     {
-        SDL_Texture* texture = getTexture(file_path);
-        if (!texture)
+        //异步加载中尚不知道真实尺寸，返回占位纹理的尺寸
+        if (handle < textures_.size() && textures_[handle].pending)
         {
-            spdlog::error("无法获取纹理 {}", file_path);
-            return {0,0};
+            return {1.0f, 1.0f};
         }
         
-        //获取纹理尺寸
-        glm::vec2 size;
-        if (!SDL_GetTextureSize(texture, &size.x, &size.y))
+        //未加载时 getTexture 会尝试重新加载并刷新元数据
+        if (!getTexture(handle))
         {
-            spdlog::error("获取纹理尺寸失败 {}", file_path);
+            spdlog::error("无法获取纹理 {}", getTexturePath(handle));
             return {0,0};
         }
-        return size;
+        
+        //直接使用加载时记录的尺寸
+        const auto& info = textures_[handle].info;
+        return {static_cast<float>(info.width), static_cast<float>(info.height)};
     }
 
-    void TextureManager::unloadTexture(const std::string& file_path)
+    const std::string& TextureManager::getTexturePath(TextureHandle handle) const
     {
-        auto it = textures_.find(file_path);
-        if (it != textures_.end())
+        //越界时返回 0 号槽位的空路径
+        if (handle >= textures_.size()) return textures_[INVALID_TEXTURE_HANDLE].info.file_path;
+        return textures_[handle].info.file_path;
+    }
+
+    const TextureInfo* TextureManager::getTextureInfo(TextureHandle handle) const
+    {
+        if (handle == INVALID_TEXTURE_HANDLE || handle >= textures_.size()) return nullptr;
+        return &textures_[handle].info;
+    }
+
+    void TextureManager::logMemoryReport() const
+    {
+        size_t loaded_count = 0;
+        std::array<size_t, engine::core::MemoryTracker::MAX_TAGS> tag_bytes{};
+        std::array<size_t, engine::core::MemoryTracker::MAX_TAGS> tag_counts{};
+        for (const auto& entry : textures_)
         {
-            spdlog::debug("成功卸载纹理 {}", file_path);
-            textures_.erase(it);//此处会走自定义删除器删除
+            if (!entry.texture) continue;
+            ++loaded_count;
+            const auto tag = entry.info.memory_tag < tag_bytes.size() ? entry.info.memory_tag : engine::core::memory_tags::GENERAL;
+            tag_bytes[tag] += entry.info.memory_bytes;
+            ++tag_counts[tag];
+            spdlog::info("纹理 {} : {}x{} {} {:.1f} KB [{}]", entry.info.file_path, entry.info.width, entry.info.height,
+                         SDL_GetPixelFormatName(entry.info.format), static_cast<double>(entry.info.memory_bytes) / 1024.0,
+                         engine::core::MemoryTracker::getTagName(tag));
         }
-        else
+        spdlog::info("共 {} 个纹理，显存占用约 {:.2f} MB", loaded_count,
+                     static_cast<double>(total_memory_bytes_) / (1024.0 * 1024.0));
+        //按发起加载的场景汇总
+        for (size_t tag = 0; tag < tag_bytes.size(); ++tag)
         {
-            spdlog::warn("尝试卸载，但纹理未加载 {}", file_path);
+            if (tag_counts[tag] == 0) continue;
+            spdlog::info("  {:<24} {} 个纹理，约 {:.2f} MB", engine::core::MemoryTracker::getTagName(static_cast<engine::core::MemoryTag>(tag)),
+                         tag_counts[tag], static_cast<double>(tag_bytes[tag]) / (1024.0 * 1024.0));
         }
     }
 
     void TextureManager::clearTextures()
     {
-        if (!textures_.empty())
+        size_t loaded_count = 0;
+        for (auto& entry : textures_)
+        {
+            cancelPending(entry);
+            if (entry.texture)
+            {
+                releaseEntry(entry);
+                ++loaded_count;
+            }
+        }
+        if (loaded_count > 0)
+        {
+            spdlog::debug("正在清理{}个纹理", loaded_count);
+        }
+    }
+
+    TextureHandle TextureManager::loadTextureAsync(const std::string& file_path, engine::core::MemoryTag owner, AsyncLoader& loader)
+    {
+        TextureHandle handle = acquireHandle(file_path);
+        auto& entry = textures_[handle];
+        if (entry.texture || entry.pending)
+            return handle;
+        
+        entry.pending = true;
+        entry.info.memory_tag = owner;
+        const std::uint32_t generation = ++entry.load_generation;
+        loader.enqueue([this, &loader, handle, generation, path = file_path]()
+        {
+            //工作线程：只做磁盘读取和解码，不访问渲染器和 textures_
+            auto surface = std::make_shared<PendingSurface>(loadSurface(path));
+            std::string error = surface->get() ? std::string() : std::string(SDL_GetError());
+            
+            loader.postUpload([this, handle, generation, surface, error = std::move(error)]()
+            {
+                //主线程：创建纹理。期间被卸载、清空或同步加载过的，结果已过期
+                auto& entry = textures_[handle];
+                if (!entry.pending || entry.load_generation != generation)
+                    return;
+                entry.pending = false;
+                if (!surface->get())
+                {
+                    spdlog::error("异步加载纹理失败 {} : {}", entry.info.file_path, error);
+                    return;
+                }
+                SDL_Texture* raw_texture = SDL_CreateTextureFromSurface(renderer_, surface->get());
+                if (!raw_texture)
+                {
+                    spdlog::error("异步加载纹理 {} 创建纹理失败: {}", entry.info.file_path, SDL_GetError());
+                    return;
+                }
+                storeEntry(entry, raw_texture);
+            });
+        });
+        spdlog::debug("开始异步加载纹理 {}", file_path);
+        return handle;
+    }
+
+    bool TextureManager::isTextureReady(TextureHandle handle) const
+    {
+        return handle != INVALID_TEXTURE_HANDLE && handle < textures_.size() && textures_[handle].texture;
+    }
+
+    bool TextureManager::isTextureLoading(TextureHandle handle) const
+    {
+        return handle < textures_.size() && textures_[handle].pending;
+    }
+
+    TextureHandle TextureManager::adoptTexture(const std::string& file_path, SDL_Texture* texture)
+    {
+        TextureHandle handle = acquireHandle(file_path);
+        auto& entry = textures_[handle];
+        cancelPending(entry);
+        if (entry.texture) releaseEntry(entry);
+        entry.info.memory_tag = engine::core::memory_tags::TEXTURES;   //图集页面由所有场景共用
+        storeEntry(entry, texture);
+        return handle;
+    }
+
+    TextureHandle TextureManager::acquireHandle(const std::string& file_path)
+    {
+        auto it = handles_.find(file_path);
+        if (it != handles_.end())
+            return it->second;
+        
+        //新路径分配新槽位，句柄即下标
+        auto handle = static_cast<TextureHandle>(textures_.size());
+        TextureEntry entry;
+        entry.info.file_path = file_path;
+        textures_.push_back(std::move(entry));
+        handles_.emplace(file_path, handle);
+        return handle;
+    }
+
+    SDL_Texture* TextureManager::loadEntry(TextureHandle handle)
+    {
+        auto& entry = textures_[handle];
+        SDL_Surface* surface = loadSurface(entry.info.file_path);
+        if (surface == nullptr)
+        {
+            spdlog::debug("纹理记载失败 {} : {}", entry.info.file_path, SDL_GetError());
+            return nullptr;
+        }
+        SDL_Texture* raw_texture = SDL_CreateTextureFromSurface(renderer_, surface);
+        SDL_DestroySurface(surface);
+        if (raw_texture == nullptr)
+        {
+            spdlog::debug("纹理创建失败 {} : {}", entry.info.file_path, SDL_GetError());
+            return nullptr;
+        }
+        
+        storeEntry(entry, raw_texture);
+        return raw_texture;
+    }
+
+    SDL_Surface* TextureManager::loadSurface(const std::string& file_path) const
+    {
+        if (const ArchiveEntry* packed = archive_.find(file_path))
+        {
+            //资源包中是预解码的像素，不需要再解码 PNG
+            if (packed->type == ArchiveEntryType::Texture)
+                return AssetArchive::createSurface(*packed);
+            return IMG_Load_IO(SDL_IOFromConstMem(packed->data, packed->size), true);
+        }
+        return IMG_Load(file_path.c_str());
+    }
+
+    void TextureManager::storeEntry(TextureEntry& entry, SDL_Texture* raw_texture)
+    {
+        //加载到了正式存储
+        entry.texture.reset(raw_texture);
+        
+        //只在加载时读取一次尺寸和格式，之后所有查询都走记录
+        entry.info.width = raw_texture->w;
+        entry.info.height = raw_texture->h;
+        entry.info.format = raw_texture->format;
+        entry.info.memory_bytes = static_cast<size_t>(raw_texture->w) * static_cast<size_t>(raw_texture->h) *
+                                  static_cast<size_t>(SDL_BYTESPERPIXEL(raw_texture->format));
+        total_memory_bytes_ += entry.info.memory_bytes;
+        engine::core::MemoryTracker::addResource(entry.info.memory_tag, static_cast<std::int64_t>(entry.info.memory_bytes));
+        spdlog::debug("成功加载并缓存纹理 {} ({}x{})，记入 '{}'", entry.info.file_path, entry.info.width, entry.info.height,
+                      engine::core::MemoryTracker::getTagName(entry.info.memory_tag));
+    }
+
+    void TextureManager::releaseEntry(TextureEntry& entry)
+    {
+        if (entry.texture)
+        {
+            engine::core::MemoryTracker::addResource(entry.info.memory_tag, -static_cast<std::int64_t>(entry.info.memory_bytes), -1);
+        }
+        entry.texture.reset();
+        total_memory_bytes_ -= entry.info.memory_bytes;
+        entry.info.memory_bytes = 0;
+    }
+
+    void TextureManager::cancelPending(TextureEntry& entry)
+    {
+        if (!entry.pending) return;
+        entry.pending = false;
+        ++entry.load_generation;//后台结果到达时会因代数不符被丢弃
+    }
+
+    void TextureManager::createPlaceholder()
+    {
+        SDL_Texture* raw_texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+        if (!raw_texture)
         {
-            spdlog::debug("正在清理{}个纹理", textures_.size());
-            textures_.clear();
+            spdlog::warn("创建占位纹理失败，异步加载中的纹理将不绘制: {}", SDL_GetError());
+            return;
         }
+        const Uint32 magenta = 0xFF00FFFF;
+        SDL_UpdateTexture(raw_texture, nullptr, &magenta, sizeof(magenta));
+        placeholder_.reset(raw_texture);
     }
 }
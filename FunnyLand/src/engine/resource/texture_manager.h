@@ -1,18 +1,43 @@
 ﻿#pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <glm/vec2.hpp>
 #include <SDL3/SDL_render.h>
+#include "texture_handle.h"
+#include "../core/memory_tracker.h"
 
 struct SDL_Renderer;
 namespace engine::resource
 {
+    class AsyncLoader;
+    class AssetArchive;
+    
+/**
+ * @brief 纹理加载时记录的元数据，尺寸查询和显存统计都从这里读取，热路径不再调用 SDL。
+ */
+struct TextureInfo
+{
+    std::string file_path;                                  ///< @brief 纹理文件路径
+    int width = 0;                                          ///< @brief 宽度（像素）
+    int height = 0;                                         ///< @brief 高度（像素）
+    SDL_PixelFormat format = SDL_PIXELFORMAT_UNKNOWN;       ///< @brief 像素格式
+    size_t memory_bytes = 0;                                ///< @brief 估算的显存占用（字节），未加载时为 0
+    engine::core::MemoryTag memory_tag = engine::core::memory_tags::TEXTURES; ///< @brief 显存记在哪个标签上（发起加载的场景，场景外加载的为 TEXTURES）
+};
     
 /**
  * @brief 管理 SDL_Texture 资源的加载、存储和检索。
  *
  * 在构造时初始化。使用文件路径作为键，确保纹理只加载一次并正确释放。
+ * 每个路径第一次出现时分配一个稳定的 TextureHandle，纹理按句柄存放在连续数组中，
+ * 热路径（渲染）可以用句柄直接索引，字符串接口保留给加载和工具使用。
+ * loadTextureAsync() 在后台线程解码图片，主线程上传前按句柄获取到的是占位纹理；
+ * 同步接口（字符串接口、getTextureHandle）遇到仍在异步加载的纹理会直接同步加载。
+ * 挂载了资源包时优先使用包中预解码的像素，不在包中的纹理仍从磁盘文件加载。
+ * 显存登记在加载请求传入的标签（发起加载的场景）上，卸载时从同一标签扣除；卸载后按句柄重新加载的仍记在原标签上。
  * 依赖于一个有效的 SDL_Renderer，构造失败会抛出异常。
  */
 class TextureManager final
@@ -32,15 +57,27 @@ private:
         }
     };
     
-    //纹理存储路径和指向纹理管理器的智能指针
-    std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> textures_;
+    //纹理槽位：句柄即下标。卸载时只释放纹理，路径保留，句柄不会被其它路径复用
+    struct TextureEntry
+    {
+        std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture;   ///< @brief 纹理（未加载或已卸载时为空）
+        TextureInfo info;                                           ///< @brief 路径、尺寸、格式和显存占用
+        bool pending = false;                                       ///< @brief 是否正在异步加载
+        std::uint32_t load_generation = 0;                          ///< @brief 每次发起或取消异步加载时递增，过期的结果直接丢弃
+    };
+    
+    std::vector<TextureEntry> textures_;                              ///< @brief 按句柄索引的纹理数组（0 号为无效句柄占位）
+    std::unordered_map<std::string, TextureHandle> handles_;          ///< @brief 文件路径 -> 句柄
+    size_t total_memory_bytes_ = 0;                                   ///< @brief 当前已加载纹理的显存占用总和
+    std::unique_ptr<SDL_Texture, SDLTextureDeleter> placeholder_;     ///< @brief 异步加载完成前使用的 1x1 占位纹理
     
     SDL_Renderer* renderer_ = nullptr;//指向主渲染器的非拥有指针
+    const AssetArchive& archive_;     //资源包（未挂载时所有查找都落空）
     
     
     
 public:
-    explicit  TextureManager(SDL_Renderer* renderer);
+    TextureManager(SDL_Renderer* renderer, const AssetArchive& archive);
     
     //只需要一个实例
     TextureManager(const TextureManager&) = delete;
@@ -50,13 +87,33 @@ public:
     
 private://仅允许ResourceManager访问
     
-    SDL_Texture* loadTexture(const std::string& file_path);
-    SDL_Texture* getTexture(const std::string& file_path);
-    glm::vec2 getTextureSize(const std::string& file_path);
+    //owner: 新加载的纹理显存记在哪个标签上，已加载的纹理不改变归属
+    SDL_Texture* loadTexture(const std::string& file_path, engine::core::MemoryTag owner);
+    SDL_Texture* getTexture(const std::string& file_path, engine::core::MemoryTag owner);
+    glm::vec2 getTextureSize(const std::string& file_path, engine::core::MemoryTag owner);
     void unloadTexture(const std::string& file_path);
+    
+    TextureHandle getTextureHandle(const std::string& file_path, engine::core::MemoryTag owner);   //获取路径对应的句柄，未加载会尝试加载，失败返回 INVALID_TEXTURE_HANDLE
+    SDL_Texture* getTexture(TextureHandle handle);                  //按句柄获取纹理，已卸载的会按记录的路径重新加载
+    glm::vec2 getTextureSize(TextureHandle handle);                 //按句柄获取纹理大小
+    const std::string& getTexturePath(TextureHandle handle) const;  //按句柄获取文件路径（用于日志）
+    const TextureInfo* getTextureInfo(TextureHandle handle) const;  //按句柄获取纹理元数据，无效句柄返回 nullptr
+    size_t getTotalMemoryBytes() const { return total_memory_bytes_; } //获取已加载纹理的显存占用总和
+    void logMemoryReport() const;                                   //输出每个已加载纹理的尺寸、格式、显存占用和归属，以及按标签（场景）的合计
     void clearTextures();//清除所有纹理
     
+    TextureHandle loadTextureAsync(const std::string& file_path, engine::core::MemoryTag owner, AsyncLoader& loader); //在后台加载纹理，立即返回句柄
+    bool isTextureReady(TextureHandle handle) const;                //句柄对应的纹理是否已上传（不会触发加载）
+    bool isTextureLoading(TextureHandle handle) const;              //句柄对应的纹理是否仍在异步加载
+    TextureHandle adoptTexture(const std::string& file_path, SDL_Texture* texture); //接管外部创建的纹理（例如图集页面），登记到路径对应的句柄
     
+    TextureHandle acquireHandle(const std::string& file_path);      //获取或分配路径对应的句柄（不加载纹理）
+    SDL_Texture* loadEntry(TextureHandle handle);                   //加载句柄对应槽位的纹理（显存记在槽位记录的标签上）
+    SDL_Surface* loadSurface(const std::string& file_path) const;   //读取图片像素：资源包中的直接引用映射内存，否则从磁盘解码（可在工作线程调用）
+    void releaseEntry(TextureEntry& entry);                         //释放槽位中的纹理并扣除显存统计
+    void cancelPending(TextureEntry& entry);                        //取消槽位上进行中的异步加载
+    void storeEntry(TextureEntry& entry, SDL_Texture* raw_texture); //把纹理放入槽位并记录元数据
+    void createPlaceholder();                                       //创建占位纹理
     
 };
 }
\ No newline at end of file
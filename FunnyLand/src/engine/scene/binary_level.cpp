@@ -0,0 +1,466 @@
+#include "binary_level.h"
+#include "tiled_map_parser.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene
+{
+    namespace
+    {
+        //顺序写入二进制关卡
+        class LevelWriter
+        {
+        public:
+            explicit LevelWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+            template <typename T>
+            void put(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+                out_.insert(out_.end(), bytes, bytes + sizeof(T));
+            }
+
+            void putString(std::string_view value)
+            {
+                put(static_cast<std::uint32_t>(value.size()));
+                out_.insert(out_.end(), value.begin(), value.end());
+            }
+
+            void align(size_t alignment)
+            {
+                out_.resize((out_.size() + alignment - 1) / alignment * alignment, 0);
+            }
+
+        private:
+            std::vector<std::uint8_t>& out_;
+        };
+
+        bool readJson(const std::string& file_path, nlohmann::json& json_data)
+        {
+            std::ifstream file(file_path);
+            if (!file.is_open())
+            {
+                spdlog::error("无法打开文件: {}", file_path);
+                return false;
+            }
+            try
+            {
+                file >> json_data;
+            }
+            catch (const nlohmann::json::parse_error& e)
+            {
+                spdlog::error("解析文件 {} 时出错: {}", file_path, e.what());
+                return false;
+            }
+            return true;
+        }
+
+        //图块集：与 LevelLoader::loadTileset 读取的字段一致
+        bool writeTileset(LevelWriter& writer, const std::string& tileset_path, std::uint32_t first_gid)
+        {
+            nlohmann::json json_data;
+            if (!readJson(tileset_path, json_data)) return false;
+
+            const int columns = json_data.value("columns", 0);
+            writer.put(first_gid);
+            writer.put(json_data.value("tilecount", 0u));
+            writer.put(static_cast<std::int32_t>(columns));
+            writer.put(json_data.value("tilewidth", 0.0f));
+            writer.put(json_data.value("tileheight", 0.0f));
+            writer.put(static_cast<std::int32_t>(json_data.value("margin", 0)));
+            writer.put(static_cast<std::int32_t>(json_data.value("spacing", 0)));
+            writer.putString(columns > 0 ? resolveLevelPath(json_data.value("image", ""), tileset_path) : std::string());
+
+            std::vector<const nlohmann::json*> images;
+            if (columns == 0 && json_data.contains("tiles") && json_data["tiles"].is_array())
+            {
+                for (const auto& tile_json : json_data["tiles"])
+                {
+                    if (tile_json.contains("image")) images.push_back(&tile_json);
+                }
+            }
+            writer.put(static_cast<std::uint32_t>(images.size()));
+            for (const auto* tile_json : images)
+            {
+                writer.put(tile_json->value("id", 0u));
+                writer.putString(resolveLevelPath((*tile_json)["image"].get<std::string>(), tileset_path));
+                writer.put(tile_json->value("imagewidth", 0.0f));
+                writer.put(tile_json->value("imageheight", 0.0f));
+                //子矩形，宽度为 0 表示整张图片
+                const auto source_rect = readTileSourceRect(*tile_json);
+                writer.put(source_rect ? *source_rect : SDL_FRect{0, 0, 0, 0});
+            }
+            return true;
+        }
+
+        void writeObject(LevelWriter& writer, const LevelObjectRecord& object)
+        {
+            writer.put(object.id);
+            writer.put(object.gid);
+            writer.put(object.position.x);
+            writer.put(object.position.y);
+            writer.put(object.size.x);
+            writer.put(object.size.y);
+            writer.put(object.rotation);
+            writer.put(static_cast<std::uint32_t>(object.visible));
+            writer.putString(object.name);
+            writer.putString(object.type);
+            writer.put(static_cast<std::uint32_t>(object.properties.size()));
+            for (const auto& [name, value] : object.properties)
+            {
+                writer.putString(name);
+                writer.putString(value);
+            }
+        }
+
+        //写入一个可见图层，跳过的图层返回 false。map_json 为解析到该图层时的地图字段（用于缺省的图层尺寸）
+        bool writeLayer(LevelWriter& writer, const TiledLayerData& layer, const nlohmann::json& map_json, const std::string& map_path)
+        {
+            const auto& layer_json = layer.info;
+            if (!layer_json.value("visible", true)) return false;
+            const std::string layer_type = layer_json.value("type", "none");
+            const std::string layer_name = layer_json.value("name", "Unnamed");
+            LevelLayerType type;
+            if (layer_type == "imagelayer")
+            {
+                if (layer_json.value("image", "").empty())
+                {
+                    spdlog::error("图层 '{}' 缺少 'image' 属性。", layer_name);
+                    return false;
+                }
+                type = LevelLayerType::Image;
+            }
+            else if (layer_type == "tilelayer")
+            {
+                if (layer.gids.empty() && layer.chunks.empty())
+                {
+                    spdlog::error("图块图层 '{}' 缺少 'data' 数据。", layer_name);
+                    return false;
+                }
+                type = layer.chunks.empty() ? LevelLayerType::Tile : LevelLayerType::ChunkedTile;
+            }
+            else if (layer_type == "objectgroup")
+            {
+                type = LevelLayerType::Object;
+            }
+            else
+            {
+                spdlog::warn("未知图层类型 {}，跳过转换", layer_type);
+                return false;
+            }
+
+            writer.align(alignof(std::uint32_t));//图层记录按 4 字节对齐
+            writer.put(type);
+            writer.putString(layer_name);
+            writer.put(layer_json.value("offsetx", 0.0f));
+            writer.put(layer_json.value("offsety", 0.0f));
+            switch (type)
+            {
+            case LevelLayerType::Image:
+                writer.putString(resolveLevelPath(layer_json["image"].get<std::string>(), map_path));
+                writer.put(layer_json.value("parallaxx", 1.0f));
+                writer.put(layer_json.value("parallaxy", 1.0f));
+                writer.put(static_cast<std::uint8_t>(layer_json.value("repeatx", false)));
+                writer.put(static_cast<std::uint8_t>(layer_json.value("repeaty", false)));
+                break;
+            case LevelLayerType::Tile:
+                writer.put(static_cast<std::int32_t>(layer_json.value("width", map_json.value("width", 0))));
+                writer.put(static_cast<std::int32_t>(layer_json.value("height", map_json.value("height", 0))));
+                writer.put(static_cast<std::uint32_t>(layer.gids.size()));
+                writer.align(alignof(std::uint32_t));
+                for (const std::uint32_t gid : layer.gids)
+                {
+                    writer.put(gid);
+                }
+                break;
+            case LevelLayerType::ChunkedTile:
+            {
+                //Tiled 导出的区块尺寸相同（默认 16x16），取最大值作为图层的区块尺寸
+                glm::ivec2 chunk_size = {0, 0};
+                for (const auto& chunk : layer.chunks) chunk_size = glm::max(chunk_size, chunk.size);
+                writer.put(static_cast<std::int32_t>(chunk_size.x));
+                writer.put(static_cast<std::int32_t>(chunk_size.y));
+                writer.put(static_cast<std::uint32_t>(layer.chunks.size()));
+                for (const auto& chunk : layer.chunks)
+                {
+                    writer.put(static_cast<std::int32_t>(chunk.position.x));
+                    writer.put(static_cast<std::int32_t>(chunk.position.y));
+                    writer.put(static_cast<std::int32_t>(chunk.size.x));
+                    writer.put(static_cast<std::int32_t>(chunk.size.y));
+                    writer.align(alignof(std::uint32_t));
+                    //解码失败的区块写入空图块，保持数量与尺寸一致
+                    const size_t tile_count = static_cast<size_t>(std::max(chunk.size.x, 0)) * static_cast<size_t>(std::max(chunk.size.y, 0));
+                    for (size_t i = 0; i < tile_count; ++i)
+                    {
+                        writer.put(i < chunk.gids.size() ? chunk.gids[i] : 0u);
+                    }
+                }
+                break;
+            }
+            case LevelLayerType::Object:
+            {
+                const bool has_objects = layer_json.contains("objects") && layer_json["objects"].is_array();
+                writer.put(static_cast<std::uint32_t>(has_objects ? layer_json["objects"].size() : 0));
+                if (has_objects)
+                {
+                    for (const auto& object_json : layer_json["objects"]) writeObject(writer, parseTiledObject(object_json));
+                }
+                break;
+            }
+            }
+            return true;
+        }
+    }
+
+    std::string resolveLevelPath(const std::string& relative_path, const std::string& file_path)
+    {
+        // “assets/maps/level1.tmj” + “../textures/a.png” -> “assets/textures/a.png”
+        const auto base_dir = std::filesystem::path(file_path).parent_path();
+        return (base_dir / relative_path).lexically_normal().generic_string();
+    }
+
+    bool convertTiledLevel(const std::string& map_path, std::vector<std::uint8_t>& out)
+    {
+        //图层在地图字段（tilesets 等）之前解析到，先写入单独的缓冲，最后拼在图块集之后
+        std::vector<std::uint8_t> layer_data;
+        LevelWriter layer_writer(layer_data);
+        std::uint32_t layer_count = 0;
+        nlohmann::json json_data;
+        const bool parsed = parseTiledMap(map_path, nullptr, json_data,
+            [&](const nlohmann::json& partial_map_json, TiledLayerData& layer)
+            {
+                if (writeLayer(layer_writer, layer, partial_map_json, map_path)) ++layer_count;
+                return true;
+            });
+        if (!parsed) return false;
+
+        out.clear();
+        LevelWriter writer(out);
+        LevelFileHeader header{};
+        std::memcpy(header.magic, LEVEL_MAGIC, sizeof(header.magic));
+        header.version = LEVEL_VERSION;
+        header.map_width = json_data.value("width", 0);
+        header.map_height = json_data.value("height", 0);
+        header.tile_width = json_data.value("tilewidth", 0.0f);
+        header.tile_height = json_data.value("tileheight", 0.0f);
+        header.layer_count = layer_count;
+        header.flags = json_data.value("infinite", false) ? LEVEL_FLAG_INFINITE : 0u;
+        writer.put(header);//图块集计数在最后回填
+
+        //1. 图块集（按 first_gid 升序写入，加载时不再排序）
+        std::vector<std::pair<std::uint32_t, std::string>> tileset_refs;
+        if (json_data.contains("tilesets") && json_data["tilesets"].is_array())
+        {
+            for (const auto& tileset_json : json_data["tilesets"])
+            {
+                if (!tileset_json.contains("source") || !tileset_json.contains("firstgid"))
+                {
+                    spdlog::error("地图 {} 中的图块集缺少 'source' 或 'firstgid'（不支持内嵌图块集）", map_path);
+                    continue;
+                }
+                tileset_refs.emplace_back(tileset_json["firstgid"].get<std::uint32_t>(),
+                                          resolveLevelPath(tileset_json["source"].get<std::string>(), map_path));
+            }
+        }
+        std::sort(tileset_refs.begin(), tileset_refs.end());
+        for (const auto& [first_gid, tileset_path] : tileset_refs)
+        {
+            if (writeTileset(writer, tileset_path, first_gid)) ++header.tileset_count;
+        }
+
+        //2. 图层（只写入了可见图层）。图层缓冲内的对齐是相对缓冲开头的，拼接前先把输出对齐
+        writer.align(alignof(std::uint32_t));
+        out.insert(out.end(), layer_data.begin(), layer_data.end());
+
+        std::memcpy(out.data(), &header, sizeof(header));
+        return true;
+    }
+
+    bool isBinaryLevel(const std::uint8_t* data, size_t size)
+    {
+        return size >= sizeof(LevelFileHeader) && std::memcmp(data, LEVEL_MAGIC, sizeof(LEVEL_MAGIC)) == 0;
+    }
+
+    // ------------------------------ BinaryLevelReader ------------------------------
+
+    const std::uint8_t* BinaryLevelReader::take(size_t bytes)
+    {
+        if (!ok_ || bytes > size_ - cursor_)
+        {
+            ok_ = false;
+            return nullptr;
+        }
+        const std::uint8_t* result = data_ + cursor_;
+        cursor_ += bytes;
+        return result;
+    }
+
+    template <typename T>
+    T BinaryLevelReader::read()
+    {
+        T value{};
+        if (const std::uint8_t* bytes = take(sizeof(T)))
+        {
+            std::memcpy(&value, bytes, sizeof(T));
+        }
+        return value;
+    }
+
+    std::string_view BinaryLevelReader::readString()
+    {
+        const auto length = read<std::uint32_t>();
+        const std::uint8_t* bytes = take(length);
+        return bytes ? std::string_view(reinterpret_cast<const char*>(bytes), length) : std::string_view();
+    }
+
+    void BinaryLevelReader::align(size_t alignment)
+    {
+        const size_t aligned = (cursor_ + alignment - 1) / alignment * alignment;
+        take(aligned - cursor_);
+    }
+
+    bool BinaryLevelReader::readHeader(LevelFileHeader& header)
+    {
+        header = read<LevelFileHeader>();
+        if (!ok_ || std::memcmp(header.magic, LEVEL_MAGIC, sizeof(header.magic)) != 0)
+        {
+            spdlog::error("不是二进制关卡数据");
+            return ok_ = false;
+        }
+        if (header.version != LEVEL_VERSION)
+        {
+            spdlog::error("二进制关卡版本 {} 与引擎版本 {} 不一致，请重新转换", header.version, LEVEL_VERSION);
+            return ok_ = false;
+        }
+        return true;
+    }
+
+    bool BinaryLevelReader::readTileset(engine::component::TileSetInfo& tileset)
+    {
+        tileset.first_gid = read<std::uint32_t>();
+        tileset.tile_count = read<std::uint32_t>();
+        tileset.columns = read<std::int32_t>();
+        tileset.tile_size.x = read<float>();
+        tileset.tile_size.y = read<float>();
+        tileset.margin = read<std::int32_t>();
+        tileset.spacing = read<std::int32_t>();
+        tileset.image_id = readString();
+
+        const auto image_count = read<std::uint32_t>();
+        for (std::uint32_t i = 0; i < image_count && ok_; ++i)
+        {
+            const auto id = read<std::uint32_t>();
+            engine::component::TileSetInfo::TileImage image;
+            image.image_id = readString();
+            image.size.x = read<float>();
+            image.size.y = read<float>();
+            const auto source_rect = read<SDL_FRect>();
+            if (source_rect.w > 0.0f) image.source_rect = source_rect;
+            tileset.images.emplace(id, std::move(image));
+        }
+        return ok_;
+    }
+
+    bool BinaryLevelReader::readLayerInfo(LevelLayerInfo& layer)
+    {
+        align(alignof(std::uint32_t));
+        layer.type = read<LevelLayerType>();
+        layer.name = readString();
+        layer.offset.x = read<float>();
+        layer.offset.y = read<float>();
+        return ok_;
+    }
+
+    bool BinaryLevelReader::readImageLayer(std::string_view& image_id, glm::vec2& scroll_factor, glm::bvec2& repeat)
+    {
+        image_id = readString();
+        scroll_factor.x = read<float>();
+        scroll_factor.y = read<float>();
+        repeat.x = read<std::uint8_t>() != 0;
+        repeat.y = read<std::uint8_t>() != 0;
+        return ok_;
+    }
+
+    bool BinaryLevelReader::readTileLayer(glm::ivec2& layer_size, std::vector<std::uint32_t>& gids)
+    {
+        layer_size.x = read<std::int32_t>();
+        layer_size.y = read<std::int32_t>();
+        const auto gid_count = read<std::uint32_t>();
+        align(alignof(std::uint32_t));
+        if (!ok_ || gid_count > (size_ - cursor_) / sizeof(std::uint32_t))
+        {
+            return ok_ = false;
+        }
+        //gid 数组按原样整体拷贝
+        const std::uint8_t* bytes = take(static_cast<size_t>(gid_count) * sizeof(std::uint32_t));
+        gids.resize(gid_count);
+        std::memcpy(gids.data(), bytes, static_cast<size_t>(gid_count) * sizeof(std::uint32_t));
+        return true;
+    }
+
+    bool BinaryLevelReader::readChunkedTileLayer(glm::ivec2& chunk_size, std::vector<LevelChunkRecord>& chunks)
+    {
+        chunk_size.x = read<std::int32_t>();
+        chunk_size.y = read<std::int32_t>();
+        const auto chunk_count = read<std::uint32_t>();
+        chunks.clear();
+        for (std::uint32_t i = 0; i < chunk_count && ok_; ++i)
+        {
+            LevelChunkRecord chunk;
+            chunk.position.x = read<std::int32_t>();
+            chunk.position.y = read<std::int32_t>();
+            chunk.size.x = read<std::int32_t>();
+            chunk.size.y = read<std::int32_t>();
+            align(alignof(std::uint32_t));
+            if (!ok_ || chunk.size.x < 0 || chunk.size.y < 0 || chunk.size.x > chunk_size.x || chunk.size.y > chunk_size.y)
+            {
+                return ok_ = false;
+            }
+            //区块 gid 不拷贝，由 LevelStreamer 在载入区块时再拷贝
+            const size_t tile_count = static_cast<size_t>(chunk.size.x) * static_cast<size_t>(chunk.size.y);
+            if (tile_count > (size_ - cursor_) / sizeof(std::uint32_t))
+            {
+                return ok_ = false;
+            }
+            chunk.gids = take(tile_count * sizeof(std::uint32_t));
+            chunks.push_back(chunk);
+        }
+        return ok_;
+    }
+
+    bool BinaryLevelReader::readObjectLayer(std::vector<LevelObjectRecord>& objects)
+    {
+        const auto object_count = read<std::uint32_t>();
+        objects.clear();
+        objects.reserve(std::min<size_t>(object_count, size_ - cursor_));//数量被破坏时不按它分配
+        for (std::uint32_t i = 0; i < object_count && ok_; ++i)
+        {
+            LevelObjectRecord object;
+            object.id = read<std::uint32_t>();
+            object.gid = read<std::uint32_t>();
+            object.position.x = read<float>();
+            object.position.y = read<float>();
+            object.size.x = read<float>();
+            object.size.y = read<float>();
+            object.rotation = read<float>();
+            object.visible = read<std::uint32_t>() != 0;
+            object.name = readString();
+            object.type = readString();
+            const auto property_count = read<std::uint32_t>();
+            for (std::uint32_t p = 0; p < property_count && ok_; ++p)
+            {
+                const auto name = readString();
+                const auto value = readString();
+                object.properties.emplace_back(name, value);
+            }
+            objects.push_back(std::move(object));
+        }
+        return ok_;
+    }
+}
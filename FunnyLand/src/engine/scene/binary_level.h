@@ -0,0 +1,130 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "../component/tile_layer_component.h"
+
+namespace engine::scene
+{
+    /*
+     * 二进制关卡格式（小端）：由 convertTiledLevel() 从 Tiled 的 tmj/tsj 生成，
+     * 图块集内嵌、图片路径已解析、图块数据为原始 uint32 数组，加载时顺序读取，不构建 JSON DOM。
+     *
+     * [LevelFileHeader]
+     * [图块集 * tileset_count]  first_gid tile_count columns tile_size margin spacing image_id 图片数 {id image_id size source_rect}*
+     * [图层 * layer_count]      type name offset + 按类型：
+     *     Image:       image_id scroll_factor repeat
+     *     Tile:        size gid 数 (对齐到 4 字节) uint32[]
+     *     ChunkedTile: chunk_size 区块数 {position size (对齐到 4 字节) uint32[size.x * size.y]}*
+     *     Object:      对象数 {id gid position size rotation visible name type 属性数 {name value}*}*
+     * 字符串为 uint32 长度 + 字节（无结尾 0）。只写入可见图层。
+     */
+
+    inline constexpr char LEVEL_MAGIC[4] = {'F', 'L', 'L', 'V'};
+    inline constexpr std::uint32_t LEVEL_VERSION = 3;
+    inline constexpr const char* BINARY_LEVEL_EXTENSION = ".flvl";
+    
+    inline constexpr std::uint32_t LEVEL_FLAG_INFINITE = 1u << 0;   ///< @brief 无限地图：图块图层按区块存储，运行时由 LevelStreamer 按需载入
+
+    /// @brief 二进制关卡文件头
+    struct LevelFileHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::int32_t map_width;         ///< @brief 地图尺寸（图块数）
+        std::int32_t map_height;
+        float tile_width;               ///< @brief 图块尺寸（像素）
+        float tile_height;
+        std::uint32_t tileset_count;
+        std::uint32_t layer_count;
+        std::uint32_t flags;            ///< @brief LEVEL_FLAG_* 的组合
+    };
+
+    enum class LevelLayerType : std::uint32_t
+    {
+        Image = 0,
+        Tile = 1,
+        Object = 2,
+        ChunkedTile = 3,                ///< @brief 无限地图的图块图层
+    };
+
+    /// @brief 图层公共信息
+    struct LevelLayerInfo
+    {
+        LevelLayerType type = LevelLayerType::Image;
+        std::string_view name;
+        glm::vec2 offset = {0.0f, 0.0f};
+    };
+
+    /// @brief 无限地图图块图层中的一个区块（gid 指向关卡数据，不拷贝）
+    struct LevelChunkRecord
+    {
+        glm::ivec2 position = {0, 0};           ///< @brief 左上角的图块坐标（可以为负）
+        glm::ivec2 size = {0, 0};               ///< @brief 尺寸（图块数）
+        const std::uint8_t* gids = nullptr;     ///< @brief size.x * size.y 个小端 uint32，按 4 字节对齐
+    };
+
+    /// @brief 对象图层中的一个对象（二进制关卡和 Tiled JSON 共用）
+    struct LevelObjectRecord
+    {
+        std::uint32_t id = 0;
+        std::uint32_t gid = 0;                  ///< @brief 图块对象的 gid（含翻转标志位），0 表示非图块对象
+        glm::vec2 position = {0.0f, 0.0f};      ///< @brief Tiled 中的位置（图块对象为左下角）
+        glm::vec2 size = {0.0f, 0.0f};
+        float rotation = 0.0f;
+        bool visible = true;
+        std::string name;
+        std::string type;
+        std::vector<std::pair<std::string, std::string>> properties;   ///< @brief 自定义属性（非字符串值以 JSON 文本保存）
+    };
+
+    /**
+     * @brief 解析 Tiled 文件中引用的相对路径：以引用文件所在目录为基准做纯字符串规范化，不访问文件系统。
+     * 例如 ("../textures/a.png", "assets/maps/level1.tmj") -> "assets/textures/a.png"
+     */
+    std::string resolveLevelPath(const std::string& relative_path, const std::string& file_path);
+
+    /**
+     * @brief 把 Tiled 地图（tmj，引用的 tsj 会一并内嵌）转换为二进制关卡。
+     * @return 转换是否成功，失败时记录日志。
+     */
+    bool convertTiledLevel(const std::string& map_path, std::vector<std::uint8_t>& out);
+
+    /// @brief 数据是否是二进制关卡（检查文件头）
+    bool isBinaryLevel(const std::uint8_t* data, size_t size);
+
+    /**
+     * @brief 顺序读取二进制关卡。图层名、图片路径和区块 gid 直接指向数据，不做拷贝。
+     *
+     * 按 readHeader -> readTileset * tileset_count -> (readLayerInfo -> 对应类型的 readXxxLayer) * layer_count 的顺序调用。
+     * 数据越界时之后的读取都返回 false。
+     */
+    class BinaryLevelReader final
+    {
+    private:
+        const std::uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        size_t cursor_ = 0;
+        bool ok_ = true;
+
+    public:
+        BinaryLevelReader(const std::uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+        bool readHeader(LevelFileHeader& header);
+        bool readTileset(engine::component::TileSetInfo& tileset);
+        bool readLayerInfo(LevelLayerInfo& layer);
+        bool readImageLayer(std::string_view& image_id, glm::vec2& scroll_factor, glm::bvec2& repeat);
+        bool readTileLayer(glm::ivec2& layer_size, std::vector<std::uint32_t>& gids);
+        bool readChunkedTileLayer(glm::ivec2& chunk_size, std::vector<LevelChunkRecord>& chunks);
+        bool readObjectLayer(std::vector<LevelObjectRecord>& objects);
+
+    private:
+        const std::uint8_t* take(size_t bytes);
+        template <typename T> T read();
+        std::string_view readString();
+        void align(size_t alignment);
+    };
+}
@@ -1,80 +1,245 @@
 ﻿#include "level_loader.h"
 #include "../component/parallax_component.h"
 #include "../component/transform_component.h"
+#include "../component/tile_layer_component.h"
+#include "../component/chunked_tile_layer_component.h"
 #include "../object/game_object.h"
 #include "../scene/scene.h"
+#include "scene_manager.h"
+#include "level_streamer.h"
+#include "prefab_registry.h"
 #include "../core/context.h"
 #include "../render/sprite.h"
+#include "../resource/asset_archive.h"
+#include "binary_level.h"
+#include "tiled_map_parser.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <spdlog/spdlog.h>
 #include <glm/vec2.hpp>
 #include <filesystem>
+#include <algorithm>
+#include <iterator>
 
 
 namespace engine::scene
 {
-    bool LevelLoader::loadLevel(const std::string& map_path, Scene& scene)
+    namespace
     {
-        map_path_ = map_path;
-        std::ifstream map_file(map_path_);
-        //1、加载json文件
-        if (!map_file.is_open())
-        {
-            spdlog::error("无法打开地图文件: {}", map_path_);
-            return false;
-        }
-        //2、解析json数据
-        nlohmann::json json_data;
-        try
-        {
-            map_file >> json_data;
-        }
-        catch (const nlohmann::json::parse_error& e)
-        {
-            spdlog::error("解析地图文件 {} 时出错: {}", map_path_, e.what());
-            return false;
-        }
-        
-        //3、加载图层数据
-        if (!json_data.contains("layers") || !json_data["layers"].is_array()) //检查是否包含图层数组
+        //打开并解析 JSON 文件，失败时记录日志并返回 false。资源包中的条目直接从映射内存解析
+        bool readJsonFile(const std::string& file_path, nlohmann::json& json_data, const engine::resource::AssetArchive* archive)
         {
-            spdlog::error("地图文件 {} 中没有找到图层数组", map_path_);
-            return false;
-        }
-
-        for (const auto& layer_json : json_data["layers"])
-        {
-            //获取个图层对象中的类型 type 字段
-            std::string layer_type = layer_json.value("type", "none");
-            if (!layer_json.value("visible", true))
+            if (const auto* packed = archive ? archive->find(file_path) : nullptr)
             {
-                spdlog::info("图层 {} 不可见", layer_json.value("name", "无名称"));
-                continue;
+                try
+                {
+                    //cooker 把 JSON 预先转成了 MessagePack，省去文本解析
+                    json_data = packed->type == engine::resource::ArchiveEntryType::MsgPack
+                        ? nlohmann::json::from_msgpack(packed->data, packed->data + packed->size)
+                        : nlohmann::json::parse(packed->data, packed->data + packed->size);
+                }
+                catch (const nlohmann::json::exception& e)
+                {
+                    spdlog::error("解析资源包中的文件 {} 时出错: {}", file_path, e.what());
+                    return false;
+                }
+                return true;
             }
-            if (layer_type == "imagelayer")
+            
+            std::ifstream file(file_path);
+            if (!file.is_open())
             {
-                loadImageLayer(layer_json, scene);
+                spdlog::error("无法打开文件: {}", file_path);
+                return false;
             }
-            else if (layer_type == "tilelayer")
+            try
             {
-                loadTileLayer(layer_json, scene);
+                file >> json_data;
             }
-            else if (layer_type == "objectgroup")
+            catch (const nlohmann::json::parse_error& e)
             {
-                loadObjectLayer(layer_json, scene);
+                spdlog::error("解析文件 {} 时出错: {}", file_path, e.what());
+                return false;
             }
-            else
+            return true;
+        }
+    }
+    
+    LevelLoader::LevelLoader(const engine::resource::AssetArchive* archive) : archive_(archive) {}
+
+    LevelLoader::~LevelLoader() = default;
+
+    bool LevelLoader::loadLevel(const std::string& map_path, Scene& scene)
+    {
+        map_path_ = map_path;
+        is_infinite_ = false;
+        streamer_.reset();
+        //0、烘焙过的二进制关卡直接顺序读取
+        std::vector<std::uint8_t> file_buffer;
+        if (const auto level_data = findBinaryLevel(map_path_, file_buffer); !level_data.empty())
+        {
+            if (!loadBinaryLevel(level_data, scene)) return false;
+            if (streamer_)
             {
-                spdlog::warn("未知图层类型 {}，跳过加载", layer_type);
+                //区块 gid 直接引用关卡数据：资源包中的数据在映射内存里，散文件的缓冲交给流式加载器保管
+                streamer_->retainLevelData(std::move(file_buffer));
+                scene.setLevelStreamer(std::move(streamer_));
             }
+            return true;
+        }
+        
+        //1、2、流式解析 Tiled JSON：图层在解析到时创建，图块数据直接解码进 gid 数组
+        //Tiled 按字母序输出字段，tilesets / tilewidth 在 layers 之后，此时先暂存图层（只移动 gid 数组，不拷贝），
+        //等地图信息读完再创建
+        map_size_ = glm::ivec2(0, 0);
+        tile_size_ = glm::vec2(0.0f, 0.0f);
+        tilesets_ = std::make_shared<engine::component::TileSetList>();
+        scene.getPrefabRegistry().setTilesets(tilesets_);   //图块对象按 gid 查找图块集生成预制体
+        bool header_loaded = false;
+        std::vector<TiledLayerData> pending_layers;
+        nlohmann::json map_json;
+        const bool parsed = parseTiledMap(map_path_, archive_, map_json,
+            [&](const nlohmann::json& partial_map_json, TiledLayerData& layer)
+            {
+                if (!header_loaded && hasMapHeader(partial_map_json))
+                {
+                    loadMapHeader(partial_map_json);
+                    header_loaded = true;
+                }
+                if (header_loaded) loadLayer(layer, scene);
+                else pending_layers.push_back(std::move(layer));
+                return true;
+            }, true, true);     //无限地图压缩过的区块不在这里解码，由流式加载器载入区块时解码
+        if (!parsed) return false;
+        
+        //3、4、地图尺寸、图块尺寸和图块集（需要在图块图层之前完成）
+        if (!header_loaded) loadMapHeader(map_json);
+        else map_size_ = glm::ivec2(map_json.value("width", 0), map_json.value("height", 0));
+        
+        //5、创建暂存的图层
+        for (auto& layer : pending_layers)
+        {
+            loadLayer(layer, scene);
         }
         
+        if (streamer_) scene.setLevelStreamer(std::move(streamer_));
         spdlog::info("关卡加载完成： {}", map_path_);
         return true;
         
     }
 
+    std::vector<std::string> LevelLoader::collectTexturePaths(const std::string& map_path)
+    {
+        std::vector<std::string> texture_paths;
+        std::vector<std::uint8_t> file_buffer;
+        if (const auto level_data = findBinaryLevel(map_path, file_buffer); !level_data.empty())
+        {
+            collectBinaryTexturePaths(level_data, texture_paths);
+            std::sort(texture_paths.begin(), texture_paths.end());
+            texture_paths.erase(std::unique(texture_paths.begin(), texture_paths.end()), texture_paths.end());
+            return texture_paths;
+        }
+        
+        //图片图层（与 loadLevel 一致，跳过不可见图层）。图块数据不需要，解析时直接丢弃
+        nlohmann::json json_data;
+        const bool parsed = parseTiledMap(map_path, archive_, json_data,
+            [&](const nlohmann::json&, TiledLayerData& layer)
+            {
+                const auto& layer_json = layer.info;
+                if (layer_json.value("type", "none") != "imagelayer" || !layer_json.value("visible", true)) return true;
+                const std::string image_path = layer_json.value("image", "");
+                if (!image_path.empty()) texture_paths.push_back(resolvePath(image_path, map_path));
+                return true;
+            }, false);
+        if (!parsed) return texture_paths;
+        
+        //图块集引用的图片
+        if (json_data.contains("tilesets") && json_data["tilesets"].is_array())
+        {
+            for (const auto& tileset_ref : json_data["tilesets"])
+            {
+                if (!tileset_ref.contains("source")) continue;
+                const std::string tileset_path = resolvePath(tileset_ref["source"].get<std::string>(), map_path);
+                nlohmann::json tileset_json;
+                if (!readJsonFile(tileset_path, tileset_json, archive_)) continue;
+                
+                if (tileset_json.value("columns", 0) > 0)
+                {
+                    texture_paths.push_back(resolvePath(tileset_json.value("image", ""), tileset_path));
+                }
+                else if (tileset_json.contains("tiles") && tileset_json["tiles"].is_array())
+                {
+                    for (const auto& tile_json : tileset_json["tiles"])
+                    {
+                        if (tile_json.contains("image"))
+                            texture_paths.push_back(resolvePath(tile_json["image"].get<std::string>(), tileset_path));
+                    }
+                }
+            }
+        }
+        
+        std::sort(texture_paths.begin(), texture_paths.end());
+        texture_paths.erase(std::unique(texture_paths.begin(), texture_paths.end()), texture_paths.end());
+        return texture_paths;
+    }
+
+    bool LevelLoader::hasMapHeader(const nlohmann::json& map_json)
+    {
+        return map_json.contains("tilewidth") && map_json.contains("tileheight") && map_json.contains("tilesets");
+    }
+
+    void LevelLoader::loadMapHeader(const nlohmann::json& map_json)
+    {
+        map_size_ = glm::ivec2(map_json.value("width", 0), map_json.value("height", 0));
+        tile_size_ = glm::vec2(map_json.value("tilewidth", 0.0f), map_json.value("tileheight", 0.0f));
+        is_infinite_ = map_json.value("infinite", false);
+        
+        if (map_json.contains("tilesets") && map_json["tilesets"].is_array())
+        {
+            for (const auto& tileset_json : map_json["tilesets"])
+            {
+                if (!tileset_json.contains("source") || !tileset_json.contains("firstgid"))
+                {
+                    spdlog::error("地图 {} 中的图块集缺少 'source' 或 'firstgid'（不支持内嵌图块集）", map_path_);
+                    continue;
+                }
+                loadTileset(resolvePath(tileset_json["source"].get<std::string>(), map_path_),
+                            tileset_json["firstgid"].get<std::uint32_t>());
+            }
+            std::sort(tilesets_->begin(), tilesets_->end(),
+                [](const auto& a, const auto& b) { return a.first_gid < b.first_gid; });
+        }
+    }
+
+    void LevelLoader::loadLayer(TiledLayerData& layer, Scene& scene)
+    {
+        const auto& layer_json = layer.info;
+        //获取个图层对象中的类型 type 字段
+        std::string layer_type = layer_json.value("type", "none");
+        if (!layer_json.value("visible", true))
+        {
+            spdlog::info("图层 {} 不可见", layer_json.value("name", "无名称"));
+            return;
+        }
+        if (layer_type == "imagelayer")
+        {
+            loadImageLayer(layer_json, scene);
+        }
+        else if (layer_type == "tilelayer")
+        {
+            if (is_infinite_) loadChunkedTileLayer(layer_json, layer.chunks, scene);
+            else loadTileLayer(layer_json, layer.gids, scene);
+        }
+        else if (layer_type == "objectgroup")
+        {
+            loadObjectLayer(layer_json, scene);
+        }
+        else
+        {
+            spdlog::warn("未知图层类型 {}，跳过加载", layer_type);
+        }
+    }
+
     void LevelLoader::loadImageLayer(const nlohmann::json& layer_json, Scene& scene)
     {
         // 获取纹理相对路径 （会自动处理'\/'符号）
@@ -85,7 +250,7 @@ namespace engine::scene
             return;
         }
         
-        auto texture_id = resolvePath(image_path);
+        auto texture_id = resolvePath(image_path, map_path_);
         
         //获取图层偏移量 json中没有则代表未设置用默认值
         const glm::vec2 offset =  glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
@@ -98,6 +263,12 @@ namespace engine::scene
         const std::string& layer_name = layer_json.value("name", "Unnamed");
         /*  可用类似方法获取其它各种属性，这里我们暂时用不上 */
         
+        addImageLayer(layer_name, offset, texture_id, scroll_factor, repeat, scene);
+    }
+
+    void LevelLoader::addImageLayer(const std::string& layer_name, const glm::vec2& offset, const std::string& texture_id,
+                                    const glm::vec2& scroll_factor, const glm::bvec2& repeat, Scene& scene)
+    {
         //创建游戏对象
         auto game_obj = std::make_unique<engine::object::GameObject>(layer_name);
         
@@ -110,28 +281,317 @@ namespace engine::scene
         spdlog::info("加载图片图层 '{}' 完成。", layer_name);
     }
 
-    void LevelLoader::loadTileLayer(const nlohmann::json& layer_json, Scene& scene)
+    void LevelLoader::loadTileLayer(const nlohmann::json& layer_json, std::vector<std::uint32_t>& gids, Scene& scene)
+    {
+        const std::string& layer_name = layer_json.value("name", "Unnamed");
+        if (gids.empty())
+        {
+            spdlog::error("图块图层 '{}' 缺少 'data' 数据。", layer_name);
+            return;
+        }
+        
+        //图层尺寸，缺省时使用地图尺寸
+        const glm::ivec2 layer_size = glm::ivec2(layer_json.value("width", map_size_.x), layer_json.value("height", map_size_.y));
+        
+        const glm::vec2 offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+        
+        addTileLayer(layer_name, offset, layer_size, std::move(gids), scene);
+    }
+
+    void LevelLoader::addTileLayer(const std::string& layer_name, const glm::vec2& offset, const glm::ivec2& layer_size,
+                                   std::vector<std::uint32_t> gids, Scene& scene)
     {
+        auto game_obj = std::make_unique<engine::object::GameObject>(layer_name);
+        game_obj->addComponent<engine::component::TransformComponent>(offset);
+        game_obj->addComponent<engine::component::TileLayerComponent>(tile_size_, layer_size, std::move(gids), tilesets_);
+        
+        scene.addGameObject(std::move(game_obj));
+        spdlog::info("加载图块图层 '{}' 完成。", layer_name);
+    }
+
+    void LevelLoader::loadChunkedTileLayer(const nlohmann::json& layer_json, std::vector<TiledChunkData>& chunks, Scene& scene)
+    {
+        const std::string& layer_name = layer_json.value("name", "Unnamed");
+        const glm::vec2 offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+        
+        //Tiled 导出的区块尺寸相同（默认 16x16），取最大值作为图层的区块尺寸
+        glm::ivec2 chunk_size = {0, 0};
+        for (const auto& chunk : chunks) chunk_size = glm::max(chunk_size, chunk.size);
+        
+        const size_t layer_index = addChunkedTileLayer(layer_name, offset, chunk_size, scene);
+        auto& streamer = getStreamer(scene);
+        const std::string compression = layer_json.value("compression", "");
+        for (auto& chunk : chunks)
+        {
+            if (!chunk.encoded_data.empty()) streamer.addChunk(layer_index, chunk.position, chunk.size, std::move(chunk.encoded_data), compression);
+            else streamer.addChunk(layer_index, chunk.position, chunk.size, std::move(chunk.gids));
+        }
+        spdlog::info("登记无限地图图块图层 '{}'，区块数: {}", layer_name, chunks.size());
+    }
+
+    size_t LevelLoader::addChunkedTileLayer(const std::string& layer_name, const glm::vec2& offset, const glm::ivec2& chunk_size, Scene& scene)
+    {
+        auto game_obj = std::make_unique<engine::object::GameObject>(layer_name);
+        game_obj->addComponent<engine::component::TransformComponent>(offset);
+        auto* layer_component = game_obj->addComponent<engine::component::ChunkedTileLayerComponent>(tile_size_, chunk_size, tilesets_);
+        
+        const size_t layer_index = getStreamer(scene).addTileLayer(game_obj.get(), layer_component, offset);
+        scene.addGameObject(std::move(game_obj));
+        return layer_index;
+    }
+
+    LevelStreamer& LevelLoader::getStreamer(Scene& scene)
+    {
+        if (!streamer_)
+        {
+            streamer_ = std::make_unique<LevelStreamer>(scene, scene.getSceneManager().getStreamingSettings());
+            //默认按预制体创建对象，场景可以在加载后替换
+            streamer_->setObjectSpawner([](const LevelObjectRecord& object, Scene& target_scene)
+            {
+                return target_scene.getPrefabRegistry().instantiate(object);
+            });
+        }
+        return *streamer_;
     }
 
     void LevelLoader::loadObjectLayer(const nlohmann::json& layer_json, Scene& scene)
     {
+        if (!layer_json.contains("objects") || !layer_json["objects"].is_array()) return;
+        const glm::vec2 offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+        //无限地图的对象交给流式加载器，随相机按网格创建和移除
+        if (is_infinite_)
+        {
+            auto& streamer = getStreamer(scene);
+            for (const auto& object_json : layer_json["objects"])
+            {
+                streamer.addObject(parseTiledObject(object_json), offset);
+            }
+            return;
+        }
+        for (const auto& object_json : layer_json["objects"])
+        {
+            auto object = parseTiledObject(object_json);
+            object.position += offset;
+            addObject(object, scene);
+        }
+    }
+
+    void LevelLoader::addObject(const LevelObjectRecord& object, Scene& scene)
+    {
+        //按预制体创建实例，没有匹配预制体的对象（如触发区域）由场景自行处理
+        if (auto game_object = scene.getPrefabRegistry().instantiate(object))
+        {
+            scene.addGameObject(std::move(game_object));
+        }
+    }
+
+    void LevelLoader::loadTileset(const std::string& tileset_path, std::uint32_t first_gid)
+    {
+        nlohmann::json json_data;
+        if (!readJsonFile(tileset_path, json_data, archive_)) return;
+        
+        engine::component::TileSetInfo tileset;
+        tileset.first_gid = first_gid;
+        tileset.tile_count = json_data.value("tilecount", 0u);
+        tileset.columns = json_data.value("columns", 0);
+        tileset.tile_size = glm::vec2(json_data.value("tilewidth", 0.0f), json_data.value("tileheight", 0.0f));
+        tileset.margin = json_data.value("margin", 0);
+        tileset.spacing = json_data.value("spacing", 0);
+        
+        if (tileset.columns > 0)
+        {
+            //单图图块集
+            tileset.image_id = resolvePath(json_data.value("image", ""), tileset_path);
+        }
+        else if (json_data.contains("tiles") && json_data["tiles"].is_array())
+        {
+            //图片集合图块集：每个图块一张图片
+            for (const auto& tile_json : json_data["tiles"])
+            {
+                if (!tile_json.contains("image")) continue;
+                engine::component::TileSetInfo::TileImage image;
+                image.image_id = resolvePath(tile_json["image"].get<std::string>(), tileset_path);
+                image.size = glm::vec2(tile_json.value("imagewidth", 0.0f), tile_json.value("imageheight", 0.0f));
+                image.source_rect = readTileSourceRect(tile_json);
+                tileset.images.emplace(tile_json.value("id", 0u), std::move(image));
+            }
+        }
+        
+        tilesets_->push_back(std::move(tileset));
+        spdlog::info("加载图块集 {} 完成，firstgid: {}", tileset_path, first_gid);
+    }
+
+    std::span<const std::uint8_t> LevelLoader::findBinaryLevel(const std::string& map_path, std::vector<std::uint8_t>& file_buffer) const
+    {
+        //资源包中的地图由 cooker 转换为二进制关卡，数据留在映射内存中
+        if (const auto* packed = archive_ ? archive_->find(map_path) : nullptr)
+        {
+            if (packed->type == engine::resource::ArchiveEntryType::Level || isBinaryLevel(packed->data, packed->size))
+                return {packed->data, packed->size};
+            return {};
+        }
+        
+        if (std::filesystem::path(map_path).extension() != BINARY_LEVEL_EXTENSION) return {};
+        std::ifstream file(map_path, std::ios::binary);
+        if (!file.is_open())
+        {
+            spdlog::error("无法打开关卡文件: {}", map_path);
+            return {};
+        }
+        file_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return file_buffer;
+    }
+
+    bool LevelLoader::loadBinaryLevel(std::span<const std::uint8_t> level_data, Scene& scene)
+    {
+        BinaryLevelReader reader(level_data.data(), level_data.size());
+        LevelFileHeader header;
+        if (!reader.readHeader(header))
+        {
+            spdlog::error("无法读取二进制关卡 {}", map_path_);
+            return false;
+        }
+        map_size_ = glm::ivec2(header.map_width, header.map_height);
+        tile_size_ = glm::vec2(header.tile_width, header.tile_height);
+        is_infinite_ = (header.flags & LEVEL_FLAG_INFINITE) != 0;
+        
+        //图块集已内嵌并按 first_gid 排好序
+        tilesets_ = std::make_shared<engine::component::TileSetList>();
+        scene.getPrefabRegistry().setTilesets(tilesets_);
+        for (std::uint32_t i = 0; i < header.tileset_count; ++i)
+        {
+            engine::component::TileSetInfo tileset;
+            if (!reader.readTileset(tileset))
+            {
+                spdlog::error("二进制关卡 {} 的图块集数据损坏", map_path_);
+                return false;
+            }
+            tilesets_->push_back(std::move(tileset));
+        }
+        
+        std::vector<std::uint32_t> gids;
+        std::vector<LevelChunkRecord> chunks;
+        std::vector<LevelObjectRecord> objects;
+        for (std::uint32_t i = 0; i < header.layer_count; ++i)
+        {
+            LevelLayerInfo layer;
+            bool ok = reader.readLayerInfo(layer);
+            const std::string layer_name(layer.name);
+            switch (layer.type)
+            {
+            case LevelLayerType::Image:
+            {
+                std::string_view texture_id;
+                glm::vec2 scroll_factor;
+                glm::bvec2 repeat;
+                ok = ok && reader.readImageLayer(texture_id, scroll_factor, repeat);
+                if (ok) addImageLayer(layer_name, layer.offset, std::string(texture_id), scroll_factor, repeat, scene);
+                break;
+            }
+            case LevelLayerType::Tile:
+            {
+                glm::ivec2 layer_size;
+                ok = ok && reader.readTileLayer(layer_size, gids);
+                if (ok) addTileLayer(layer_name, layer.offset, layer_size, std::move(gids), scene);
+                break;
+            }
+            case LevelLayerType::ChunkedTile:
+            {
+                glm::ivec2 chunk_size;
+                ok = ok && reader.readChunkedTileLayer(chunk_size, chunks);
+                if (!ok) break;
+                const size_t layer_index = addChunkedTileLayer(layer_name, layer.offset, chunk_size, scene);
+                for (const auto& chunk : chunks)
+                {
+                    getStreamer(scene).addChunk(layer_index, chunk.position, chunk.size, chunk.gids);
+                }
+                break;
+            }
+            case LevelLayerType::Object:
+                //与 JSON 路径一致：无限地图的对象交给流式加载器，其他地图直接按预制体创建
+                ok = ok && reader.readObjectLayer(objects);
+                if (!ok) break;
+                for (auto& object : objects)
+                {
+                    if (is_infinite_)
+                    {
+                        getStreamer(scene).addObject(std::move(object), layer.offset);
+                        continue;
+                    }
+                    object.position += layer.offset;
+                    addObject(object, scene);
+                }
+                break;
+            default:
+                ok = false;
+                break;
+            }
+            if (!ok)
+            {
+                spdlog::error("二进制关卡 {} 的第 {} 个图层数据损坏", map_path_, i);
+                return false;
+            }
+        }
+        
+        spdlog::info("关卡加载完成（二进制）： {}", map_path_);
+        return true;
     }
 
-    std::string LevelLoader::resolvePath(std::string image_path)
+    void LevelLoader::collectBinaryTexturePaths(std::span<const std::uint8_t> level_data, std::vector<std::string>& texture_paths)
     {
-        try
+        BinaryLevelReader reader(level_data.data(), level_data.size());
+        LevelFileHeader header;
+        if (!reader.readHeader(header)) return;
+        for (std::uint32_t i = 0; i < header.tileset_count; ++i)
         {
-            // 获取地图文件的父目录（相对于可执行文件） “assets/maps/level1.tmj” -> “assets/maps”
-            auto map_dir = std::filesystem::path(map_path_).parent_path();
-            // 合并路径（相对于可执行文件）并返回。 /* std::filesystem::canonical：解析路径中的当前目录（.）和上级目录（..）导航符，
-            /*  得到一个干净的路径 */
-            auto final_path = std::filesystem::canonical(map_dir / image_path);
-            return final_path.string();
+            engine::component::TileSetInfo tileset;
+            if (!reader.readTileset(tileset)) return;
+            if (!tileset.image_id.empty()) texture_paths.push_back(tileset.image_id);
+            for (auto& [id, image] : tileset.images) texture_paths.push_back(std::move(image.image_id));
         }
-        catch (const std::exception& e) {
-            spdlog::error("解析路径失败: {}", e.what());
-            return image_path;
+        
+        std::vector<std::uint32_t> gids;
+        std::vector<LevelChunkRecord> chunks;
+        std::vector<LevelObjectRecord> objects;
+        for (std::uint32_t i = 0; i < header.layer_count; ++i)
+        {
+            LevelLayerInfo layer;
+            if (!reader.readLayerInfo(layer)) return;
+            bool ok = true;
+            if (layer.type == LevelLayerType::Image)
+            {
+                std::string_view texture_id;
+                glm::vec2 scroll_factor;
+                glm::bvec2 repeat;
+                ok = reader.readImageLayer(texture_id, scroll_factor, repeat);
+                if (ok) texture_paths.emplace_back(texture_id);
+            }
+            else if (layer.type == LevelLayerType::Tile)
+            {
+                glm::ivec2 layer_size;
+                ok = reader.readTileLayer(layer_size, gids);//只为跳过数据
+            }
+            else if (layer.type == LevelLayerType::ChunkedTile)
+            {
+                glm::ivec2 chunk_size;
+                ok = reader.readChunkedTileLayer(chunk_size, chunks);
+            }
+            else if (layer.type == LevelLayerType::Object)
+            {
+                ok = reader.readObjectLayer(objects);
+            }
+            else
+            {
+                ok = false;
+            }
+            if (!ok) return;
         }
     }
+
+    std::string LevelLoader::resolvePath(const std::string& image_path, const std::string& file_path)
+    {
+        // “assets/maps/level1.tmj” + “../textures/Layers/back.png” -> “assets/textures/Layers/back.png”
+        // 只做字符串规范化：纹理 ID 与二进制关卡、资源包、纹理图集中的路径写法一致，也不需要访问文件系统
+        return resolveLevelPath(image_path, file_path);
+    }
 }
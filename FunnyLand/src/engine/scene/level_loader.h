@@ -1,41 +1,115 @@
 ﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
+#include <vector>
 #include <nlohmann/json_fwd.hpp>
+#include <glm/vec2.hpp>
+#include "../component/tile_layer_component.h"
+#include "tiled_map_parser.h"
+
+namespace engine::resource
+{
+    class AssetArchive;
+}
 
 namespace engine::scene 
 {
     class Scene;
-
+    class LevelStreamer;
 
     class LevelLoader final
     {
         std::string map_path_;      ///< @brief 地图路径（拼接路径时需要）
+        glm::ivec2 map_size_ = {0, 0};          ///< @brief 地图尺寸（图块数）
+        glm::vec2 tile_size_ = {0.0f, 0.0f};    ///< @brief 图块尺寸（像素）
+        std::shared_ptr<engine::component::TileSetList> tilesets_;  ///< @brief 地图引用的图块集（按 first_gid 升序，图块图层共享）
+        const engine::resource::AssetArchive* archive_ = nullptr;   ///< @brief 资源包，地图和图块集优先从包中读取预解析的数据（为空时只读散文件）
+        bool is_infinite_ = false;                                  ///< @brief 是否是无限地图（图块和对象交给流式加载器）
+        std::unique_ptr<LevelStreamer> streamer_;                   ///< @brief 无限地图的流式加载器，加载完成后交给场景
     public:
-        LevelLoader() = default;
+        explicit LevelLoader(const engine::resource::AssetArchive* archive = nullptr);
+        ~LevelLoader();
         
         
         /**
          * @brief 加载关卡数据到指定的 Scene 对象中。
-         * @param map_path Tiled JSON 地图文件的路径。
+         * 资源包中烘焙过的地图和 .flvl 文件按二进制关卡读取，其余按 Tiled JSON 流式解析（见 tiled_map_parser.h），
+         * 两者都不构建整张地图的 JSON DOM。
+         * 无限地图（infinite）的图块区块和对象不直接创建，而是登记到 LevelStreamer（设置给场景），运行时按相机载入。
+         * @param map_path Tiled JSON 地图文件（或二进制关卡文件）的路径。
          * @param scene 要加载数据的目标 Scene 对象。
          * @return bool 是否加载成功。
          */
         bool loadLevel(const std::string& map_path, Scene& scene);
         
+        /**
+         * @brief 只解析地图和图块集文件，收集关卡会用到的所有图片路径（与 loadLevel 解析出的纹理 ID 一致）。
+         * 不访问场景和资源管理器，可以在后台线程调用，用于场景预加载。
+         * @param map_path Tiled JSON 地图文件的路径。
+         * @return 去重后的图片路径，打开或解析失败时返回已收集到的部分。
+         */
+        std::vector<std::string> collectTexturePaths(const std::string& map_path);
+        
     private:
+        /// @brief 地图字段中是否已有创建图层所需的信息（图块尺寸和图块集）
+        static bool hasMapHeader(const nlohmann::json& map_json);
+        /// @brief 读取地图尺寸、图块尺寸并加载图块集
+        void loadMapHeader(const nlohmann::json& map_json);
+        
+        void loadLayer(TiledLayerData& layer, Scene& scene);                   ///< @brief 按类型加载图层
         void loadImageLayer(const nlohmann::json& layer_json, Scene& scene);    ///< @brief 加载图片图层
-        void loadTileLayer(const nlohmann::json& layer_json, Scene& scene);     ///< @brief 加载瓦片图层
+        void loadTileLayer(const nlohmann::json& layer_json, std::vector<std::uint32_t>& gids, Scene& scene);  ///< @brief 加载瓦片图层（gid 由解析器解码后移入）
+        void loadChunkedTileLayer(const nlohmann::json& layer_json, std::vector<TiledChunkData>& chunks, Scene& scene);  ///< @brief 加载无限地图的瓦片图层
         void loadObjectLayer(const nlohmann::json& layer_json, Scene& scene);   ///< @brief 加载对象图层
         
+        /// @brief 创建图片图层对象（JSON 和二进制关卡共用）
+        void addImageLayer(const std::string& layer_name, const glm::vec2& offset, const std::string& texture_id,
+                           const glm::vec2& scroll_factor, const glm::bvec2& repeat, Scene& scene);
+        /// @brief 创建图块图层对象（JSON 和二进制关卡共用）
+        void addTileLayer(const std::string& layer_name, const glm::vec2& offset, const glm::ivec2& layer_size,
+                          std::vector<std::uint32_t> gids, Scene& scene);
+        
+        /**
+         * @brief 创建无限地图的图块图层对象，并登记到流式加载器（JSON 和二进制关卡共用）
+         * @return 图层在流式加载器中的序号
+         */
+        size_t addChunkedTileLayer(const std::string& layer_name, const glm::vec2& offset, const glm::ivec2& chunk_size, Scene& scene);
+        /// @brief 按预制体创建对象并加入场景（位置为世界坐标，JSON 和二进制关卡共用）
+        void addObject(const LevelObjectRecord& object, Scene& scene);
+        /// @brief 获取（第一次调用时创建）流式加载器
+        LevelStreamer& getStreamer(Scene& scene);
+        
+        /**
+         * @brief 查找二进制关卡数据：资源包中的条目直接引用映射内存，.flvl 散文件读入 file_buffer。
+         * @return 关卡数据，不是二进制关卡时为空。
+         */
+        std::span<const std::uint8_t> findBinaryLevel(const std::string& map_path, std::vector<std::uint8_t>& file_buffer) const;
+        
+        /// @brief 从二进制关卡数据顺序创建图层对象
+        bool loadBinaryLevel(std::span<const std::uint8_t> level_data, Scene& scene);
+        
+        /// @brief 从二进制关卡数据收集图片路径
+        static void collectBinaryTexturePaths(std::span<const std::uint8_t> level_data, std::vector<std::string>& texture_paths);
+        
+        /**
+        * @brief 加载 Tiled 图块集文件（.tsj）。
+        * @param tileset_path 图块集文件路径
+        * @param first_gid 该图块集在地图中的第一个全局 id
+        */
+        void loadTileset(const std::string& tileset_path, std::uint32_t first_gid);
+        
         /**
-        * @brief 解析图片路径，合并地图路径和相对路径。例如：
+        * @brief 解析图片路径，合并地图路径和相对路径（纯字符串规范化，不访问文件系统）。例如：
         * 1. 地图路径："assets/maps/level1.tmj"
         * 2. 相对路径："../textures/Layers/back.png"
         * 3. 最终路径："assets/textures/Layers/back.png"
         * @param image_path （图片）相对路径
+        * @param file_path 引用该图片的文件（地图或图块集）路径，相对路径以它所在目录为基准
         * @return std::string 解析后的完整路径。
         */
-        std::string resolvePath(std::string image_path);
+        std::string resolvePath(const std::string& image_path, const std::string& file_path);
     
     };
 
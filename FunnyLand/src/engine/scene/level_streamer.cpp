@@ -0,0 +1,380 @@
+#include "level_streamer.h"
+#include "scene.h"
+#include "tiled_map_parser.h"
+#include "../component/chunked_tile_layer_component.h"
+#include "../object/game_object.h"
+#include "../render/camera.h"
+#include "../core/context.h"
+#include "../core/frame_arena.h"
+#include "../core/profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory_resource>
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene
+{
+    namespace
+    {
+        //两个矩形（min/max 表示）是否相交
+        bool overlaps(const glm::vec2& a_min, const glm::vec2& a_max, const glm::vec2& b_min, const glm::vec2& b_max)
+        {
+            return a_min.x < b_max.x && b_min.x < a_max.x && a_min.y < b_max.y && b_min.y < a_max.y;
+        }
+
+        glm::ivec2 keyToCoord(std::int64_t key)
+        {
+            return {static_cast<int>(key >> 32), static_cast<int>(static_cast<std::uint32_t>(key))};
+        }
+
+        //待载入或待卸载的区块
+        struct ChunkCandidate
+        {
+            float distance;             //到视野中心距离的平方
+            size_t layer_index;
+            std::int64_t key;
+        };
+
+        //游程压缩为 (重复次数, gid) 对，压缩后不比原数据小时返回空
+        std::vector<std::uint32_t> packRuns(const std::vector<std::uint32_t>& gids)
+        {
+            std::vector<std::uint32_t> runs;
+            for (size_t i = 0; i < gids.size();)
+            {
+                size_t end = i + 1;
+                while (end < gids.size() && gids[end] == gids[i]) ++end;
+                if (runs.size() + 2 >= gids.size()) return {};
+                runs.push_back(static_cast<std::uint32_t>(end - i));
+                runs.push_back(gids[i]);
+                i = end;
+            }
+            return runs;
+        }
+    }
+
+    LevelStreamer::LevelStreamer(Scene& scene, const StreamingSettings& settings)
+        : scene_(scene), settings_(settings)
+    {
+        settings_.prefetch_margin = std::max(settings_.prefetch_margin, 0.0f);
+        settings_.unload_margin = std::max(settings_.unload_margin, settings_.prefetch_margin);
+        settings_.object_cell_size = std::max(settings_.object_cell_size, 1.0f);
+        spdlog::trace("LevelStreamer 构造完成");
+    }
+
+    LevelStreamer::~LevelStreamer() = default;
+
+    size_t LevelStreamer::addTileLayer(engine::object::GameObject* owner, engine::component::ChunkedTileLayerComponent* component,
+                                       const glm::vec2& offset)
+    {
+        StreamedTileLayer layer;
+        layer.owner = owner;
+        layer.component = component;
+        layer.offset = offset;
+        tile_layers_.push_back(std::move(layer));
+        return tile_layers_.size() - 1;
+    }
+
+    void LevelStreamer::addChunk(size_t layer_index, const glm::ivec2& position, const glm::ivec2& size, std::vector<std::uint32_t>&& gids)
+    {
+        auto& layer = tile_layers_.at(layer_index);
+        SourceChunk source;
+        source.position = position;
+        source.size = size;
+        //Tiled 地图大片相同的图块（空白、地面）很常见，按游程压缩保存，载入时再展开
+        source.runs = packRuns(gids);
+        if (source.runs.empty())
+        {
+            source.gids = std::move(gids);
+            source.gids.shrink_to_fit();
+        }
+        else
+        {
+            source.runs.shrink_to_fit();
+        }
+        layer.sources[engine::component::ChunkedTileLayerComponent::chunkKey(layer.component->chunkCoordOf(position))] = std::move(source);
+    }
+
+    void LevelStreamer::addChunk(size_t layer_index, const glm::ivec2& position, const glm::ivec2& size, std::string&& encoded_data,
+                                 const std::string& compression)
+    {
+        auto& layer = tile_layers_.at(layer_index);
+        SourceChunk source;
+        source.position = position;
+        source.size = size;
+        source.encoded_data = std::move(encoded_data);
+        source.compression = compression;
+        layer.sources[engine::component::ChunkedTileLayerComponent::chunkKey(layer.component->chunkCoordOf(position))] = std::move(source);
+    }
+
+    void LevelStreamer::addChunk(size_t layer_index, const glm::ivec2& position, const glm::ivec2& size, const std::uint8_t* packed_gids)
+    {
+        auto& layer = tile_layers_.at(layer_index);
+        SourceChunk source;
+        source.position = position;
+        source.size = size;
+        source.packed_gids = packed_gids;
+        layer.sources[engine::component::ChunkedTileLayerComponent::chunkKey(layer.component->chunkCoordOf(position))] = std::move(source);
+    }
+
+    void LevelStreamer::addObject(LevelObjectRecord&& object, const glm::vec2& offset)
+    {
+        object.position += offset;
+        const auto key = engine::component::ChunkedTileLayerComponent::chunkKey(cellCoordOf(object.position));
+        object_cells_[key].objects.push_back(std::move(object));
+    }
+
+    void LevelStreamer::retainLevelData(std::vector<std::uint8_t>&& level_data)
+    {
+        //vector 移动后缓冲区地址不变，已登记的区块指针仍然有效
+        if (!level_data.empty()) retained_data_.push_back(std::move(level_data));
+    }
+
+    void LevelStreamer::update(const engine::render::Camera& camera)
+    {
+        ENGINE_PROFILE_SCOPE("LevelStreamer::update");
+        const glm::vec2 view_min = camera.getPosition();
+        const glm::vec2 view_max = view_min + camera.getViewportSize();
+        //超出预算时只载入视野内的区块，避免刚卸载的区块在下一帧又被预取回来
+        const bool over_budget = settings_.memory_budget > 0 && resident_bytes_ > settings_.memory_budget;
+        const float prefetch_margin = over_budget ? 0.0f : settings_.prefetch_margin;
+        const glm::vec2 load_min = view_min - prefetch_margin;
+        const glm::vec2 load_max = view_max + prefetch_margin;
+        const glm::vec2 keep_min = view_min - settings_.unload_margin;
+        const glm::vec2 keep_max = view_max + settings_.unload_margin;
+
+        //第一次更新一次性载入视野附近的全部区块，避免开场时画面逐块出现
+        const int max_loads = is_primed_ ? settings_.max_chunk_loads_per_frame : 0;
+        for (auto& layer : tile_layers_)
+        {
+            unloadChunks(layer, keep_min, keep_max);
+        }
+        loadChunks(load_min, load_max, (view_min + view_max) * 0.5f, max_loads);
+        updateObjectCells(load_min, load_max, keep_min, keep_max);
+
+        resident_bytes_ = computeResidentBytes();
+        if (settings_.memory_budget > 0 && resident_bytes_ > settings_.memory_budget)
+        {
+            enforceBudget(view_min, view_max);
+        }
+        is_primed_ = true;
+    }
+
+    void LevelStreamer::onObjectRemoved(engine::object::GameObject* game_object)
+    {
+        //图层对象被移除时不再流式加载该图层（组件随对象一起销毁）
+        std::erase_if(tile_layers_, [game_object](const StreamedTileLayer& layer) { return layer.owner == game_object; });
+
+        auto it = spawned_objects_.find(game_object);
+        if (it == spawned_objects_.end()) return;
+        if (auto cell = object_cells_.find(it->second.cell_key); cell != object_cells_.end())
+        {
+            //删除对象记录，网格重新载入时不再创建，记录占用的内存也一起释放
+            std::erase(cell->second.spawned, game_object);
+            const std::uint32_t object_id = it->second.object_id;
+            std::erase_if(cell->second.objects, [object_id](const LevelObjectRecord& object) { return object.id == object_id; });
+        }
+        spawned_objects_.erase(it);
+    }
+
+    size_t LevelStreamer::getLoadedChunkCount() const
+    {
+        size_t count = 0;
+        for (const auto& layer : tile_layers_) count += layer.loaded.size();
+        return count;
+    }
+
+    size_t LevelStreamer::getTotalChunkCount() const
+    {
+        size_t count = 0;
+        for (const auto& layer : tile_layers_) count += layer.sources.size();
+        return count;
+    }
+
+    void LevelStreamer::loadChunks(const glm::vec2& load_min, const glm::vec2& load_max, const glm::vec2& view_center, int max_loads)
+    {
+        //收集各图层载入范围内尚未载入的区块，由近到远载入：每帧限制数量时先补上视野中心附近的区块
+        std::pmr::vector<ChunkCandidate> candidates(&scene_.getContext().getFrameArena());
+        for (size_t i = 0; i < tile_layers_.size(); ++i)
+        {
+            const auto& layer = tile_layers_[i];
+            //载入范围转换到图层局部坐标，只遍历范围内的区块坐标（与地图大小无关）
+            const glm::vec2 chunk_pixel_size = layer.component->getChunkPixelSize();
+            const glm::ivec2 min_coord = glm::ivec2(glm::floor((load_min - layer.offset) / chunk_pixel_size));
+            const glm::ivec2 max_coord = glm::ivec2(glm::floor((load_max - layer.offset) / chunk_pixel_size));
+            for (int cy = min_coord.y; cy <= max_coord.y; ++cy)
+            {
+                for (int cx = min_coord.x; cx <= max_coord.x; ++cx)
+                {
+                    const auto key = engine::component::ChunkedTileLayerComponent::chunkKey({cx, cy});
+                    if (layer.loaded.contains(key) || !layer.sources.contains(key)) continue;
+                    const glm::vec2 to_center = layer.offset + (glm::vec2(cx, cy) + 0.5f) * chunk_pixel_size - view_center;
+                    candidates.push_back({glm::dot(to_center, to_center), i, key});
+                }
+            }
+        }
+
+        const size_t count = max_loads > 0 ? std::min(candidates.size(), static_cast<size_t>(max_loads)) : candidates.size();
+        std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count), candidates.end(),
+                          [](const auto& a, const auto& b) { return a.distance < b.distance; });
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& layer = tile_layers_[candidates[i].layer_index];
+            loadChunk(layer, candidates[i].key, layer.sources.find(candidates[i].key)->second);
+        }
+    }
+
+    void LevelStreamer::unloadChunks(StreamedTileLayer& layer, const glm::vec2& keep_min, const glm::vec2& keep_max)
+    {
+        const glm::vec2 chunk_pixel_size = layer.component->getChunkPixelSize();
+        for (auto it = layer.loaded.begin(); it != layer.loaded.end();)
+        {
+            const glm::vec2 chunk_min = layer.offset + glm::vec2(keyToCoord(*it)) * chunk_pixel_size;
+            if (overlaps(chunk_min, chunk_min + chunk_pixel_size, keep_min, keep_max))
+            {
+                ++it;
+                continue;
+            }
+            layer.component->unloadChunk(keyToCoord(*it));
+            it = layer.loaded.erase(it);
+        }
+    }
+
+    void LevelStreamer::loadChunk(StreamedTileLayer& layer, std::int64_t key, const SourceChunk& source)
+    {
+        std::vector<std::uint32_t> gids;
+        const size_t tile_count = static_cast<size_t>(std::max(source.size.x, 0)) * static_cast<size_t>(std::max(source.size.y, 0));
+        if (source.packed_gids)
+        {
+            gids.resize(tile_count);
+            std::memcpy(gids.data(), source.packed_gids, gids.size() * sizeof(std::uint32_t));
+        }
+        else if (!source.encoded_data.empty())
+        {
+            //失败时已记录日志，gids 为空，组件按空白区块处理
+            decodeTiledLayerData(source.encoded_data, "base64", source.compression, tile_count, gids);
+        }
+        else if (!source.runs.empty())
+        {
+            gids.reserve(tile_count);
+            for (size_t i = 0; i + 1 < source.runs.size(); i += 2)
+            {
+                gids.insert(gids.end(), source.runs[i], source.runs[i + 1]);
+            }
+        }
+        else
+        {
+            gids = source.gids;
+        }
+        layer.component->loadChunk(keyToCoord(key), source.position, source.size, std::move(gids));
+        layer.loaded.insert(key);
+    }
+
+    void LevelStreamer::enforceBudget(const glm::vec2& view_min, const glm::vec2& view_max)
+    {
+        //按到视野中心的距离从远到近卸载视野外的区块，直到回到预算内
+        //候选列表只在本次调用中使用，从帧内存池分配（超预算时每帧都会走到这里）
+        std::pmr::vector<ChunkCandidate> candidates(&scene_.getContext().getFrameArena());
+        const glm::vec2 view_center = (view_min + view_max) * 0.5f;
+        for (size_t i = 0; i < tile_layers_.size(); ++i)
+        {
+            const auto& layer = tile_layers_[i];
+            const glm::vec2 chunk_pixel_size = layer.component->getChunkPixelSize();
+            for (const auto key : layer.loaded)
+            {
+                const glm::vec2 chunk_min = layer.offset + glm::vec2(keyToCoord(key)) * chunk_pixel_size;
+                if (overlaps(chunk_min, chunk_min + chunk_pixel_size, view_min, view_max)) continue;
+                const glm::vec2 to_center = chunk_min + chunk_pixel_size * 0.5f - view_center;
+                candidates.push_back({glm::dot(to_center, to_center), i, key});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.distance > b.distance; });
+
+        for (const auto& candidate : candidates)
+        {
+            if (resident_bytes_ <= settings_.memory_budget) break;
+            auto& layer = tile_layers_[candidate.layer_index];
+            const size_t before = layer.component->getResidentBytes();
+            layer.component->unloadChunk(keyToCoord(candidate.key));
+            layer.loaded.erase(candidate.key);
+            resident_bytes_ -= before - layer.component->getResidentBytes();
+        }
+
+        if (resident_bytes_ > settings_.memory_budget && !budget_warned_)
+        {
+            spdlog::warn("LevelStreamer: 视野内的区块占用 {} 字节，超出内存预算 {} 字节", resident_bytes_, settings_.memory_budget);
+            budget_warned_ = true;
+        }
+    }
+
+    void LevelStreamer::updateObjectCells(const glm::vec2& load_min, const glm::vec2& load_max,
+                                          const glm::vec2& keep_min, const glm::vec2& keep_max)
+    {
+        if (object_cells_.empty()) return;
+        const float cell_size = settings_.object_cell_size;
+        for (auto it = loaded_cells_.begin(); it != loaded_cells_.end();)
+        {
+            const glm::vec2 cell_min = glm::vec2(keyToCoord(*it)) * cell_size;
+            if (overlaps(cell_min, cell_min + cell_size, keep_min, keep_max))
+            {
+                ++it;
+                continue;
+            }
+            unloadCell(object_cells_[*it]);
+            it = loaded_cells_.erase(it);
+        }
+
+        const glm::ivec2 min_coord = cellCoordOf(load_min);
+        const glm::ivec2 max_coord = cellCoordOf(load_max);
+        for (int cy = min_coord.y; cy <= max_coord.y; ++cy)
+        {
+            for (int cx = min_coord.x; cx <= max_coord.x; ++cx)
+            {
+                const auto key = engine::component::ChunkedTileLayerComponent::chunkKey({cx, cy});
+                auto cell = object_cells_.find(key);
+                if (cell == object_cells_.end() || cell->second.is_loaded) continue;
+                loadCell(key, cell->second);
+                loaded_cells_.insert(key);
+            }
+        }
+    }
+
+    void LevelStreamer::loadCell(std::int64_t key, ObjectCell& cell)
+    {
+        cell.is_loaded = true;
+        if (!spawner_) return;
+        for (const auto& object : cell.objects)
+        {
+            auto game_object = spawner_(object, scene_);
+            if (!game_object) continue;
+            spawned_objects_[game_object.get()] = {key, object.id};
+            cell.spawned.push_back(game_object.get());
+            scene_.safeAddGameObject(std::move(game_object));
+        }
+    }
+
+    void LevelStreamer::unloadCell(ObjectCell& cell)
+    {
+        //先取消登记，场景移除对象时就不会把它当作被游戏逻辑移除
+        for (auto* game_object : cell.spawned)
+        {
+            spawned_objects_.erase(game_object);
+            scene_.safeRemoveGameObject(game_object);
+        }
+        cell.spawned.clear();
+        cell.is_loaded = false;
+    }
+
+    size_t LevelStreamer::computeResidentBytes() const
+    {
+        size_t bytes = 0;
+        for (const auto& layer : tile_layers_) bytes += layer.component->getResidentBytes();
+        return bytes;
+    }
+
+    glm::ivec2 LevelStreamer::cellCoordOf(const glm::vec2& position) const
+    {
+        return glm::ivec2(glm::floor(position / settings_.object_cell_size));
+    }
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "binary_level.h"
+
+namespace engine::object
+{
+    class GameObject;
+}
+
+namespace engine::component
+{
+    class ChunkedTileLayerComponent;
+}
+
+namespace engine::render
+{
+    class Camera;
+}
+
+namespace engine::scene
+{
+    class Scene;
+
+    /// @brief 关卡流式加载参数
+    struct StreamingSettings
+    {
+        float prefetch_margin = 256.0f;         ///< @brief 相机视野外提前载入的距离（像素）
+        float unload_margin = 512.0f;           ///< @brief 超出相机视野这个距离后卸载（像素，不小于 prefetch_margin，两者之差防止边界处反复载入卸载）
+        size_t memory_budget = 32u << 20;       ///< @brief 驻留区块内存上限（字节），超出时先卸载视野外最远的区块，0 表示不限制
+        int max_chunk_loads_per_frame = 16;     ///< @brief 每帧最多载入的区块数（第一次更新不限制），0 表示不限制
+        float object_cell_size = 512.0f;        ///< @brief 对象按此边长的网格分组载入和卸载（像素）
+    };
+
+    /**
+     * @brief 按相机位置流式载入 Tiled 无限地图的图块区块和对象。
+     *
+     * LevelLoader 读取无限地图时不直接创建区块和对象，而是把源数据登记到这里：
+     * 图块区块按图层和区块坐标索引（二进制关卡直接引用关卡数据；JSON 地图的压缩区块保留 base64 数据，
+     * 数组形式的区块按游程压缩保存，都在载入时才解码），对象记录按 object_cell_size 的网格分组。
+     * 每帧 update() 按到视野中心的距离由近到远载入进入“视野 + prefetch_margin”的区块和网格，
+     * 卸载离开“视野 + unload_margin”的部分，因此解码后驻留的内存只与视野大小有关，与地图大小无关。
+     *
+     * 对象由 ObjectSpawner 创建（没有设置时只保留记录，不创建对象），网格卸载时安全移除。
+     * 被游戏逻辑移除的对象（例如被消灭的敌人）的记录随之删除，网格重新载入时不会再次出现。
+     * 由 Scene 持有，Scene 移除对象时调用 onObjectRemoved()。
+     */
+    class LevelStreamer final
+    {
+    public:
+        /// @brief 根据对象记录创建游戏对象，返回空表示不创建
+        using ObjectSpawner = std::function<std::unique_ptr<engine::object::GameObject>(const LevelObjectRecord&, Scene&)>;
+
+    private:
+        /// @brief 区块源数据
+        struct SourceChunk
+        {
+            glm::ivec2 position = {0, 0};                   ///< @brief 左上角的图块坐标
+            glm::ivec2 size = {0, 0};                       ///< @brief 尺寸（图块数）
+            std::vector<std::uint32_t> gids;                ///< @brief JSON 地图解码出的 gid（游程压缩不划算时）
+            std::vector<std::uint32_t> runs;                ///< @brief 游程压缩的 gid：(重复次数, gid) 对
+            std::string encoded_data;                       ///< @brief 压缩区块的 base64 数据（不为空时使用）
+            std::string compression;                        ///< @brief encoded_data 的压缩方式（zlib / gzip / zstd）
+            const std::uint8_t* packed_gids = nullptr;      ///< @brief 二进制关卡中的 gid（不为空时使用）
+        };
+
+        /// @brief 流式加载的图块图层
+        struct StreamedTileLayer
+        {
+            engine::object::GameObject* owner = nullptr;
+            engine::component::ChunkedTileLayerComponent* component = nullptr;
+            glm::vec2 offset = {0.0f, 0.0f};                        ///< @brief 图层偏移（像素）
+            std::unordered_map<std::int64_t, SourceChunk> sources;  ///< @brief 区块坐标 -> 源数据
+            std::unordered_set<std::int64_t> loaded;                ///< @brief 已载入的区块坐标
+        };
+
+        /// @brief 一个对象网格
+        struct ObjectCell
+        {
+            std::vector<LevelObjectRecord> objects;                 ///< @brief 网格内的对象记录（位置已加上图层偏移）
+            std::vector<engine::object::GameObject*> spawned;       ///< @brief 载入时创建的对象
+            bool is_loaded = false;
+        };
+
+        /// @brief 已创建对象的来源
+        struct SpawnedObject
+        {
+            std::int64_t cell_key = 0;
+            std::uint32_t object_id = 0;
+        };
+
+        Scene& scene_;
+        StreamingSettings settings_;
+        ObjectSpawner spawner_;
+        std::vector<StreamedTileLayer> tile_layers_;
+        std::unordered_map<std::int64_t, ObjectCell> object_cells_;                     ///< @brief 网格坐标 -> 对象网格
+        std::unordered_set<std::int64_t> loaded_cells_;                                 ///< @brief 已载入的网格坐标
+        std::unordered_map<engine::object::GameObject*, SpawnedObject> spawned_objects_; ///< @brief 存活的已创建对象
+        std::vector<std::vector<std::uint8_t>> retained_data_;                          ///< @brief 区块 gid 引用的关卡数据（散文件读入的 .flvl）
+        size_t resident_bytes_ = 0;                                                     ///< @brief 上次更新后驻留区块占用的内存
+        bool is_primed_ = false;                                                        ///< @brief 是否已经完成第一次更新
+        bool budget_warned_ = false;                                                    ///< @brief 超出预算的警告只记录一次
+
+    public:
+        LevelStreamer(Scene& scene, const StreamingSettings& settings);
+        ~LevelStreamer();
+
+        LevelStreamer(const LevelStreamer&) = delete;
+        LevelStreamer& operator=(const LevelStreamer&) = delete;
+        LevelStreamer(LevelStreamer&&) = delete;
+        LevelStreamer& operator=(LevelStreamer&&) = delete;
+
+        /**
+         * @brief 登记一个流式加载的图块图层
+         * @param owner 图层对象（已加入或将加入场景）
+         * @param component 图层对象上的区块图层组件
+         * @param offset 图层偏移（像素）
+         * @return 图层序号，用于 addChunk
+         */
+        size_t addTileLayer(engine::object::GameObject* owner, engine::component::ChunkedTileLayerComponent* component, const glm::vec2& offset);
+        /// @brief 登记区块源数据（gid 由流式加载器按游程压缩后持有）
+        void addChunk(size_t layer_index, const glm::ivec2& position, const glm::ivec2& size, std::vector<std::uint32_t>&& gids);
+        /// @brief 登记压缩的区块源数据（Tiled 的 base64 文本，载入时按 compression 解压）
+        void addChunk(size_t layer_index, const glm::ivec2& position, const glm::ivec2& size, std::string&& encoded_data, const std::string& compression);
+        /// @brief 登记区块源数据（gid 指向关卡数据，数据需要在加载器存活期间有效，见 retainLevelData）
+        void addChunk(size_t layer_index, const glm::ivec2& position, const glm::ivec2& size, const std::uint8_t* packed_gids);
+        /// @brief 登记一个对象记录，offset 为对象图层的偏移
+        void addObject(LevelObjectRecord&& object, const glm::vec2& offset);
+        /// @brief 保持关卡数据存活（区块 gid 引用其中的数据）
+        void retainLevelData(std::vector<std::uint8_t>&& level_data);
+
+        void setObjectSpawner(ObjectSpawner spawner) { spawner_ = std::move(spawner); }   ///< @brief 设置对象创建函数
+        const StreamingSettings& getSettings() const { return settings_; }                  ///< @brief 获取流式加载参数
+
+        /// @brief 按相机视野载入和卸载区块及对象（Scene::update 开始时调用）
+        void update(const engine::render::Camera& camera);
+
+        /// @brief 场景移除对象时调用，对象被游戏逻辑移除时删除它的记录，网格重新载入时不再创建
+        void onObjectRemoved(engine::object::GameObject* game_object);
+
+        size_t getLoadedChunkCount() const;                                         ///< @brief 已载入的区块数
+        size_t getTotalChunkCount() const;                                          ///< @brief 登记的区块数
+        size_t getLoadedCellCount() const { return loaded_cells_.size(); }          ///< @brief 已载入的对象网格数
+        size_t getSpawnedObjectCount() const { return spawned_objects_.size(); }    ///< @brief 存活的已创建对象数
+        size_t getResidentBytes() const { return resident_bytes_; }                 ///< @brief 驻留区块占用的内存（上次更新后）
+
+    private:
+        /// @brief 按到视野中心的距离由近到远载入各图层视野附近的区块，max_loads 为 0 时不限制数量
+        void loadChunks(const glm::vec2& load_min, const glm::vec2& load_max, const glm::vec2& view_center, int max_loads);
+        void unloadChunks(StreamedTileLayer& layer, const glm::vec2& keep_min, const glm::vec2& keep_max);
+        void loadChunk(StreamedTileLayer& layer, std::int64_t key, const SourceChunk& source);
+        void enforceBudget(const glm::vec2& view_min, const glm::vec2& view_max);
+        void updateObjectCells(const glm::vec2& load_min, const glm::vec2& load_max, const glm::vec2& keep_min, const glm::vec2& keep_max);
+        void loadCell(std::int64_t key, ObjectCell& cell);
+        void unloadCell(ObjectCell& cell);
+        size_t computeResidentBytes() const;
+        glm::ivec2 cellCoordOf(const glm::vec2& position) const;                   ///< @brief 世界坐标所在的对象网格
+    };
+}
@@ -0,0 +1,225 @@
+#include "prefab_registry.h"
+#include "../component/sprite_component.h"
+#include "../component/transform_component.h"
+#include "../object/game_object.h"
+#include "../resource/resource_manager.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::scene
+{
+    PrefabRegistry::PrefabRegistry(engine::resource::ResourceManager& resource_manager)
+        : resource_manager_(resource_manager)
+    {
+    }
+
+    PrefabRegistry::~PrefabRegistry() = default;
+
+    bool PrefabRegistry::registerPrefab(PrefabTemplate prefab, PrefabBuilder builder)
+    {
+        if (prefab.name.empty() || name_index_.contains(prefab.name))
+        {
+            spdlog::error("PrefabRegistry: 预制体名称 '{}' 为空或已注册", prefab.name);
+            return false;
+        }
+        auto entry = std::make_unique<Prefab>();
+        Prefab* raw = entry.get();
+        entry->data = std::make_shared<const PrefabTemplate>(std::move(prefab));
+        entry->builder = std::move(builder);
+        entry->pool = std::make_unique<engine::object::GameObjectPool>([this, raw]() { return createInstance(*raw); });
+        name_index_.emplace(entry->data->name, prefabs_.size());
+        prefabs_.push_back(std::move(entry));
+        return true;
+    }
+
+    bool PrefabRegistry::bindType(const std::string& type, const std::string& prefab_name)
+    {
+        auto it = name_index_.find(prefab_name);
+        if (it == name_index_.end())
+        {
+            spdlog::error("PrefabRegistry: 绑定类型 '{}' 时找不到预制体 '{}'", type, prefab_name);
+            return false;
+        }
+        type_index_[type] = it->second;
+        return true;
+    }
+
+    bool PrefabRegistry::bindGid(std::uint32_t gid, const std::string& prefab_name)
+    {
+        auto it = name_index_.find(prefab_name);
+        if (it == name_index_.end())
+        {
+            spdlog::error("PrefabRegistry: 绑定 gid {} 时找不到预制体 '{}'", gid, prefab_name);
+            return false;
+        }
+        gid_index_[gid & engine::component::TileLayerComponent::GID_MASK] = it->second;
+        return true;
+    }
+
+    std::unique_ptr<engine::object::GameObject> PrefabRegistry::instantiate(const LevelObjectRecord& object)
+    {
+        const auto index = findPrefabIndex(object);
+        if (!index)
+        {
+            spdlog::debug("PrefabRegistry: 对象 {} ('{}', 类型 '{}', gid {}) 没有对应的预制体", object.id, object.name, object.type, object.gid);
+            return nullptr;
+        }
+        auto& prefab = *prefabs_[*index];
+        const bool is_flipped = (object.gid & engine::component::TileLayerComponent::FLIPPED_HORIZONTALLY_FLAG) != 0;
+        return acquire(prefab, object.name.empty() ? prefab.data->name : object.name, object.position, object.size,
+                       object.rotation, is_flipped, object.visible);
+    }
+
+    std::unique_ptr<engine::object::GameObject> PrefabRegistry::instantiate(const std::string& prefab_name, const glm::vec2& position)
+    {
+        auto it = name_index_.find(prefab_name);
+        if (it == name_index_.end())
+        {
+            spdlog::error("PrefabRegistry: 找不到预制体 '{}'", prefab_name);
+            return nullptr;
+        }
+        auto& prefab = *prefabs_[it->second];
+        return acquire(prefab, prefab.data->name, position, glm::vec2(0.0f), 0.0f, false, true);
+    }
+
+    bool PrefabRegistry::prewarm(const std::string& prefab_name, size_t count)
+    {
+        auto it = name_index_.find(prefab_name);
+        if (it == name_index_.end())
+        {
+            spdlog::error("PrefabRegistry: 预热时找不到预制体 '{}'", prefab_name);
+            return false;
+        }
+        prefabs_[it->second]->pool->prewarm(count);
+        return true;
+    }
+
+    const engine::object::GameObjectPool* PrefabRegistry::findPool(const std::string& prefab_name) const
+    {
+        auto it = name_index_.find(prefab_name);
+        return it != name_index_.end() ? prefabs_[it->second]->pool.get() : nullptr;
+    }
+
+    engine::object::GameObjectPool::Stats PrefabRegistry::getTotalPoolStats() const
+    {
+        engine::object::GameObjectPool::Stats total;
+        for (const auto& prefab : prefabs_)
+        {
+            const auto& stats = prefab->pool->getStats();
+            total.created += stats.created;
+            total.active += stats.active;
+            total.free += stats.free;
+            total.peak_active += stats.peak_active;
+            total.acquired += stats.acquired;
+            total.reused += stats.reused;
+        }
+        return total;
+    }
+
+    const PrefabTemplate* PrefabRegistry::findPrefab(const std::string& name) const
+    {
+        auto it = name_index_.find(name);
+        return it != name_index_.end() ? prefabs_[it->second]->data.get() : nullptr;
+    }
+
+    std::optional<size_t> PrefabRegistry::findPrefabIndex(const LevelObjectRecord& object)
+    {
+        if (!object.type.empty())
+        {
+            if (auto it = type_index_.find(object.type); it != type_index_.end()) return it->second;
+        }
+        if (!object.name.empty())
+        {
+            if (auto it = name_index_.find(object.name); it != name_index_.end()) return it->second;
+        }
+        if (object.gid != 0) return prefabForGid(object.gid & engine::component::TileLayerComponent::GID_MASK);
+        return std::nullopt;
+    }
+
+    std::optional<size_t> PrefabRegistry::prefabForGid(std::uint32_t gid)
+    {
+        if (auto it = gid_index_.find(gid); it != gid_index_.end()) return it->second;
+        if (!tilesets_) return std::nullopt;
+
+        //按图块集中该图块的图片生成预制体，名称为图片路径（整图）或 图片路径#源矩形
+        const auto* tileset = engine::component::findTileSet(*tilesets_, gid);
+        if (!tileset) return std::nullopt;
+        const std::uint32_t local_id = gid - tileset->first_gid;
+        PrefabTemplate prefab;
+        if (tileset->columns > 0)
+        {
+            const int tile_col = static_cast<int>(local_id) % tileset->columns;
+            const int tile_row = static_cast<int>(local_id) / tileset->columns;
+            prefab.texture_id = tileset->image_id;
+            prefab.source_rect = SDL_FRect{static_cast<float>(tileset->margin + tile_col * (static_cast<int>(tileset->tile_size.x) + tileset->spacing)),
+                                           static_cast<float>(tileset->margin + tile_row * (static_cast<int>(tileset->tile_size.y) + tileset->spacing)),
+                                           tileset->tile_size.x, tileset->tile_size.y};
+        }
+        else
+        {
+            auto image_it = tileset->images.find(local_id);
+            if (image_it == tileset->images.end()) return std::nullopt;
+            prefab.texture_id = image_it->second.image_id;
+            prefab.source_rect = image_it->second.source_rect;
+        }
+        prefab.name = prefab.texture_id;
+        if (prefab.source_rect)
+        {
+            const auto& rect = *prefab.source_rect;
+            prefab.name += "#" + std::to_string(static_cast<int>(rect.x)) + "," + std::to_string(static_cast<int>(rect.y)) + ","
+                         + std::to_string(static_cast<int>(rect.w)) + "," + std::to_string(static_cast<int>(rect.h));
+        }
+
+        auto it = name_index_.find(prefab.name);
+        if (it == name_index_.end())
+        {
+            if (!registerPrefab(std::move(prefab))) return std::nullopt;
+            it = name_index_.find(prefabs_.back()->data->name);
+        }
+        gid_index_.emplace(gid, it->second);
+        return it->second;
+    }
+
+    std::unique_ptr<engine::object::GameObject> PrefabRegistry::createInstance(Prefab& prefab)
+    {
+        const auto& data = *prefab.data;
+        auto game_object = std::make_unique<engine::object::GameObject>(data.name, data.tag);
+        game_object->addComponent<engine::component::TransformComponent>();
+        if (!data.texture_id.empty())
+        {
+            //第一个实例解析纹理句柄，之后的实例拷贝已解析的精灵
+            engine::component::SpriteComponent* sprite = prefab.sprite
+                ? game_object->addComponent<engine::component::SpriteComponent>(*prefab.sprite, resource_manager_, data.alignment)
+                : game_object->addComponent<engine::component::SpriteComponent>(data.texture_id, resource_manager_, data.alignment, data.source_rect);
+            if (!prefab.sprite) prefab.sprite = sprite->getSprite();
+        }
+        if (prefab.builder) prefab.builder(*game_object, data);
+        return game_object;
+    }
+
+    std::unique_ptr<engine::object::GameObject> PrefabRegistry::acquire(Prefab& prefab, const std::string& name, const glm::vec2& position,
+                                                                        const glm::vec2& size, float rotation, bool is_flipped, bool is_visible)
+    {
+        auto game_object = prefab.pool->acquire();
+        if (!game_object) return nullptr;
+        if (game_object->getName() != name) game_object->setName(name);
+
+        //重置实例状态：Tiled 对象尺寸与图片尺寸不同时按比例缩放
+        glm::vec2 scale = {1.0f, 1.0f};
+        auto* sprite = game_object->getComponent<engine::component::SpriteComponent>();
+        if (sprite)
+        {
+            const glm::vec2& sprite_size = sprite->getSpriteSize();
+            if (size.x > 0.0f && size.y > 0.0f && sprite_size.x > 0.0f && sprite_size.y > 0.0f) scale = size / sprite_size;
+            sprite->setFlipped(is_flipped);
+            sprite->setHidden(!is_visible);
+        }
+        if (auto* transform = game_object->getComponent<engine::component::TransformComponent>())
+        {
+            transform->setRotation(rotation);
+            transform->setScale(scale);
+            transform->teleport(position);
+            transform->savePreviousState();
+        }
+        return game_object;
+    }
+}
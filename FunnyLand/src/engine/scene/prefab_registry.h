@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL_rect.h>
+#include <glm/vec2.hpp>
+#include "../render/sprite.h"
+#include "../utils/alignment.h"
+#include "../component/tile_layer_component.h"
+#include "../object/game_object_pool.h"
+#include "binary_level.h"
+
+namespace engine::object
+{
+    class GameObject;
+}
+
+namespace engine::resource
+{
+    class ResourceManager;
+}
+
+namespace engine::scene
+{
+    /// @brief 预制体的只读数据，同一预制体的所有实例共享一份
+    struct PrefabTemplate
+    {
+        std::string name;                                   ///< @brief 预制体名称（唯一）
+        std::string tag;                                    ///< @brief 实例的标签
+        std::string texture_id;                             ///< @brief 精灵纹理，为空表示实例没有 SpriteComponent
+        std::optional<SDL_FRect> source_rect;               ///< @brief 精灵源矩形，为空表示整张图片
+        engine::utils::Alignment alignment = engine::utils::Alignment::BOTTOM_LEFT;    ///< @brief 精灵对齐方式（Tiled 图块对象以左下角定位）
+    };
+
+    /**
+     * @brief 预制体注册表：把 Tiled 对象（按类型、名称或 gid）映射为预制体，并从回收池中创建实例。
+     *
+     * 匹配顺序：对象类型（bindType）-> 对象名称（与预制体同名）-> gid（bindGid，
+     * 没有绑定时按图块集中该图块的图片自动生成预制体，同一张图片的图块共用一个预制体）。
+     *
+     * 每个预制体一个 GameObjectPool：实例带 TransformComponent 和（有纹理时）SpriteComponent，
+     * 精灵在第一个实例初始化时解析纹理句柄和图集矩形，之后的实例直接拷贝，不再查找纹理。
+     * 场景移除实例时归还给池，再次实例化时只重置变换、翻转和可见性，不重新分配对象和组件。
+     * 由 Scene 持有，必须比场景中的实例活得久。
+     */
+    class PrefabRegistry final
+    {
+    public:
+        /// @brief 新建实例时调用，在 Transform/Sprite 之外添加组件（复用池中的实例时不会再调用）
+        using PrefabBuilder = std::function<void(engine::object::GameObject&, const PrefabTemplate&)>;
+
+    private:
+        struct Prefab
+        {
+            std::shared_ptr<const PrefabTemplate> data;             ///< @brief 只读数据
+            PrefabBuilder builder;                                  ///< @brief 附加组件
+            std::optional<engine::render::Sprite> sprite;           ///< @brief 已解析纹理句柄的精灵（第一个实例创建后填入）
+            std::unique_ptr<engine::object::GameObjectPool> pool;   ///< @brief 实例回收池
+        };
+
+        engine::resource::ResourceManager& resource_manager_;
+        std::vector<std::unique_ptr<Prefab>> prefabs_;                      ///< @brief 预制体（地址稳定，池的工厂持有指针）
+        std::unordered_map<std::string, size_t> name_index_;                ///< @brief 名称 -> 预制体
+        std::unordered_map<std::string, size_t> type_index_;                ///< @brief 对象类型 -> 预制体
+        std::unordered_map<std::uint32_t, size_t> gid_index_;               ///< @brief gid -> 预制体
+        std::shared_ptr<const engine::component::TileSetList> tilesets_;    ///< @brief 当前关卡的图块集（按 gid 自动生成预制体）
+
+    public:
+        explicit PrefabRegistry(engine::resource::ResourceManager& resource_manager);
+        ~PrefabRegistry();
+
+        PrefabRegistry(const PrefabRegistry&) = delete;
+        PrefabRegistry& operator=(const PrefabRegistry&) = delete;
+        PrefabRegistry(PrefabRegistry&&) = delete;
+        PrefabRegistry& operator=(PrefabRegistry&&) = delete;
+
+        /// @brief 注册预制体，名称已存在时失败并记录日志
+        bool registerPrefab(PrefabTemplate prefab, PrefabBuilder builder = {});
+        /// @brief 把 Tiled 对象类型（class）映射到预制体
+        bool bindType(const std::string& type, const std::string& prefab_name);
+        /// @brief 把 gid 映射到预制体（优先于按图块集自动生成）
+        bool bindGid(std::uint32_t gid, const std::string& prefab_name);
+        /// @brief 设置当前关卡的图块集（LevelLoader 读取图块集后调用）
+        void setTilesets(std::shared_ptr<const engine::component::TileSetList> tilesets) { tilesets_ = std::move(tilesets); }
+
+        /**
+         * @brief 按对象记录创建实例（未加入场景）。
+         * @param object 对象记录，位置为世界坐标
+         * @return 实例，没有匹配的预制体时返回空
+         */
+        std::unique_ptr<engine::object::GameObject> instantiate(const LevelObjectRecord& object);
+        /// @brief 按预制体名称在指定位置创建实例（未加入场景），没有该预制体时返回空
+        std::unique_ptr<engine::object::GameObject> instantiate(const std::string& prefab_name, const glm::vec2& position);
+
+        /// @brief 预先创建实例，让预制体的空闲实例不少于 count 个（之后的生成不再分配内存），没有该预制体时返回 false
+        bool prewarm(const std::string& prefab_name, size_t count);
+
+        const PrefabTemplate* findPrefab(const std::string& name) const;    ///< @brief 查找预制体，没有时返回 nullptr
+        const engine::object::GameObjectPool* findPool(const std::string& prefab_name) const;  ///< @brief 查找预制体的回收池，没有时返回 nullptr
+        engine::object::GameObjectPool::Stats getTotalPoolStats() const;    ///< @brief 所有回收池统计之和（peak_active 为各池最高水位之和）
+        size_t getPrefabCount() const { return prefabs_.size(); }           ///< @brief 预制体数量
+
+    private:
+        std::optional<size_t> findPrefabIndex(const LevelObjectRecord& object);  ///< @brief 按类型、名称、gid 查找对象对应的预制体
+        std::optional<size_t> prefabForGid(std::uint32_t gid);                  ///< @brief gid 对应的预制体（必要时按图块集生成）
+        std::unique_ptr<engine::object::GameObject> createInstance(Prefab& prefab);    ///< @brief 池的工厂：新建实例
+        std::unique_ptr<engine::object::GameObject> acquire(Prefab& prefab, const std::string& name, const glm::vec2& position,
+                                                            const glm::vec2& size, float rotation, bool is_flipped, bool is_visible);
+    };
+}
@@ -1,6 +1,16 @@
 ﻿#include "scene.h"
 #include "../object/game_object.h"
+#include "../object/component_storage.h"
+#include "../object/game_object_pool.h"
 #include "scene_manager.h"
+#include "spatial_grid.h"
+#include "level_streamer.h"
+#include "prefab_registry.h"
+#include "../component/transform_component.h"
+#include "../core/context.h"
+#include "../core/profiler.h"
+#include "../render/renderer.h"
+#include "../render/camera.h"
 #include <algorithm> // for std::remove_if
 #include <spdlog/spdlog.h>
 
@@ -8,14 +18,22 @@ namespace engine::scene
 {
     Scene::Scene(std::string scene_name, engine::core::Context& context,
         engine::scene::SceneManager& scene_manager)
-        : scene_name_(std::move(scene_name)), context_(context), scene_manager_(scene_manager),
-        is_initialized_(false)
+        : scene_name_(std::move(scene_name)), memory_tag_(getMemoryTagFor(scene_name_)),
+        context_(context), scene_manager_(scene_manager),
+        is_initialized_(false), component_storage_(std::make_unique<engine::object::ComponentStorage>()),
+        prefab_registry_(std::make_unique<engine::scene::PrefabRegistry>(context.getResourceManager())),
+        spatial_grid_(std::make_unique<engine::scene::SpatialGrid>())
     {
         spdlog::trace("构造场景 {} 完成", scene_name_);
     }
 
     Scene::~Scene() = default;
 
+    engine::core::MemoryTag Scene::getMemoryTagFor(const std::string& scene_name)
+    {
+        return engine::core::MemoryTracker::registerTag("Scene:" + scene_name);
+    }
+
     void Scene::init()
     {
         is_initialized_ = true;//子类应该最后调用父类init方法
@@ -25,50 +43,81 @@ namespace engine::scene
     void Scene::update(float delta_time)
     {
         if (!is_initialized_) return;
+        ENGINE_PROFILE_SCOPE("Scene::update");
+        
+        // 流式加载：按相机载入/卸载区块，新建的对象在本轮最后加入场景
+        if (level_streamer_) level_streamer_->update(context_.getCamera());
+        
+        // 先统一记录所有对象的上一步变换（不能放在对象更新循环里，否则先更新的对象移动后面的对象时会被记成“上一步”）
+        for (const auto& obj : game_objects_)
+        {
+            if (!obj) continue;
+            if (auto* transform = obj->getComponent<engine::component::TransformComponent>()) transform->savePreviousState();
+        }
         
         //更新游戏中的所有对象，并删除需要移除的对象
-        for (auto it = game_objects_.begin(); it != game_objects_.end();)
+        for (size_t i = 0; i < game_objects_.size();)
         {
-            if (*it&&!(*it)->isNeedRemoved())
+            const auto& obj = game_objects_[i];
+            if (obj && !obj->isNeedRemoved())
             {
-                (*it)->update(delta_time, context_);
-                ++it;
+                // 使用组件池的对象由下面的按类型批量更新处理
+                if (!obj->getComponentStorage()) obj->update(delta_time, context_);
+                ++i;
             }
             else
             {
-                if (*it)
-                {
-                    (*it)->clean();
-                }
-                it = game_objects_.erase(it); // 删除需要移除的对象，智能指针自动管理内存
+                eraseGameObjectAt(i); // 末尾的对象换到当前位置，不前进下标，本轮继续处理它
             }
         }
         
+        // 组件池中的组件：逐类型线性更新，声明了访问的类型按阶段在工作线程中并行更新
+        {
+            ENGINE_PROFILE_SCOPE("ComponentStorage::updateAll");
+            component_storage_->updateAll(delta_time, context_, &context_.getJobSystem());
+        }
+        
         processPendingAdditions();// 处理待添加（延时添加）的游戏对象
     }
 
     void Scene::render()
     {
         if (!is_initialized_) return;
-        // 渲染所有游戏对象
-        for (const auto& obj : game_objects_) {
-            if (obj) obj->render(context_);
+        ENGINE_PROFILE_SCOPE("Scene::render");
+        
+        // 渲染期间收集精灵绘制命令，结束时按纹理批量提交
+        auto& renderer = context_.getRenderer();
+        renderer.beginSpriteBatch();
+        
+        // 同步本帧移动过的对象，再用相机视野查询空间网格，只渲染可见对象（按加入场景的顺序）
+        const auto& camera = context_.getCamera();
+        {
+            ENGINE_PROFILE_SCOPE("SpatialGrid::query");
+            spatial_grid_->refreshDirty();
+            spatial_grid_->query({camera.getPosition(), camera.getViewportSize()}, visible_objects_);
+        }
+        
+        for (auto* obj : visible_objects_) {
+            obj->render(context_);
         }
+        
+        renderer.endSpriteBatch();
     }
 
     void Scene::handleInput()
     {
         if (!is_initialized_) return;
+        ENGINE_PROFILE_SCOPE("Scene::handleInput");
         
         // 遍历所有游戏对象，并删除需要移除的对象
-        for (auto it = game_objects_.begin(); it != game_objects_.end();) {
-            if (*it && !(*it)->isNeedRemoved()) {
-                (*it)->handleInput(context_);
-                ++it;
+        for (size_t i = 0; i < game_objects_.size();) {
+            const auto& obj = game_objects_[i];
+            if (obj && !obj->isNeedRemoved()) {
+                obj->handleInput(context_);
+                ++i;
             } else {
                 // 安全删除需要移除的对象
-                if (*it) (*it)->clean();
-                it = game_objects_.erase(it);
+                eraseGameObjectAt(i);
             }
         }
     }
@@ -77,10 +126,13 @@ namespace engine::scene
     {
         if (!is_initialized_) return;
         
-        for (const auto& obj : game_objects_) {
-            if (obj) obj->clean();
+        level_streamer_.reset();//流式加载器引用图层组件，先于对象销毁
+        for (auto& obj : game_objects_) {
+            if (obj) destroyGameObject(std::move(obj));   // 预制体实例归还回收池，场景重新初始化时复用
         }
+        spatial_grid_->clear();
         game_objects_.clear();
+        visible_objects_.clear();
         
         is_initialized_ = false;        // 清理完成后，设置场景为未初始化
         spdlog::trace("场景 '{}' 清理完成。", scene_name_);
@@ -88,10 +140,20 @@ namespace engine::scene
 
     void Scene::addGameObject(std::unique_ptr<engine::object::GameObject>&& game_object)
     {
-        if (game_object) game_objects_.push_back(std::move(game_object));
+        if (game_object)
+        {
+            spatial_grid_->insert(game_object.get());
+            game_object->setInScene(true);  //此后组件池中的组件才参与批量更新（待添加队列中的对象不更新）
+            game_objects_.push_back(std::move(game_object));
+        }
         else spdlog::warn("尝试向场景 '{}' 添加空游戏对象指针。", scene_name_);
     }
 
+    std::unique_ptr<engine::object::GameObject> Scene::createPooledGameObject(const std::string& name, const std::string& tag)
+    {
+        return std::make_unique<engine::object::GameObject>(name, tag, component_storage_.get());
+    }
+
     void Scene::safeAddGameObject(std::unique_ptr<engine::object::GameObject>&& game_object)
     {
         if (game_object) pending_additions_.push_back(std::move(game_object));
@@ -106,9 +168,8 @@ namespace engine::scene
             return;
         }
         
-        // erase-remove 移除法不可用，因为智能指针与裸指针无法比较
-        // 需要使用 std::remove_if 和 lambda 表达式自定义比较的方式
-        auto it = std::remove_if(game_objects_.begin(), game_objects_.end(),
+        // 智能指针与裸指针无法直接比较，使用 std::find_if 和 lambda 表达式自定义比较的方式
+        auto it = std::find_if(game_objects_.begin(), game_objects_.end(),
             [game_object_ptr](const std::unique_ptr<engine::object::GameObject>& obj)
             {
                 return obj.get() == game_object_ptr;// 比较裸指针是否相等（自定义比较方式）
@@ -116,9 +177,8 @@ namespace engine::scene
         
         if (it != game_objects_.end())
         {
-            (*it)->clean();
-            game_objects_.erase(it,game_objects_.end()); // 删除从 it 到容器末尾的所有元素 最后一个元素
-            spdlog::trace("从场景 '{}' 中成功移除游戏对象 '{}'。", scene_name_, game_object_ptr->getName());
+            spdlog::trace("从场景 '{}' 中移除游戏对象 '{}'。", scene_name_, game_object_ptr->getName());
+            eraseGameObjectAt(static_cast<size_t>(it - game_objects_.begin()));
         }
         else
         {
@@ -127,11 +187,38 @@ namespace engine::scene
         
     }
 
+    void Scene::eraseGameObjectAt(size_t index)
+    {
+        if (game_objects_[index]) destroyGameObject(std::move(game_objects_[index]));
+        // 与末尾交换后弹出，O(1)，不移动其他元素（绘制顺序由空间网格按加入顺序保证，不依赖容器顺序）
+        if (index + 1 != game_objects_.size()) game_objects_[index] = std::move(game_objects_.back());
+        game_objects_.pop_back();
+    }
+
+    void Scene::destroyGameObject(std::unique_ptr<engine::object::GameObject>&& game_object)
+    {
+        spatial_grid_->remove(game_object.get());
+        game_object->setInScene(false);
+        if (level_streamer_) level_streamer_->onObjectRemoved(game_object.get());
+        if (auto* pool = game_object->getPool())
+        {
+            pool->release(std::move(game_object));  // 预制体实例归还给回收池，组件保留以便复用
+            return;
+        }
+        game_object->clean();
+        game_object.reset();
+    }
+
     void Scene::safeRemoveGameObject(engine::object::GameObject* game_object_ptr)
     {
         if (game_object_ptr) game_object_ptr->setNeedRemoved(true);
     }
 
+    void Scene::setLevelStreamer(std::unique_ptr<engine::scene::LevelStreamer>&& level_streamer)
+    {
+        level_streamer_ = std::move(level_streamer);
+    }
+
     engine::object::GameObject* Scene::findGameObjectByName(const std::string& name) const
     {
         for (const auto& obj : game_objects_)
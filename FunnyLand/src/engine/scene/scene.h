@@ -2,11 +2,13 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "../core/memory_tracker.h"
 
 
 namespace engine::object
 {
     class GameObject;
+    class ComponentStorage;
 }
 
 namespace engine::core
@@ -17,6 +19,16 @@ namespace engine::core
 namespace engine::scene
 {
     class SceneManager;
+    class SpatialGrid;
+    class LevelStreamer;
+    class PrefabRegistry;
+    
+    /// @brief 场景初始化时会用到的资源，预加载时在后台提前解码
+    struct SceneAssets
+    {
+        std::vector<std::string> textures;  ///< @brief 纹理路径
+        std::vector<std::string> sounds;    ///< @brief 音效路径
+    };
 
 
     /**
@@ -30,11 +42,17 @@ namespace engine::scene
         
     protected:
         std::string scene_name_; // 场景名称
+        engine::core::MemoryTag memory_tag_; // 内存统计标签（"Scene:场景名"，SceneManager 调用场景方法时切换到该标签）
         engine::core::Context& context_; // 场景上下文
         engine::scene::SceneManager& scene_manager_; // 场景管理器引用
         bool is_initialized_ = false;  //场景是否已初始化 当前场景很可能没被删除，加个标记避免重复初始化
-        std::vector<std::unique_ptr<engine::object::GameObject>> game_objects_; // 场景中的游戏对象指针
+        std::unique_ptr<engine::object::ComponentStorage> component_storage_; // 组件池存储（必须声明在游戏对象容器之前，保证最后析构）
+        std::unique_ptr<engine::scene::PrefabRegistry> prefab_registry_;    // 预制体注册表（持有实例回收池，必须声明在游戏对象容器之前）
+        std::unique_ptr<engine::scene::LevelStreamer> level_streamer_;      // 无限地图的流式加载器（没有时为空，引用图层对象，先于游戏对象清理）
+        std::vector<std::unique_ptr<engine::object::GameObject>> game_objects_; // 场景中的游戏对象指针（移除时与末尾交换，顺序不固定）
         std::vector<std::unique_ptr<engine::object::GameObject>> pending_additions_; // 待添加的游戏对象指针(延时添加)
+        std::unique_ptr<engine::scene::SpatialGrid> spatial_grid_;          // 空间网格，渲染时只处理相机视野内的对象
+        std::vector<engine::object::GameObject*> visible_objects_;         // 本帧可见对象（复用缓冲）
     public:
         /**
          * @brief 构造函数，初始化场景名称、上下文和场景管理器引用。
@@ -60,6 +78,15 @@ namespace engine::scene
         virtual void handleInput();                 ///< @brief 处理输入。
         virtual void clean();                       ///< @brief 清理场景。
         
+        /**
+         * @brief 列出 init() 需要的资源，供 SceneManager 预加载。
+         * 在后台线程调用，只能读文件，不能访问 context_ 和场景状态。默认没有需要预加载的资源。
+         */
+        virtual SceneAssets discoverAssets() const { return {}; }
+        
+        /// @brief 作为加载场景时，由 SceneManager 每帧报告预加载进度（0~1）
+        virtual void onLoadingProgress(float /*progress*/) {}
+        
         /// @brief 直接向场景中添加一个游戏对象。（初始化时可用，游戏进行中不安全） （&&表示右值引用，与std::move搭配使用，避免拷贝）
         virtual void addGameObject(std::unique_ptr<engine::object::GameObject>&& game_object);
         
@@ -75,6 +102,23 @@ namespace engine::scene
         /// @brief 获取场景中的游戏对象容器。
         const std::vector<std::unique_ptr<engine::object::GameObject>>& getGameObjects() const { return game_objects_; }
         
+        /// @brief 创建一个使用本场景组件池存储的游戏对象（组件按类型连续存放，update 时按类型批量更新）。
+        std::unique_ptr<engine::object::GameObject> createPooledGameObject(const std::string& name = "", const std::string& tag = "");
+        
+        /// @brief 获取组件池存储。
+        engine::object::ComponentStorage& getComponentStorage() const { return *component_storage_; }
+        
+        /// @brief 获取空间网格（视野剔除用）。
+        engine::scene::SpatialGrid& getSpatialGrid() const { return *spatial_grid_; }
+        
+        /// @brief 获取预制体注册表（关卡对象图层按它创建对象）。
+        engine::scene::PrefabRegistry& getPrefabRegistry() const { return *prefab_registry_; }
+        
+        /// @brief 设置流式加载器（LevelLoader 加载无限地图时设置），每帧 update 时按相机载入和卸载区块
+        void setLevelStreamer(std::unique_ptr<engine::scene::LevelStreamer>&& level_streamer);
+        /// @brief 获取流式加载器（没有时为空）。
+        engine::scene::LevelStreamer* getLevelStreamer() const { return level_streamer_.get(); }
+        
         /// @brief 根据名称查找游戏对象（返回找到的第一个对象）。
         engine::object::GameObject* findGameObjectByName(const std::string& name) const;
         
@@ -83,6 +127,9 @@ namespace engine::scene
         const std::string& getName() const { return scene_name_; }                  ///< @brief 获取场景名称
         void setInitialized(bool initialized) { is_initialized_ = initialized; }    ///< @brief 设置场景是否已初始化
         bool isInitialized() const { return is_initialized_; }                      ///< @brief 获取场景是否已初始化
+        engine::core::MemoryTag getMemoryTag() const { return memory_tag_; }        ///< @brief 获取内存统计标签
+        /// @brief 场景名对应的内存统计标签（在一个场景中创建要切换到的新场景时，先切换到新场景的标签，否则新场景的内存记在当前场景名下）
+        static engine::core::MemoryTag getMemoryTagFor(const std::string& scene_name);
         
         engine::core::Context& getContext() const { return context_; }                  ///< @brief 获取上下文引用
         engine::scene::SceneManager& getSceneManager() const { return scene_manager_; } ///< @brief 获取场景管理器引用
@@ -90,6 +137,10 @@ namespace engine::scene
         
     protected:
         void processPendingAdditions();     ///< @brief 处理待添加的游戏对象。（每轮更新的最后调用）
+        /// @brief 移除 game_objects_[index]：销毁（或归还回收池）后用末尾元素填补空位
+        void eraseGameObjectAt(size_t index);
+        /// @brief 销毁已从容器中取出的对象：移出空间网格、通知流式加载器，来自回收池的对象归还给池，其余清理后销毁
+        void destroyGameObject(std::unique_ptr<engine::object::GameObject>&& game_object);
     };
 }
 
@@ -1,10 +1,29 @@
 ﻿#include "scene_manager.h"
 #include "scene.h"
 #include "../core/context.h"
+#include "../core/memory_tracker.h"
+#include "../core/profiler.h"
+#include "../render/renderer.h"
+#include "../resource/resource_manager.h"
+#include <chrono>
+#include <future>
 #include <spdlog/spdlog.h>
 
 namespace engine::scene
 {
+    struct SceneManager::PreloadRequest
+    {
+        std::unique_ptr<Scene> scene;                   // 就绪后切换到的场景
+        std::unique_ptr<Scene> loading_scene;           // 尚未压入的加载场景
+        Scene* loading_scene_ptr = nullptr;             // 已压入栈顶的加载场景（仅用于比较和报告进度）
+        bool replace = true;
+        std::future<SceneAssets> discovery;             // 后台资源发现。声明在 scene 之后，先析构（会等待后台线程结束）
+        bool loads_started = false;                     // 资源发现完成后是否已发起异步加载
+        std::vector<engine::resource::TextureHandle> textures;
+        std::vector<std::shared_future<Mix_Chunk*>> sounds;
+        float progress = 0.0f;
+    };
+    
     SceneManager::SceneManager(engine::core::Context& context)
         :context_(context)
     {
@@ -13,6 +32,8 @@ namespace engine::scene
 
     SceneManager::~SceneManager()
     {
+        preload_.reset();
+        cancelled_preloads_.clear();
         spdlog::trace("场景管理器析构完成。");
         close();
     }
@@ -34,6 +55,37 @@ namespace engine::scene
         pending_scene_ = std::move(scene);
     }
 
+    void SceneManager::requestPreloadScene(std::unique_ptr<engine::scene::Scene>&& scene, bool replace,
+                                           std::unique_ptr<engine::scene::Scene>&& loading_scene)
+    {
+        if (!scene)
+        {
+            spdlog::warn("尝试预加载空场景指针。");
+            return;
+        }
+        ENGINE_MEMORY_SCOPE(engine::core::memory_tags::ENGINE);  //预加载状态属于场景管理器，不记在发起请求的场景名下
+        if (preload_)
+        {
+            //调用者通常就是栈顶的加载场景（在它自己的 update() 中），这里不能弹出它；
+            //后台资源发现也可能还在读取旧的目标场景，请求整体移到取消列表，之后逐帧检查，不在这里等待
+            spdlog::warn("场景 '{}' 的预加载被新的预加载请求取消。", preload_->scene->getName());
+            cancelled_preloads_.push_back(std::move(preload_));
+        }
+        spdlog::debug("开始预加载场景 '{}'。", scene->getName());
+        
+        preload_ = std::make_unique<PreloadRequest>();
+        preload_->scene = std::move(scene);
+        preload_->loading_scene = std::move(loading_scene);
+        preload_->replace = replace;
+        const Scene* target = preload_->scene.get();
+        preload_->discovery = std::async(std::launch::async, [target]() { return target->discoverAssets(); });
+    }
+
+    float SceneManager::getPreloadProgress() const
+    {
+        return preload_ ? preload_->progress : 1.0f;
+    }
+
     Scene* SceneManager::getCurrentScene() const
     {
         if (scene_stack_.empty())
@@ -45,30 +97,41 @@ namespace engine::scene
 
     void SceneManager::update(float delta_time)
     {
+        ENGINE_PROFILE_SCOPE("SceneManager::update");
         Scene* current_scene = getCurrentScene();
         if (current_scene)
         {
+            ENGINE_MEMORY_SCOPE(current_scene->getMemoryTag());
             current_scene->update(delta_time);
         }
         
         //执行可能的切换场景操作
         processPendingActions();
+        updatePreload();
     }
 
     void SceneManager::render()
     {
-        // 渲染时需要叠加渲染所有场景，而不只是栈顶
-        for (const auto& scene : scene_stack_)
+        ENGINE_PROFILE_SCOPE("SceneManager::render");
+        // 渲染时需要叠加渲染所有场景，而不只是栈顶；每个场景一层，回放时上层场景总在下层之上
+        auto& renderer = context_.getRenderer();
+        for (size_t i = 0; i < scene_stack_.size(); ++i)
         {
-            if (scene) scene->render();
+            if (!scene_stack_[i]) continue;
+            renderer.setRenderLayer(static_cast<int>(i));
+            ENGINE_MEMORY_SCOPE(scene_stack_[i]->getMemoryTag());
+            scene_stack_[i]->render();
         }
+        renderer.setRenderLayer(0);
     }
 
     void SceneManager::handleInput()
     {
+        ENGINE_PROFILE_SCOPE("SceneManager::handleInput");
         //只考虑栈顶场景
         if (Scene* current_scene = getCurrentScene())
         {
+            ENGINE_MEMORY_SCOPE(current_scene->getMemoryTag());
             current_scene->handleInput();
         }
     }
@@ -76,22 +139,23 @@ namespace engine::scene
     void SceneManager::close()
     {
         spdlog::trace("正在关闭场景管理器...");
+        preload_.reset();
+        cancelled_preloads_.clear();    //关闭时可以等待后台资源发现结束
         // 清理所有场景 从顶到底
         while (!scene_stack_.empty())
         {
             if (scene_stack_.back())
             {
                 spdlog::debug("正在清理场景 '{}' 。", scene_stack_.back()->getName());
-                scene_stack_.back()->clean();
-                
             }
-            scene_stack_.pop_back();
+            destroyTopScene();
         }
         
     }
 
     void SceneManager::processPendingActions()
     {
+        processCancelledPreloads();
         if (pending_action_ == PendingAction::None) return;
 
         switch (pending_action_)
@@ -112,6 +176,83 @@ namespace engine::scene
         pending_action_ = PendingAction::None;
     }
 
+    void SceneManager::processCancelledPreloads()
+    {
+        if (cancelled_preloads_.empty()) return;
+        for (auto& request : cancelled_preloads_)
+        {
+            if (request->loading_scene_ptr && getCurrentScene() == request->loading_scene_ptr) popScene();
+            request->loading_scene_ptr = nullptr;
+        }
+        //后台资源发现引用着目标场景，结束后才能销毁请求
+        std::erase_if(cancelled_preloads_, [](const std::unique_ptr<PreloadRequest>& request) {
+            return !request->discovery.valid() || request->discovery.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+    }
+
+    void SceneManager::updatePreload()
+    {
+        if (!preload_) return;
+        ENGINE_PROFILE_SCOPE("SceneManager::updatePreload");
+        auto& request = *preload_;
+        auto& resource_manager = context_.getResourceManager();
+        
+        //1. 加载场景推迟到这里压入，与其它场景操作一样不在更新途中修改场景栈
+        if (request.loading_scene)
+        {
+            request.loading_scene_ptr = request.loading_scene.get();
+            pushScene(std::move(request.loading_scene));
+        }
+        
+        //2. 后台资源发现完成后，发起异步加载
+        if (!request.loads_started)
+        {
+            if (request.discovery.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+            SceneAssets assets = request.discovery.get();
+            request.textures.reserve(assets.textures.size());
+            {
+                //纹理显存记在目标场景名下，而不是当前的加载场景
+                ENGINE_MEMORY_SCOPE(request.scene->getMemoryTag());
+                for (const auto& path : assets.textures)
+                    request.textures.push_back(resource_manager.loadTextureAsync(path));
+            }
+            request.sounds.reserve(assets.sounds.size());
+            for (const auto& path : assets.sounds)
+                request.sounds.push_back(resource_manager.loadSoundAsync(path));
+            request.loads_started = true;
+            spdlog::debug("场景 '{}' 预加载 {} 个纹理、{} 个音效。", request.scene->getName(), assets.textures.size(), assets.sounds.size());
+        }
+        
+        //3. 统计完成情况（加载失败也算完成，init() 时会按同步流程再尝试并报错）
+        size_t done = 0;
+        for (auto handle : request.textures)
+        {
+            if (!resource_manager.isTextureLoading(handle)) ++done;
+        }
+        for (const auto& sound : request.sounds)
+        {
+            if (sound.wait_for(std::chrono::seconds(0)) == std::future_status::ready) ++done;
+        }
+        const size_t total = request.textures.size() + request.sounds.size();
+        request.progress = total > 0 ? static_cast<float>(done) / static_cast<float>(total) : 1.0f;
+        if (request.loading_scene_ptr && getCurrentScene() == request.loading_scene_ptr)
+        {
+            ENGINE_MEMORY_SCOPE(request.loading_scene_ptr->getMemoryTag());
+            request.loading_scene_ptr->onLoadingProgress(request.progress);
+        }
+        if (done < total) return;
+        
+        //4. 全部就绪，执行切换
+        spdlog::debug("场景 '{}' 预加载完成，执行切换。", request.scene->getName());
+        std::unique_ptr<Scene> scene = std::move(request.scene);
+        const bool replace = request.replace;
+        if (request.loading_scene_ptr && getCurrentScene() == request.loading_scene_ptr) popScene();
+        preload_.reset();
+        
+        if (replace) replaceScene(std::move(scene));
+        else pushScene(std::move(scene));
+    }
+
     void SceneManager::pushScene(std::unique_ptr<engine::scene::Scene>&& scene)
     {
         if (!scene)
@@ -124,6 +265,7 @@ namespace engine::scene
         //初始化新场景
         if (!scene->isInitialized())
         {
+            ENGINE_MEMORY_SCOPE(scene->getMemoryTag());
             scene->init();
         }
         //将新场景压入栈顶
@@ -140,11 +282,7 @@ namespace engine::scene
         spdlog::debug("正在从场景栈弹出场景 '{}'。", scene_stack_.back()->getName());
         
         //清理并移除栈顶场景
-        if (scene_stack_.back())
-        {
-            scene_stack_.back()->clean();
-        }
-        scene_stack_.pop_back();
+        destroyTopScene();
     }
 
     void SceneManager::replaceScene(std::unique_ptr<engine::scene::Scene>&& scene)
@@ -154,24 +292,51 @@ namespace engine::scene
             spdlog::warn("尝试将空场景指针替换场景栈顶场景。");
             return;
         }
-        spdlog::debug("正在将场景 '{}' 替换场景栈顶场景 '{}'。", scene->getName(), scene_stack_.back()->getName());
+        spdlog::debug("正在将场景 '{}' 替换场景栈顶场景 '{}'。", scene->getName(), scene_stack_.empty() ? "" : scene_stack_.back()->getName());
         
         //清理并移除场景栈中所有场景
         while (!scene_stack_.empty())
         {
-            if (scene_stack_.back())
-            {
-                scene_stack_.back()->clean();
-            }
-            scene_stack_.pop_back();
+            destroyTopScene(scene.get());
         }
         
         //初始化新场景
         if (!scene->isInitialized())
         {
+            ENGINE_MEMORY_SCOPE(scene->getMemoryTag());
             scene->init();
         }
         //将新场景压入栈顶
         scene_stack_.push_back(std::move(scene));
     }
+
+    void SceneManager::destroyTopScene(const Scene* incoming)
+    {
+        std::unique_ptr<Scene> scene = std::move(scene_stack_.back());
+        scene_stack_.pop_back();
+        if (!scene) return;
+        
+        const engine::core::MemoryTag tag = scene->getMemoryTag();
+        const std::string name = scene->getName();
+        {
+            ENGINE_MEMORY_SCOPE(tag);
+            scene->clean();
+        }
+        scene.reset();
+        
+        //场景在自己的标签下分配的堆内存应随场景一起释放；栈中还有同名场景（共用标签）时无法区分，不检查
+        if (!engine::core::MemoryTracker::isHeapTrackingEnabled()) return;
+        if (incoming && incoming->getMemoryTag() == tag) return;
+        for (const auto& other : scene_stack_)
+        {
+            if (other && other->getMemoryTag() == tag) return;
+        }
+        const auto snapshot = engine::core::MemoryTracker::snapshot();
+        const auto* stats = snapshot.find(engine::core::MemoryTracker::getTagName(tag));
+        if (stats && stats->heap_bytes > 0)
+        {
+            spdlog::warn("场景 '{}' 销毁后其内存标签仍有 {} 字节（{} 次分配）未释放，可能存在泄漏或被其它系统持有。",
+                         name, stats->heap_bytes, stats->heap_allocations);
+        }
+    }
 }
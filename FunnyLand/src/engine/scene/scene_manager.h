@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <memory>
 #include <vector>
+#include "level_streamer.h"
 
 // 前置声明
 namespace engine::core {
@@ -16,6 +17,9 @@ namespace engine::scene
     
     /**
      * @brief 管理游戏中的场景栈，处理场景切换和生命周期。
+     *
+     * 除了立即切换，还支持预加载切换（requestPreloadScene）：后台发现并解码新场景的资源，
+     * 当前场景（或可选的加载场景）照常运行，资源全部就绪后才执行切换，init() 时不再阻塞在磁盘 I/O 和解码上。
      */
     class SceneManager final
     {
@@ -27,6 +31,11 @@ namespace engine::scene
         PendingAction pending_action_ = PendingAction::None; // 当前待处理操作
         std::unique_ptr<engine::scene::Scene> pending_scene_;               //待处理的场景
         
+        struct PreloadRequest;                  //预加载状态（定义在 cpp 中）
+        std::unique_ptr<PreloadRequest> preload_; //进行中的预加载（没有时为空）
+        std::vector<std::unique_ptr<PreloadRequest>> cancelled_preloads_; //被取消的预加载：加载场景在处理挂起操作时弹出，后台资源发现结束后再销毁
+        StreamingSettings streaming_settings_;      //无限地图的流式加载参数（LevelLoader 创建流式加载器时使用）
+        
     public:
         explicit SceneManager(engine::core::Context& context);
         ~SceneManager();
@@ -44,9 +53,24 @@ namespace engine::scene
         void requestPopScene(); //请求弹出当前场景 
         void requestReplaceScene(std::unique_ptr<engine::scene::Scene>&& scene); //请求用新场景替换当前场景
         
+        /**
+         * @brief 请求预加载切换：资源在后台加载，全部就绪后再替换（或压入）场景。
+         * 新的预加载请求会取消进行中的预加载（可以在加载场景自己的 update() 中调用）：
+         * 被取消的加载场景与其它场景操作一样推迟到本轮更新结束后弹出，后台资源发现也不在调用线程上等待。
+         * @param scene 目标场景
+         * @param replace true 时替换整个场景栈，false 时压入栈顶
+         * @param loading_scene 可选的加载场景，预加载期间压在栈顶并通过 onLoadingProgress 接收进度，切换前弹出
+         */
+        void requestPreloadScene(std::unique_ptr<engine::scene::Scene>&& scene, bool replace = true,
+                                 std::unique_ptr<engine::scene::Scene>&& loading_scene = nullptr);
+        bool isPreloading() const { return preload_ != nullptr; }   //是否有进行中的预加载
+        float getPreloadProgress() const;                           //预加载进度（0~1，没有预加载时为 1）
+        
         //getter
         Scene* getCurrentScene() const;       //获取当前场景指针 栈顶场景
         engine::core::Context& context() const { return context_; } // 获取引擎上下文引用
+        const StreamingSettings& getStreamingSettings() const { return streaming_settings_; }  //获取流式加载参数
+        void setStreamingSettings(const StreamingSettings& settings) { streaming_settings_ = settings; } //设置流式加载参数
         
         //核心循环函数
         void update(float delta_time);      ///< @brief 更新场景。
@@ -56,10 +80,13 @@ namespace engine::scene
         
     private:
         void processPendingActions();   //处理挂起的场景操作 (每轮更新后最后调用)
+        void updatePreload();           //推进预加载，资源就绪后执行切换（每轮更新处理完挂起操作后调用）
+        void processCancelledPreloads(); //弹出被取消的加载场景，销毁后台资源发现已结束的预加载请求
         //直接切换场景
         void pushScene(std::unique_ptr<engine::scene::Scene>&& scene);    //将一个新场景压入栈顶,使其成为当前活动场景
         void popScene();                    //弹出栈顶场景
         void replaceScene(std::unique_ptr<engine::scene::Scene>&& scene);  //清理场景栈所有场景，将此场景设为栈顶场景
+        void destroyTopScene(const Scene* incoming = nullptr); //清理并销毁栈顶场景，之后检查该场景的内存标签是否还有未释放的分配（incoming 为即将压入的场景，同名时共用标签，不检查）
         
         
         
@@ -0,0 +1,207 @@
+﻿#include "spatial_grid.h"
+#include "../object/game_object.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene
+{
+    SpatialGrid::SpatialGrid(float cell_size)
+        : cell_size_(cell_size)
+    {
+        if (cell_size_ <= 0.0f)
+        {
+            spdlog::warn("SpatialGrid 单元尺寸无效 ({})，使用默认值 128", cell_size_);
+            cell_size_ = 128.0f;
+        }
+    }
+
+    void SpatialGrid::insert(engine::object::GameObject* object)
+    {
+        if (!object) return;
+        if (entries_.contains(object))
+        {
+            spdlog::warn("SpatialGrid: 对象 '{}' 已登记，忽略重复插入", object->getName());
+            return;
+        }
+        
+        //优先复用之前移除对象留下的节点
+        Entry* entry_ptr = nullptr;
+        if (!free_nodes_.empty())
+        {
+            auto node = std::move(free_nodes_.back());
+            free_nodes_.pop_back();
+            node.key() = object;
+            node.mapped() = Entry{};
+            entry_ptr = &entries_.insert(std::move(node)).position->second;
+        }
+        else
+        {
+            entry_ptr = &entries_[object];
+        }
+        Entry& entry = *entry_ptr;
+        entry.object = object;
+        entry.order = next_order_++;
+        link(entry);
+        
+        object->setSpatialGrid(this);
+        object->setBoundsDirty(false);
+    }
+
+    void SpatialGrid::remove(engine::object::GameObject* object)
+    {
+        auto it = entries_.find(object);
+        if (it == entries_.end()) return;
+        
+        unlink(it->second);
+        if (object->isBoundsDirty())
+        {
+            std::erase(dirty_objects_, object);
+        }
+        object->setSpatialGrid(nullptr);
+        free_nodes_.push_back(entries_.extract(it));
+    }
+
+    void SpatialGrid::markDirty(engine::object::GameObject* object)
+    {
+        std::lock_guard lock(dirty_mutex_);
+        dirty_objects_.push_back(object);
+    }
+
+    void SpatialGrid::refreshDirty()
+    {
+        for (auto* object : dirty_objects_)
+        {
+            auto it = entries_.find(object);
+            if (it == entries_.end()) continue;
+            
+            unlink(it->second);
+            link(it->second);
+            object->setBoundsDirty(false);
+        }
+        dirty_objects_.clear();
+    }
+
+    void SpatialGrid::clear()
+    {
+        for (auto& [object, entry] : entries_)
+        {
+            object->setSpatialGrid(nullptr);
+        }
+        entries_.clear();
+        free_nodes_.clear();
+        cells_.clear();
+        free_cells_.clear();
+        unbounded_entries_.clear();
+        dirty_objects_.clear();
+    }
+
+    void SpatialGrid::query(const engine::utils::Rect& area, std::vector<engine::object::GameObject*>& out)
+    {
+        out.clear();
+        query_results_.clear();
+        ++query_stamp_;
+        
+        //始终可见的对象
+        query_results_.insert(query_results_.end(), unbounded_entries_.begin(), unbounded_entries_.end());
+        
+        //遍历区域覆盖的网格单元
+        glm::ivec2 min_cell = worldToCell(area.position);
+        glm::ivec2 max_cell = worldToCell(area.position + area.size);
+        for (int y = min_cell.y; y <= max_cell.y; ++y)
+        {
+            for (int x = min_cell.x; x <= max_cell.x; ++x)
+            {
+                auto cell_it = cells_.find(cellKey(x, y));
+                if (cell_it == cells_.end()) continue;
+                for (Entry* entry : cell_it->second)
+                {
+                    if (entry->query_stamp == query_stamp_) continue; //跨单元对象只收集一次
+                    entry->query_stamp = query_stamp_;
+                    query_results_.push_back(entry);
+                }
+            }
+        }
+        
+        //按插入顺序排序，保证与场景中的绘制顺序一致
+        std::sort(query_results_.begin(), query_results_.end(),
+            [](const Entry* a, const Entry* b) { return a->order < b->order; });
+        
+        out.reserve(query_results_.size());
+        for (const Entry* entry : query_results_)
+        {
+            out.push_back(entry->object);
+        }
+    }
+
+    void SpatialGrid::link(Entry& entry)
+    {
+        auto bounds = entry.object->getRenderBounds();
+        entry.is_bounded = bounds.has_value();
+        if (!entry.is_bounded)
+        {
+            unbounded_entries_.push_back(&entry);
+            return;
+        }
+        
+        entry.min_cell = worldToCell(bounds->position);
+        entry.max_cell = worldToCell(bounds->position + bounds->size);
+        for (int y = entry.min_cell.y; y <= entry.max_cell.y; ++y)
+        {
+            for (int x = entry.min_cell.x; x <= entry.max_cell.x; ++x)
+            {
+                getOrCreateCell(cellKey(x, y)).push_back(&entry);
+            }
+        }
+    }
+
+    void SpatialGrid::unlink(Entry& entry)
+    {
+        if (!entry.is_bounded)
+        {
+            std::erase(unbounded_entries_, &entry);
+            return;
+        }
+        
+        for (int y = entry.min_cell.y; y <= entry.max_cell.y; ++y)
+        {
+            for (int x = entry.min_cell.x; x <= entry.max_cell.x; ++x)
+            {
+                auto cell_it = cells_.find(cellKey(x, y));
+                if (cell_it == cells_.end()) continue;
+                
+                //单元内顺序无关（查询后会排序），交换到末尾再弹出
+                auto& cell = cell_it->second;
+                auto it = std::find(cell.begin(), cell.end(), &entry);
+                if (it != cell.end())
+                {
+                    *it = cell.back();
+                    cell.pop_back();
+                }
+                if (cell.empty()) free_cells_.push_back(cells_.extract(cell_it));
+            }
+        }
+    }
+
+    std::vector<SpatialGrid::Entry*>& SpatialGrid::getOrCreateCell(std::int64_t key)
+    {
+        if (auto it = cells_.find(key); it != cells_.end()) return it->second;
+        if (free_cells_.empty()) return cells_[key];
+        auto node = std::move(free_cells_.back());
+        free_cells_.pop_back();
+        node.key() = key;
+        return cells_.insert(std::move(node)).position->second;
+    }
+
+    glm::ivec2 SpatialGrid::worldToCell(const glm::vec2& world_pos) const
+    {
+        return {static_cast<int>(std::floor(world_pos.x / cell_size_)),
+                static_cast<int>(std::floor(world_pos.y / cell_size_))};
+    }
+
+    std::int64_t SpatialGrid::cellKey(int x, int y)
+    {
+        //高 32 位存 x，低 32 位存 y
+        return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+    }
+}
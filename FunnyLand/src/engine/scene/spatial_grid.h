@@ -0,0 +1,86 @@
+﻿#pragma once
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "../utils/math.h"
+
+namespace engine::object
+{
+    class GameObject;
+}
+
+namespace engine::scene
+{
+    /**
+     * @brief 均匀网格空间哈希，用于渲染时的视野剔除（broadphase）。
+     *
+     * 每个 GameObject 按其渲染包围盒（GameObject::getRenderBounds）登记到覆盖的所有网格单元中，
+     * 没有包围盒的对象（例如视差背景）视为始终可见。
+     * 对象移动时通过 markDirty() 进入脏列表，只有脏对象会在 refreshDirty() 中重新登记，
+     * 因此每帧的开销只与移动的对象数和可见的对象数有关，与场景总大小无关。
+     */
+    class SpatialGrid final
+    {
+    private:
+        struct Entry
+        {
+            engine::object::GameObject* object = nullptr;   ///< @brief 登记的对象
+            std::uint64_t order = 0;                        ///< @brief 插入顺序，查询结果按此排序以保持绘制顺序
+            bool is_bounded = false;                        ///< @brief 是否有包围盒（否则始终可见）
+            glm::ivec2 min_cell = {0, 0};                   ///< @brief 覆盖的网格范围（含）
+            glm::ivec2 max_cell = {0, 0};
+            std::uint32_t query_stamp = 0;                  ///< @brief 查询去重标记（跨多个单元的对象只返回一次）
+        };
+        
+        float cell_size_;                                                   ///< @brief 网格单元边长（世界坐标）
+        std::unordered_map<engine::object::GameObject*, Entry> entries_;    ///< @brief 对象 -> 登记信息（节点容器，Entry 地址稳定）
+        std::vector<decltype(entries_)::node_type> free_nodes_;            ///< @brief 移除对象后留下的节点，插入时复用，频繁生成/销毁对象时不分配内存
+        std::unordered_map<std::int64_t, std::vector<Entry*>> cells_;       ///< @brief 网格单元 -> 单元内的对象
+        std::vector<decltype(cells_)::node_type> free_cells_;              ///< @brief 变空的单元节点（保留 vector 容量），新单元优先复用
+        std::vector<Entry*> unbounded_entries_;                             ///< @brief 没有包围盒、始终可见的对象
+        std::vector<engine::object::GameObject*> dirty_objects_;            ///< @brief 包围盒已变化、等待重新登记的对象
+        std::mutex dirty_mutex_;                                            ///< @brief 保护 dirty_objects_（组件并行更新时对象在工作线程中移动）
+        std::vector<Entry*> query_results_;                                 ///< @brief 查询缓冲（复用，避免每帧分配）
+        std::uint64_t next_order_ = 0;
+        std::uint32_t query_stamp_ = 0;
+        
+    public:
+        /**
+         * @brief 构造函数
+         * @param cell_size 网格单元边长，建议取常见对象尺寸的数倍
+         */
+        explicit SpatialGrid(float cell_size = 128.0f);
+        
+        //禁止拷贝和移动（对象持有指向本网格的指针）
+        SpatialGrid(const SpatialGrid&) = delete;
+        SpatialGrid& operator=(const SpatialGrid&) = delete;
+        SpatialGrid(SpatialGrid&&) = delete;
+        SpatialGrid& operator=(SpatialGrid&&) = delete;
+        
+        void insert(engine::object::GameObject* object);        ///< @brief 登记对象（按当前包围盒），并让对象在移动时通知本网格
+        void remove(engine::object::GameObject* object);        ///< @brief 移除对象
+        void markDirty(engine::object::GameObject* object);     ///< @brief 标记对象包围盒已变化（由 GameObject 调用，可在工作线程中调用）
+        void refreshDirty();                                    ///< @brief 重新登记所有脏对象
+        void clear();                                           ///< @brief 清空所有登记
+        
+        /**
+         * @brief 查询与区域相交的对象（含始终可见的对象），结果按插入顺序排列。
+         * @param area 查询区域（世界坐标）
+         * @param out 输出列表，会先被清空
+         */
+        void query(const engine::utils::Rect& area, std::vector<engine::object::GameObject*>& out);
+        
+        size_t size() const { return entries_.size(); }         ///< @brief 登记的对象数量
+        float getCellSize() const { return cell_size_; }        ///< @brief 获取网格单元边长
+        
+    private:
+        void link(Entry& entry);                                ///< @brief 按对象当前包围盒把 entry 放入网格单元
+        void unlink(Entry& entry);                              ///< @brief 把 entry 从所有网格单元中移除
+        std::vector<Entry*>& getOrCreateCell(std::int64_t key); ///< @brief 获取网格单元，不存在时创建（优先复用空单元节点）
+        glm::ivec2 worldToCell(const glm::vec2& world_pos) const;
+        static std::int64_t cellKey(int x, int y);
+    };
+}
@@ -0,0 +1,522 @@
+#include "tiled_map_parser.h"
+#include "../resource/asset_archive.h"
+#include "../utils/decompress.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene
+{
+    namespace
+    {
+        using nlohmann::json;
+
+        //按 SAX 事件构建 JSON 值（与 nlohmann 内部的 json_sax_dom_parser 相同的做法）
+        class DomBuilder
+        {
+        private:
+            json* root_ = nullptr;
+            std::vector<json*> stack_;              ///< @brief 正在构建的对象/数组
+            json* object_element_ = nullptr;        ///< @brief 对象中下一个值的位置（由 key 设置）
+
+        public:
+            void reset(json& root)
+            {
+                root_ = &root;
+                stack_.clear();
+                object_element_ = nullptr;
+            }
+
+            size_t depth() const { return stack_.size(); }
+
+            void key(const std::string& key) { object_element_ = &(*stack_.back())[key]; }
+            void value(json&& value) { place(std::move(value)); }
+            void startObject() { stack_.push_back(place(json::object())); }
+            void startArray() { stack_.push_back(place(json::array())); }
+            void end() { stack_.pop_back(); }
+
+        private:
+            json* place(json&& value)
+            {
+                if (stack_.empty())
+                {
+                    *root_ = std::move(value);
+                    return root_;
+                }
+                if (stack_.back()->is_array())
+                {
+                    stack_.back()->push_back(std::move(value));
+                    return &stack_.back()->back();
+                }
+                *object_element_ = std::move(value);
+                return object_element_;
+            }
+        };
+
+        /*
+         * 事件分流：
+         * - 地图根对象的字段（除 layers）构建到 map_json；
+         * - layers 数组中的每个对象构建到单独的图层 JSON，对象结束时交给回调后释放；
+         * - 图层的 data 字段不进入 DOM：数组直接写入 gid 数组，字符串留到图层结束时解码
+         *   （Tiled 按字母序输出，encoding / compression 在 data 之后）；
+         * - 无限地图图层的 chunks 数组同样不进入 DOM，每个区块的 data 按上面的方式写入区块自己的 gid 数组。
+         */
+        class TiledMapSaxHandler final : public nlohmann::json_sax<json>
+        {
+        private:
+            enum class PendingKey { None, Layers, Chunks, Data };
+
+            const std::string& map_path_;
+            json& map_json_;
+            const TiledLayerCallback& on_layer_;
+            const bool decode_tile_data_;
+            const bool defer_compressed_chunks_;
+
+            DomBuilder map_builder_;
+            DomBuilder layer_builder_;
+            DomBuilder chunk_builder_;
+            TiledLayerData layer_;                  ///< @brief 正在解析的图层
+            json chunk_info_;                       ///< @brief 正在解析的区块的其他字段（x、y、width、height）
+            std::string encoded_data_;              ///< @brief 图层的编码图块数据（base64 文本）
+            std::vector<std::string> encoded_chunks_;   ///< @brief 各区块的编码图块数据，与 layer_.chunks 一一对应
+
+            PendingKey pending_key_ = PendingKey::None;     ///< @brief 已读到 layers / chunks / data 键，等待值的类型决定如何处理
+            bool in_layers_ = false;                ///< @brief 位于 layers 数组中
+            bool in_layer_ = false;                 ///< @brief 位于某个图层对象中
+            bool in_chunks_ = false;                ///< @brief 位于图层的 chunks 数组中
+            bool in_chunk_ = false;                 ///< @brief 位于某个区块对象中
+            bool in_data_ = false;                  ///< @brief 位于图层或区块的 data 数组中
+            int skip_depth_ = 0;                    ///< @brief layers / chunks 数组中非对象元素的嵌套深度（忽略这些元素）
+            size_t tile_count_hint_ = 0;            ///< @brief 上一个图块图层的大小，用于预留 gid 数组
+            size_t chunk_tile_count_hint_ = 0;      ///< @brief 上一个区块的大小
+            bool found_layers_ = false;
+            bool failed_ = false;
+
+        public:
+            TiledMapSaxHandler(const std::string& map_path, json& map_json, const TiledLayerCallback& on_layer, bool decode_tile_data,
+                               bool defer_compressed_chunks)
+                : map_path_(map_path), map_json_(map_json), on_layer_(on_layer), decode_tile_data_(decode_tile_data),
+                  defer_compressed_chunks_(defer_compressed_chunks)
+            {
+                map_builder_.reset(map_json_);
+            }
+
+            bool foundLayers() const { return found_layers_; }
+            bool failed() const { return failed_; }
+
+            bool null() override { return value(nullptr); }
+            bool boolean(bool val) override { return value(val); }
+            bool number_integer(number_integer_t val) override
+            {
+                if (in_data_ && skip_depth_ == 0) return val >= 0 ? gid(static_cast<std::uint64_t>(val)) : invalidData();
+                return value(val);
+            }
+            bool number_unsigned(number_unsigned_t val) override
+            {
+                if (in_data_ && skip_depth_ == 0) return gid(val);
+                return value(val);
+            }
+            bool number_float(number_float_t val, const string_t&) override { return value(val); }
+            bool string(string_t& val) override
+            {
+                if (pending_key_ == PendingKey::Data && skip_depth_ == 0)
+                {
+                    pending_key_ = PendingKey::None;
+                    if (decode_tile_data_) (in_chunk_ ? encoded_chunks_.back() : encoded_data_) = std::move(val);
+                    return true;
+                }
+                return value(std::move(val));
+            }
+            bool binary(binary_t& val) override { return value(json::binary(std::move(val))); }
+
+            bool key(string_t& val) override
+            {
+                if (skip_depth_ > 0) return true;
+                if (in_chunk_ ? chunk_builder_.depth() == 1 : (in_layer_ && !in_chunks_ && layer_builder_.depth() == 1))
+                {
+                    if (val == "data")
+                    {
+                        pending_key_ = PendingKey::Data;
+                        return true;
+                    }
+                    if (!in_chunk_ && val == "chunks")
+                    {
+                        pending_key_ = PendingKey::Chunks;
+                        return true;
+                    }
+                }
+                if (!in_layer_ && map_builder_.depth() == 1 && val == "layers")
+                {
+                    pending_key_ = PendingKey::Layers;
+                    return true;
+                }
+                target().key(val);
+                return true;
+            }
+
+            bool start_object(std::size_t) override
+            {
+                if (skip_depth_ > 0 || in_data_) return skip();
+                flushPendingKey();
+                if (in_chunks_ && !in_chunk_)
+                {
+                    //新区块
+                    in_chunk_ = true;
+                    layer_.chunks.emplace_back();
+                    encoded_chunks_.emplace_back();
+                    chunk_info_ = json();
+                    chunk_builder_.reset(chunk_info_);
+                }
+                else if (in_layers_ && !in_layer_)
+                {
+                    //新图层
+                    in_layer_ = true;
+                    layer_ = TiledLayerData{};
+                    layer_builder_.reset(layer_.info);
+                }
+                target().startObject();
+                return true;
+            }
+
+            bool end_object() override
+            {
+                if (skip_depth_ > 0) return unskip();
+                target().end();
+                if (in_chunk_ && chunk_builder_.depth() == 0)
+                {
+                    in_chunk_ = false;
+                    auto& chunk = layer_.chunks.back();
+                    chunk.position = glm::ivec2(chunk_info_.value("x", 0), chunk_info_.value("y", 0));
+                    chunk.size = glm::ivec2(chunk_info_.value("width", 0), chunk_info_.value("height", 0));
+                    if (!chunk.gids.empty()) chunk_tile_count_hint_ = chunk.gids.size();
+                    return true;
+                }
+                if (in_layer_ && layer_builder_.depth() == 0)
+                {
+                    in_layer_ = false;
+                    return finishLayer();
+                }
+                return true;
+            }
+
+            bool start_array(std::size_t elements) override
+            {
+                if (skip_depth_ > 0 || in_data_) return skip();
+                if (pending_key_ == PendingKey::Data)
+                {
+                    pending_key_ = PendingKey::None;
+                    in_data_ = true;
+                    //MessagePack 给出了准确长度；JSON 不知道数组长度，按图层（区块）的宽 × 高预留
+                    if (decode_tile_data_)
+                        dataTarget().reserve(elements != static_cast<std::size_t>(-1) ? elements : expectedTileCount());
+                    return true;
+                }
+                if (pending_key_ == PendingKey::Chunks)
+                {
+                    pending_key_ = PendingKey::None;
+                    in_chunks_ = true;
+                    return true;
+                }
+                if (pending_key_ == PendingKey::Layers)
+                {
+                    pending_key_ = PendingKey::None;
+                    in_layers_ = true;
+                    found_layers_ = true;
+                    return true;
+                }
+                if ((in_layers_ && !in_layer_) || (in_chunks_ && !in_chunk_)) return skip();
+                target().startArray();
+                return true;
+            }
+
+            bool end_array() override
+            {
+                if (skip_depth_ > 0) return unskip();
+                if (in_data_)
+                {
+                    in_data_ = false;
+                    return true;
+                }
+                if (in_chunks_ && !in_chunk_)
+                {
+                    in_chunks_ = false;
+                    return true;
+                }
+                if (in_layers_ && !in_layer_)
+                {
+                    in_layers_ = false;
+                    return true;
+                }
+                target().end();
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override
+            {
+                spdlog::error("解析文件 {} 时出错: {}", map_path_, ex.what());
+                return false;
+            }
+
+        private:
+            DomBuilder& target() { return in_chunk_ ? chunk_builder_ : (in_layer_ ? layer_builder_ : map_builder_); }
+            std::vector<std::uint32_t>& dataTarget() { return in_chunk_ ? layer_.chunks.back().gids : layer_.gids; }
+
+            //对象中已经出现的 width × height，没有时返回 0
+            static size_t tileCount(const json& info)
+            {
+                if (!info.is_object() || !info.contains("width") || !info.contains("height")) return 0;
+                return static_cast<size_t>(std::max(info.value("width", 0), 0)) * static_cast<size_t>(std::max(info.value("height", 0), 0));
+            }
+
+            /**
+             * data 数组应有的 gid 数量：优先用图层（区块）自己的宽高，有限地图的图块图层与地图同宽高，
+             * 都还不知道时用上一个图层（区块）的大小。Tiled 按字母序输出，data 在 width / height 之前，
+             * 所以第一个图层通常只能按增长方式写入（之后的图层大小相同，可以准确预留）。
+             */
+            size_t expectedTileCount() const
+            {
+                if (in_chunk_)
+                {
+                    const size_t count = tileCount(chunk_info_);
+                    return count > 0 ? count : chunk_tile_count_hint_;
+                }
+                if (const size_t count = tileCount(layer_.info); count > 0) return count;
+                if (const size_t count = tileCount(map_json_); count > 0 && !map_json_.value("infinite", false)) return count;
+                return tile_count_hint_;
+            }
+
+            //layers / chunks / data 的值不是预期的类型时按普通字段处理
+            void flushPendingKey()
+            {
+                if (pending_key_ == PendingKey::Data) target().key("data");
+                else if (pending_key_ == PendingKey::Chunks) layer_builder_.key("chunks");
+                else if (pending_key_ == PendingKey::Layers) map_builder_.key("layers");
+                pending_key_ = PendingKey::None;
+            }
+
+            bool value(json&& val)
+            {
+                if (skip_depth_ > 0) return true;
+                if (in_data_) return invalidData();
+                flushPendingKey();
+                if ((in_layers_ && !in_layer_) || (in_chunks_ && !in_chunk_)) return true;//layers / chunks 数组中的非对象元素
+                target().value(std::move(val));
+                return true;
+            }
+
+            bool skip()
+            {
+                if (in_data_ && skip_depth_ == 0) return invalidData();
+                ++skip_depth_;
+                return true;
+            }
+
+            bool unskip()
+            {
+                --skip_depth_;
+                return true;
+            }
+
+            bool gid(std::uint64_t val)
+            {
+                if (val > std::numeric_limits<std::uint32_t>::max()) return invalidData();
+                if (decode_tile_data_) dataTarget().push_back(static_cast<std::uint32_t>(val));
+                return true;
+            }
+
+            bool invalidData()
+            {
+                spdlog::error("地图 {} 的图层 '{}' 中 data 数组包含非法的 gid", map_path_, layer_.info.value("name", "Unnamed"));
+                failed_ = true;
+                return false;
+            }
+
+            bool finishLayer()
+            {
+                if (!encoded_data_.empty())
+                {
+                    const size_t tile_count = static_cast<size_t>(std::max(layer_.info.value("width", 0), 0)) *
+                                              static_cast<size_t>(std::max(layer_.info.value("height", 0), 0));
+                    if (!decodeTiledLayerData(encoded_data_, layer_.info.value("encoding", ""), layer_.info.value("compression", ""),
+                                              tile_count, layer_.gids))
+                    {
+                        spdlog::error("地图 {} 的图层 '{}' 图块数据解码失败", map_path_, layer_.info.value("name", "Unnamed"));
+                    }
+                    std::string().swap(encoded_data_);
+                }
+                else if (layer_.gids.capacity() - layer_.gids.size() > layer_.gids.size() / 4)
+                {
+                    //按宽高预留时正好用完；只有事先不知道大小、按增长方式写入且浪费超过 1/4 时才收缩（收缩要再复制一份）
+                    layer_.gids.shrink_to_fit();
+                }
+                if (!layer_.gids.empty()) tile_count_hint_ = layer_.gids.size();
+                
+                //区块的编码数据同样在这里解码（encoding / compression 是图层的字段），压缩的区块可以原样交给调用者按需解码
+                const bool defer_chunks = defer_compressed_chunks_ && !layer_.info.value("compression", "").empty();
+                for (size_t i = 0; i < layer_.chunks.size(); ++i)
+                {
+                    if (encoded_chunks_[i].empty()) continue;
+                    auto& chunk = layer_.chunks[i];
+                    if (defer_chunks)
+                    {
+                        chunk.encoded_data = std::move(encoded_chunks_[i]);
+                        chunk.encoded_data.shrink_to_fit();    //解析器的字符串按增长方式分配，区块数据会一直保留
+                        continue;
+                    }
+                    if (!decodeTiledLayerData(encoded_chunks_[i], layer_.info.value("encoding", ""), layer_.info.value("compression", ""),
+                                              static_cast<size_t>(std::max(chunk.size.x, 0)) * static_cast<size_t>(std::max(chunk.size.y, 0)), chunk.gids))
+                    {
+                        spdlog::error("地图 {} 的图层 '{}' 中区块 ({}, {}) 图块数据解码失败", map_path_, layer_.info.value("name", "Unnamed"),
+                                      chunk.position.x, chunk.position.y);
+                    }
+                }
+                encoded_chunks_.clear();
+
+                if (!on_layer_(map_json_, layer_))
+                {
+                    failed_ = true;
+                    return false;
+                }
+                layer_ = TiledLayerData{};
+                return true;
+            }
+        };
+    }
+
+    bool parseTiledMap(const std::string& map_path, const engine::resource::AssetArchive* archive, nlohmann::json& map_json,
+                       const TiledLayerCallback& on_layer, bool decode_tile_data, bool defer_compressed_chunks)
+    {
+        map_json = nlohmann::json();
+        TiledMapSaxHandler handler(map_path, map_json, on_layer, decode_tile_data, defer_compressed_chunks);
+        bool parsed = false;
+        if (const auto* packed = archive ? archive->find(map_path) : nullptr)
+        {
+            const auto format = packed->type == engine::resource::ArchiveEntryType::MsgPack
+                ? nlohmann::json::input_format_t::msgpack
+                : nlohmann::json::input_format_t::json;
+            parsed = nlohmann::json::sax_parse(packed->data, packed->data + packed->size, &handler, format);
+        }
+        else
+        {
+            std::ifstream file(map_path, std::ios::binary);
+            if (!file.is_open())
+            {
+                spdlog::error("无法打开文件: {}", map_path);
+                return false;
+            }
+            parsed = nlohmann::json::sax_parse(file, &handler);
+        }
+        if (!parsed || handler.failed()) return false;
+
+        if (!map_json.is_object() || !handler.foundLayers())
+        {
+            spdlog::error("地图文件 {} 中没有找到图层数组", map_path);
+            return false;
+        }
+        return true;
+    }
+
+    bool decodeTiledLayerData(std::string_view data, std::string_view encoding, std::string_view compression,
+                              size_t tile_count, std::vector<std::uint32_t>& gids)
+    {
+        if (encoding != "base64")
+        {
+            spdlog::error("不支持的图块数据编码 '{}'", encoding);
+            return false;
+        }
+        if (tile_count == 0)
+        {
+            spdlog::error("编码的图块数据缺少图层尺寸");
+            return false;
+        }
+
+        //直接解码/解压到最终的 gid 数组中
+        gids.assign(tile_count, 0);
+        const std::span<std::uint8_t> bytes(reinterpret_cast<std::uint8_t*>(gids.data()), tile_count * sizeof(std::uint32_t));
+        bool ok = false;
+        if (compression.empty())
+        {
+            const auto written = engine::utils::decodeBase64(data, bytes);
+            ok = written && *written == bytes.size();
+        }
+        else
+        {
+            std::vector<std::uint8_t> compressed(engine::utils::base64MaxDecodedSize(data.size()));
+            const auto written = engine::utils::decodeBase64(data, compressed);
+            const std::span<const std::uint8_t> input(compressed.data(), written.value_or(0));
+            if (!written)
+            {
+                ok = false;
+            }
+            else if (compression == "zlib")
+            {
+                ok = engine::utils::decompressZlib(input, bytes);
+            }
+            else if (compression == "gzip")
+            {
+                ok = engine::utils::decompressGzip(input, bytes);
+            }
+            else if (compression == "zstd")
+            {
+                ok = engine::utils::decompressZstd(input, bytes);
+            }
+            else
+            {
+                spdlog::error("不支持的图块数据压缩方式 '{}'", compression);
+                gids.clear();
+                return false;
+            }
+        }
+        if (!ok)
+        {
+            spdlog::error("图块数据解码失败（编码 {}，压缩 {}，期望 {} 个图块）", encoding, compression.empty() ? "无" : compression, tile_count);
+            gids.clear();
+            return false;
+        }
+
+        //Tiled 按小端存储 gid
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            for (auto& gid : gids)
+                gid = ((gid & 0xFFu) << 24) | ((gid & 0xFF00u) << 8) | ((gid >> 8) & 0xFF00u) | (gid >> 24);
+        }
+        return true;
+    }
+
+    LevelObjectRecord parseTiledObject(const nlohmann::json& object_json)
+    {
+        LevelObjectRecord object;
+        object.id = object_json.value("id", 0u);
+        object.gid = object_json.value("gid", 0u);
+        object.position = glm::vec2(object_json.value("x", 0.0f), object_json.value("y", 0.0f));
+        object.size = glm::vec2(object_json.value("width", 0.0f), object_json.value("height", 0.0f));
+        object.rotation = object_json.value("rotation", 0.0f);
+        object.visible = object_json.value("visible", true);
+        object.name = object_json.value("name", "");
+        //Tiled 1.9 之后对象类型字段名为 class
+        object.type = object_json.value("type", object_json.value("class", ""));
+        if (object_json.contains("properties") && object_json["properties"].is_array())
+        {
+            for (const auto& property_json : object_json["properties"])
+            {
+                const auto& value = property_json.contains("value") ? property_json["value"] : nlohmann::json();
+                object.properties.emplace_back(property_json.value("name", ""), value.is_string() ? value.get<std::string>() : value.dump());
+            }
+        }
+        return object;
+    }
+
+    std::optional<SDL_FRect> readTileSourceRect(const nlohmann::json& tile_json)
+    {
+        const float image_width = tile_json.value("imagewidth", 0.0f);
+        const float image_height = tile_json.value("imageheight", 0.0f);
+        const SDL_FRect rect = {tile_json.value("x", 0.0f), tile_json.value("y", 0.0f),
+                                tile_json.value("width", image_width), tile_json.value("height", image_height)};
+        if (rect.w <= 0.0f || rect.h <= 0.0f) return std::nullopt;
+        if (rect.x == 0.0f && rect.y == 0.0f && rect.w == image_width && rect.h == image_height) return std::nullopt;
+        return rect;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <glm/vec2.hpp>
+#include "binary_level.h"
+
+namespace engine::resource
+{
+    class AssetArchive;
+}
+
+namespace engine::scene
+{
+    /// @brief 无限地图图块图层中的一个区块
+    struct TiledChunkData
+    {
+        glm::ivec2 position = {0, 0};           ///< @brief 左上角的图块坐标（可以为负）
+        glm::ivec2 size = {0, 0};               ///< @brief 尺寸（图块数）
+        std::vector<std::uint32_t> gids;        ///< @brief 行优先的 gid（已解码、解压）
+        std::string encoded_data;               ///< @brief 推迟解码的压缩区块的 base64 数据（见 parseTiledMap 的 defer_compressed_chunks），此时 gids 为空
+    };
+
+    /// @brief 流式解析出的一个图层
+    struct TiledLayerData
+    {
+        nlohmann::json info;                    ///< @brief 图层的其他字段（不含 data 和 chunks）
+        std::vector<std::uint32_t> gids;        ///< @brief 图块图层的 gid（已解码、解压），其他图层和无限地图的图层为空
+        std::vector<TiledChunkData> chunks;     ///< @brief 无限地图图块图层的区块
+    };
+
+    /**
+     * @brief 图层回调：每个图层的对象解析结束时调用。
+     * map_json 是到目前为止解析出的地图字段（不含 layers），Tiled 按字母序输出键，
+     * 此时通常还没有 tilesets / tilewidth 等字段。layer 可以被移走。返回 false 中止解析。
+     */
+    using TiledLayerCallback = std::function<bool(const nlohmann::json& map_json, TiledLayerData& layer)>;
+
+    /**
+     * @brief 以 SAX 方式流式解析 Tiled 地图（tmj / json），不构建整张地图的 JSON DOM。
+     *
+     * 图层逐个交给回调，图块数据（包括无限地图各区块的数据）直接解码进 uint32 数组：数组形式逐个写入，
+     * base64 形式（可选 zlib / gzip / zstd 压缩）在图层结束时解压到定长缓冲区。
+     * 峰值内存接近最终的图块存储加上单个图层的临时数据。
+     * 资源包中的条目直接从映射内存解析（MsgPack 条目按 MessagePack 读取），否则从文件流读取。
+     *
+     * @param map_path 地图文件路径
+     * @param archive 资源包，可以为空
+     * @param map_json 输出地图的其他字段（不含 layers）
+     * @param on_layer 图层回调
+     * @param decode_tile_data 为 false 时丢弃图块数据（只需要图层信息时使用）
+     * @param defer_compressed_chunks 为 true 时压缩过的区块数据不解码，base64 文本留在 TiledChunkData::encoded_data 中，
+     *        由调用者在需要时用 decodeTiledLayerData 解码（流式加载只解码载入的区块）
+     * @return 是否解析成功，失败时记录日志。中途失败时已经回调过的图层不会撤销。
+     */
+    bool parseTiledMap(const std::string& map_path, const engine::resource::AssetArchive* archive, nlohmann::json& map_json,
+                       const TiledLayerCallback& on_layer, bool decode_tile_data = true, bool defer_compressed_chunks = false);
+
+    /**
+     * @brief 解码 Tiled 的编码图块数据（encoding 为 base64，compression 为空、zlib、gzip 或 zstd）。
+     * @param tile_count 图层图块数，解码结果必须恰好是这么多个 gid
+     * @return 是否成功，失败时记录日志
+     */
+    bool decodeTiledLayerData(std::string_view data, std::string_view encoding, std::string_view compression,
+                              size_t tile_count, std::vector<std::uint32_t>& gids);
+
+    /// @brief 读取 Tiled 对象图层中的一个对象
+    LevelObjectRecord parseTiledObject(const nlohmann::json& object_json);
+
+    /// @brief 读取图片集合图块集中图块的子矩形（x/y/width/height），没有或覆盖整张图片时返回空
+    std::optional<SDL_FRect> readTileSourceRect(const nlohmann::json& tile_json);
+}
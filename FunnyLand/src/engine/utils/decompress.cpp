@@ -0,0 +1,1095 @@
+#include "decompress.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace engine::utils
+{
+    namespace
+    {
+        // ---------------------------------------------------------------------------
+        // inflate（RFC 1951），按规范逐位解码，实现参考 zlib 附带的 puff.c。
+        // 图块数据一般只有几十 KB 到几 MB，解码速度不是瓶颈，优先保证简单正确。
+        // ---------------------------------------------------------------------------
+        constexpr int MAX_BITS = 15;        //霍夫曼码最大长度
+        constexpr int MAX_LCODES = 286;     //字面量/长度码数量上限
+        constexpr int MAX_DCODES = 30;      //距离码数量上限
+        constexpr int FIX_LCODES = 288;     //固定霍夫曼表的字面量/长度码数量
+
+        struct Huffman
+        {
+            std::array<short, MAX_BITS + 1> count{};    //每种码长的码数
+            std::array<short, FIX_LCODES> symbol{};     //按码值排序的符号
+        };
+
+        class Inflater
+        {
+        public:
+            Inflater(std::span<const std::uint8_t> in, std::span<std::uint8_t> out) : in_(in), out_(out) {}
+
+            //解压全部数据块，返回是否成功且输出恰好填满
+            bool run()
+            {
+                bool last = false;
+                while (!last && !error_)
+                {
+                    last = bits(1) != 0;
+                    switch (bits(2))
+                    {
+                    case 0: stored(); break;
+                    case 1: fixed(); break;
+                    case 2: dynamic(); break;
+                    default: error_ = true; break;
+                    }
+                }
+                return !error_ && out_pos_ == out_.size();
+            }
+
+            size_t consumed() const { return in_pos_; }
+
+        private:
+            std::span<const std::uint8_t> in_;
+            std::span<std::uint8_t> out_;
+            size_t in_pos_ = 0;
+            size_t out_pos_ = 0;
+            std::uint32_t bit_buffer_ = 0;
+            int bit_count_ = 0;
+            bool error_ = false;
+
+            int bits(int need)
+            {
+                std::uint32_t value = bit_buffer_;
+                while (bit_count_ < need)
+                {
+                    if (in_pos_ >= in_.size())
+                    {
+                        error_ = true;
+                        return 0;
+                    }
+                    value |= static_cast<std::uint32_t>(in_[in_pos_++]) << bit_count_;
+                    bit_count_ += 8;
+                }
+                bit_buffer_ = value >> need;
+                bit_count_ -= need;
+                return static_cast<int>(value & ((1u << need) - 1));
+            }
+
+            bool put(std::uint8_t byte)
+            {
+                if (out_pos_ >= out_.size()) return !(error_ = true);
+                out_[out_pos_++] = byte;
+                return true;
+            }
+
+            void stored()
+            {
+                //丢弃当前字节剩余的位
+                bit_buffer_ = 0;
+                bit_count_ = 0;
+                if (in_pos_ + 4 > in_.size())
+                {
+                    error_ = true;
+                    return;
+                }
+                const unsigned length = in_[in_pos_] | (in_[in_pos_ + 1] << 8);
+                const unsigned inverted = in_[in_pos_ + 2] | (in_[in_pos_ + 3] << 8);
+                in_pos_ += 4;
+                if (length != (~inverted & 0xFFFFu) || in_pos_ + length > in_.size() || out_pos_ + length > out_.size())
+                {
+                    error_ = true;
+                    return;
+                }
+                std::copy_n(in_.begin() + static_cast<std::ptrdiff_t>(in_pos_), length, out_.begin() + static_cast<std::ptrdiff_t>(out_pos_));
+                in_pos_ += length;
+                out_pos_ += length;
+            }
+
+            int decode(const Huffman& huffman)
+            {
+                int code = 0;   //当前读到的码
+                int first = 0;  //该码长的第一个码
+                int index = 0;  //该码长第一个码在 symbol 中的位置
+                for (int length = 1; length <= MAX_BITS; ++length)
+                {
+                    code |= bits(1);
+                    if (error_) return -1;
+                    const int count = huffman.count[length];
+                    if (code - count < first)
+                        return huffman.symbol[index + (code - first)];
+                    index += count;
+                    first += count;
+                    first <<= 1;
+                    code <<= 1;
+                }
+                return -1;//码长超过上限
+            }
+
+            //由码长构造霍夫曼表。返回 0 表示完整，>0 表示不完整，<0 表示超额（非法）
+            static int construct(Huffman& huffman, const short* lengths, int n)
+            {
+                huffman.count.fill(0);
+                for (int symbol = 0; symbol < n; ++symbol)
+                    ++huffman.count[lengths[symbol]];
+                if (huffman.count[0] == n) return 0;
+
+                int left = 1;
+                for (int length = 1; length <= MAX_BITS; ++length)
+                {
+                    left <<= 1;
+                    left -= huffman.count[length];
+                    if (left < 0) return left;
+                }
+
+                std::array<short, MAX_BITS + 1> offsets{};
+                for (int length = 1; length < MAX_BITS; ++length)
+                    offsets[length + 1] = static_cast<short>(offsets[length] + huffman.count[length]);
+                for (int symbol = 0; symbol < n; ++symbol)
+                {
+                    if (lengths[symbol] != 0)
+                        huffman.symbol[offsets[lengths[symbol]]++] = static_cast<short>(symbol);
+                }
+                return left;
+            }
+
+            void codes(const Huffman& length_code, const Huffman& distance_code)
+            {
+                static constexpr short LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                                          35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+                static constexpr short LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                                           3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+                static constexpr short DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                                            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                                            8193, 12289, 16385, 24577};
+                static constexpr short DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                                             7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+                while (!error_)
+                {
+                    int symbol = decode(length_code);
+                    if (symbol < 0)
+                    {
+                        error_ = true;
+                        return;
+                    }
+                    if (symbol < 256)
+                    {
+                        put(static_cast<std::uint8_t>(symbol));
+                        continue;
+                    }
+                    if (symbol == 256) return;//块结束
+
+                    symbol -= 257;
+                    if (symbol >= 29)
+                    {
+                        error_ = true;
+                        return;
+                    }
+                    const int length = LENGTH_BASE[symbol] + bits(LENGTH_EXTRA[symbol]);
+                    symbol = decode(distance_code);
+                    if (symbol < 0 || symbol >= 30)
+                    {
+                        error_ = true;
+                        return;
+                    }
+                    const size_t distance = static_cast<size_t>(DISTANCE_BASE[symbol] + bits(DISTANCE_EXTRA[symbol]));
+                    if (error_ || distance > out_pos_ || out_pos_ + static_cast<size_t>(length) > out_.size())
+                    {
+                        error_ = true;
+                        return;
+                    }
+                    //逐字节复制：距离小于长度时源和目标重叠，必须按顺序复制
+                    for (int i = 0; i < length; ++i, ++out_pos_)
+                        out_[out_pos_] = out_[out_pos_ - distance];
+                }
+            }
+
+            void fixed()
+            {
+                static const auto tables = []()
+                {
+                    std::pair<Huffman, Huffman> result;
+                    std::array<short, FIX_LCODES> lengths{};
+                    int symbol = 0;
+                    for (; symbol < 144; ++symbol) lengths[symbol] = 8;
+                    for (; symbol < 256; ++symbol) lengths[symbol] = 9;
+                    for (; symbol < 280; ++symbol) lengths[symbol] = 7;
+                    for (; symbol < FIX_LCODES; ++symbol) lengths[symbol] = 8;
+                    construct(result.first, lengths.data(), FIX_LCODES);
+                    for (symbol = 0; symbol < MAX_DCODES; ++symbol) lengths[symbol] = 5;
+                    construct(result.second, lengths.data(), MAX_DCODES);
+                    return result;
+                }();
+                codes(tables.first, tables.second);
+            }
+
+            void dynamic()
+            {
+                static constexpr short ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+                const int length_count = bits(5) + 257;
+                const int distance_count = bits(5) + 1;
+                const int code_count = bits(4) + 4;
+                if (error_ || length_count > MAX_LCODES || distance_count > MAX_DCODES)
+                {
+                    error_ = true;
+                    return;
+                }
+
+                std::array<short, MAX_LCODES + MAX_DCODES> lengths{};
+                for (int index = 0; index < code_count; ++index)
+                    lengths[ORDER[index]] = static_cast<short>(bits(3));
+                Huffman length_code;
+                Huffman distance_code;
+                if (error_ || construct(length_code, lengths.data(), 19) != 0)
+                {
+                    error_ = true;
+                    return;
+                }
+
+                //读取字面量/长度表和距离表的码长
+                lengths.fill(0);
+                int index = 0;
+                while (index < length_count + distance_count)
+                {
+                    int symbol = decode(length_code);
+                    if (symbol < 0)
+                    {
+                        error_ = true;
+                        return;
+                    }
+                    if (symbol < 16)
+                    {
+                        lengths[index++] = static_cast<short>(symbol);
+                        continue;
+                    }
+                    short repeated = 0;
+                    if (symbol == 16)
+                    {
+                        if (index == 0)
+                        {
+                            error_ = true;
+                            return;
+                        }
+                        repeated = lengths[index - 1];
+                        symbol = 3 + bits(2);
+                    }
+                    else if (symbol == 17)
+                    {
+                        symbol = 3 + bits(3);
+                    }
+                    else
+                    {
+                        symbol = 11 + bits(7);
+                    }
+                    if (error_ || index + symbol > length_count + distance_count)
+                    {
+                        error_ = true;
+                        return;
+                    }
+                    while (symbol-- > 0) lengths[index++] = repeated;
+                }
+
+                //必须有块结束码；不完整的表只允许只有一个码的情况
+                if (lengths[256] == 0)
+                {
+                    error_ = true;
+                    return;
+                }
+                int result = construct(length_code, lengths.data(), length_count);
+                if (result < 0 || (result > 0 && length_count - length_code.count[0] != 1))
+                {
+                    error_ = true;
+                    return;
+                }
+                result = construct(distance_code, lengths.data() + length_count, distance_count);
+                if (result < 0 || (result > 0 && distance_count - distance_code.count[0] != 1))
+                {
+                    error_ = true;
+                    return;
+                }
+                codes(length_code, distance_code);
+            }
+        };
+
+        std::uint32_t adler32(std::span<const std::uint8_t> data)
+        {
+            constexpr std::uint32_t MOD_ADLER = 65521;
+            std::uint32_t a = 1;
+            std::uint32_t b = 0;
+            size_t pos = 0;
+            while (pos < data.size())
+            {
+                //5552 是保证 b 不溢出的最大块长
+                const size_t block_end = std::min(data.size(), pos + 5552);
+                for (; pos < block_end; ++pos)
+                {
+                    a += data[pos];
+                    b += a;
+                }
+                a %= MOD_ADLER;
+                b %= MOD_ADLER;
+            }
+            return (b << 16) | a;
+        }
+
+        int base64Value(char c)
+        {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+') return 62;
+            if (c == '/') return 63;
+            return -1;
+        }
+
+        // ---------------------------------------------------------------------------
+        // zstd 解码（RFC 8878），实现参考 zstd 附带的 educational_decoder。
+        // 只解码 Tiled 用到的单个/连续帧：不支持字典，不校验内容校验和；
+        // 整个输出就是窗口，匹配只能引用同一帧内已经解出的数据。
+        // ---------------------------------------------------------------------------
+        constexpr std::uint32_t ZSTD_MAGIC = 0xFD2FB528u;
+        constexpr int ZSTD_HUF_MAX_BITS = 11;           //霍夫曼码最大长度
+        constexpr int ZSTD_HUF_MAX_SYMBOLS = 256;
+        constexpr int ZSTD_FSE_MAX_ACCURACY = 9;        //序列 FSE 表的最大精度
+        constexpr int ZSTD_FSE_MAX_SYMBOLS = 256;
+
+        int highestBit(std::uint32_t value)
+        {
+            int bit = -1;
+            while (value)
+            {
+                value >>= 1;
+                ++bit;
+            }
+            return bit;
+        }
+
+        //从 src 的第 offset 位起按小端读取 count 位（count <= 32）
+        std::uint32_t readBitsLE(std::span<const std::uint8_t> src, int count, size_t offset)
+        {
+            std::uint64_t value = 0;
+            int shift = 0;
+            size_t byte = offset / 8;
+            int bit = static_cast<int>(offset % 8);
+            while (shift < count && byte < src.size())
+            {
+                value |= (static_cast<std::uint64_t>(src[byte]) >> bit) << shift;
+                shift += 8 - bit;
+                bit = 0;
+                ++byte;
+            }
+            return count == 0 ? 0 : static_cast<std::uint32_t>(value & ((std::uint64_t{1} << count) - 1));
+        }
+
+        /// @brief 正向位流（FSE 表描述）
+        struct ForwardBits
+        {
+            std::span<const std::uint8_t> src;
+            size_t pos = 0;     //位偏移
+
+            bool read(int count, std::uint32_t& value)
+            {
+                if (pos + static_cast<size_t>(count) > src.size() * 8) return false;
+                value = readBitsLE(src, count, pos);
+                pos += static_cast<size_t>(count);
+                return true;
+            }
+            size_t bytesUsed() const { return (pos + 7) / 8; }
+        };
+
+        /// @brief 反向位流（霍夫曼流、FSE 流）：从末尾的填充标记位之前开始向前读，读过开头时补 0
+        struct BackwardBits
+        {
+            std::span<const std::uint8_t> src;
+            std::int64_t offset = 0;    //剩余未读的位数，小于 0 表示已读过开头
+
+            bool init(std::span<const std::uint8_t> data)
+            {
+                src = data;
+                if (data.empty() || data.back() == 0) return false;
+                offset = static_cast<std::int64_t>(data.size()) * 8 - (8 - highestBit(data.back()));
+                return true;
+            }
+
+            std::uint32_t read(int count)
+            {
+                offset -= count;
+                if (offset >= 0) return readBitsLE(src, count, static_cast<size_t>(offset));
+                const int available = count + static_cast<int>(std::max<std::int64_t>(offset, -64));
+                if (available <= 0) return 0;
+                return readBitsLE(src, available, 0) << static_cast<int>(-offset);
+            }
+        };
+
+        /// @brief FSE 解码表
+        struct FseTable
+        {
+            int accuracy_log = 0;
+            std::array<std::uint8_t, 1 << ZSTD_FSE_MAX_ACCURACY> symbols{};
+            std::array<std::uint8_t, 1 << ZSTD_FSE_MAX_ACCURACY> bit_counts{};
+            std::array<std::uint16_t, 1 << ZSTD_FSE_MAX_ACCURACY> state_bases{};
+
+            //由归一化频率构造（-1 表示“小于 1”的概率）
+            bool build(std::span<const std::int16_t> frequencies, int log)
+            {
+                if (log > ZSTD_FSE_MAX_ACCURACY) return false;
+                accuracy_log = log;
+                const int size = 1 << log;
+                std::array<std::uint16_t, ZSTD_FSE_MAX_SYMBOLS> next_state{};
+                int high_threshold = size;
+                for (size_t symbol = 0; symbol < frequencies.size(); ++symbol)
+                {
+                    if (frequencies[symbol] != -1) continue;
+                    symbols[--high_threshold] = static_cast<std::uint8_t>(symbol);
+                    next_state[symbol] = 1;
+                }
+                const int step = (size >> 1) + (size >> 3) + 3;
+                int pos = 0;
+                for (size_t symbol = 0; symbol < frequencies.size(); ++symbol)
+                {
+                    if (frequencies[symbol] <= 0) continue;
+                    next_state[symbol] = static_cast<std::uint16_t>(frequencies[symbol]);
+                    for (int i = 0; i < frequencies[symbol]; ++i)
+                    {
+                        symbols[pos] = static_cast<std::uint8_t>(symbol);
+                        do { pos = (pos + step) & (size - 1); } while (pos >= high_threshold);
+                    }
+                }
+                if (pos != 0) return false;
+                for (int state = 0; state < size; ++state)
+                {
+                    const std::uint16_t desc = next_state[symbols[state]]++;
+                    bit_counts[state] = static_cast<std::uint8_t>(log - highestBit(desc));
+                    state_bases[state] = static_cast<std::uint16_t>((desc << bit_counts[state]) - size);
+                }
+                return true;
+            }
+
+            //所有状态都是同一个符号（RLE 模式）
+            void buildRle(std::uint8_t symbol)
+            {
+                accuracy_log = 0;
+                symbols[0] = symbol;
+                bit_counts[0] = 0;
+                state_bases[0] = 0;
+            }
+
+            //读取 FSE 表描述（RFC 8878 4.1.1），返回消耗的字节数，失败返回 0
+            size_t read(std::span<const std::uint8_t> src, int max_log, size_t max_symbols)
+            {
+                ForwardBits in{src};
+                std::uint32_t value = 0;
+                if (!in.read(4, value)) return 0;
+                const int log = static_cast<int>(value) + 5;
+                if (log > max_log) return 0;
+                std::array<std::int16_t, ZSTD_FSE_MAX_SYMBOLS> frequencies{};
+                int remaining = 1 << log;
+                size_t symbol = 0;
+                while (remaining > 0 && symbol < max_symbols)
+                {
+                    const int bits = highestBit(static_cast<std::uint32_t>(remaining + 1)) + 1;
+                    if (!in.read(bits, value)) return 0;
+                    const std::uint32_t lower_mask = (1u << (bits - 1)) - 1;
+                    const std::uint32_t threshold = (1u << bits) - 1 - static_cast<std::uint32_t>(remaining + 1);
+                    if ((value & lower_mask) < threshold)
+                    {
+                        --in.pos;   //小值只用 bits - 1 位
+                        value &= lower_mask;
+                    }
+                    else if (value > lower_mask)
+                    {
+                        value -= threshold;
+                    }
+                    const int probability = static_cast<int>(value) - 1;
+                    remaining -= probability < 0 ? -probability : probability;
+                    frequencies[symbol++] = static_cast<std::int16_t>(probability);
+                    if (probability != 0) continue;
+                    //概率为 0 后跟 2 位的重复次数，值为 3 时继续读
+                    std::uint32_t repeat = 0;
+                    do
+                    {
+                        if (!in.read(2, repeat)) return 0;
+                        for (std::uint32_t i = 0; i < repeat && symbol < max_symbols; ++i) frequencies[symbol++] = 0;
+                    } while (repeat == 3);
+                }
+                if (remaining != 0) return 0;
+                if (!build(std::span<const std::int16_t>(frequencies.data(), symbol), log)) return 0;
+                return in.bytesUsed();
+            }
+
+            std::uint32_t initState(BackwardBits& bits) const { return bits.read(accuracy_log); }
+            std::uint8_t peek(std::uint32_t state) const { return symbols[state]; }
+            void update(std::uint32_t& state, BackwardBits& bits) const { state = state_bases[state] + bits.read(bit_counts[state]); }
+        };
+
+        /// @brief 霍夫曼解码表（按最长码长直接查表）
+        struct HuffmanTable
+        {
+            int max_bits = 0;
+            std::array<std::uint8_t, 1 << ZSTD_HUF_MAX_BITS> symbols{};
+            std::array<std::uint8_t, 1 << ZSTD_HUF_MAX_BITS> bit_counts{};
+
+            //读取霍夫曼树描述，返回消耗的字节数，失败返回 0
+            size_t read(std::span<const std::uint8_t> src)
+            {
+                if (src.empty()) return 0;
+                std::array<std::uint8_t, ZSTD_HUF_MAX_SYMBOLS> weights{};
+                size_t weight_count = 0;
+                const size_t header = src[0];
+                size_t used = 0;
+                if (header >= 128)
+                {
+                    //直接存储：每个权重 4 位
+                    weight_count = header - 127;
+                    used = 1 + (weight_count + 1) / 2;
+                    if (used > src.size()) return 0;
+                    for (size_t i = 0; i < weight_count; ++i)
+                    {
+                        const std::uint8_t byte = src[1 + i / 2];
+                        weights[i] = static_cast<std::uint8_t>(i % 2 == 0 ? byte >> 4 : byte & 0x0F);
+                    }
+                }
+                else
+                {
+                    //FSE 压缩：两个状态交替解码
+                    used = 1 + header;
+                    if (used > src.size()) return 0;
+                    const auto data = src.subspan(1, header);
+                    FseTable table;
+                    const size_t table_size = table.read(data, 6, ZSTD_HUF_MAX_SYMBOLS);
+                    if (table_size == 0 || table_size >= data.size()) return 0;
+                    BackwardBits bits;
+                    if (!bits.init(data.subspan(table_size))) return 0;
+                    std::uint32_t state1 = table.initState(bits);
+                    std::uint32_t state2 = table.initState(bits);
+                    while (true)
+                    {
+                        if (weight_count + 2 > ZSTD_HUF_MAX_SYMBOLS - 1) return 0;
+                        weights[weight_count++] = table.peek(state1);
+                        table.update(state1, bits);
+                        if (bits.offset < 0)
+                        {
+                            weights[weight_count++] = table.peek(state2);
+                            break;
+                        }
+                        weights[weight_count++] = table.peek(state2);
+                        table.update(state2, bits);
+                        if (bits.offset < 0)
+                        {
+                            weights[weight_count++] = table.peek(state1);
+                            break;
+                        }
+                    }
+                }
+                if (weight_count == 0 || weight_count >= ZSTD_HUF_MAX_SYMBOLS) return 0;
+
+                //最后一个符号的权重由总和补齐到 2 的幂推出
+                std::uint32_t total = 0;
+                for (size_t i = 0; i < weight_count; ++i)
+                {
+                    if (weights[i] > ZSTD_HUF_MAX_BITS) return 0;
+                    if (weights[i] > 0) total += 1u << (weights[i] - 1);
+                }
+                if (total == 0) return 0;
+                max_bits = highestBit(total) + 1;
+                const std::uint32_t left = (1u << max_bits) - total;
+                if (max_bits > ZSTD_HUF_MAX_BITS || (left & (left - 1)) != 0) return 0;
+                weights[weight_count++] = static_cast<std::uint8_t>(highestBit(left) + 1);
+
+                //码长 = max_bits + 1 - 权重；最长的码排在表的最前面，同码长按符号顺序
+                std::array<int, ZSTD_HUF_MAX_BITS + 2> rank_counts{};
+                std::array<std::uint8_t, ZSTD_HUF_MAX_SYMBOLS> code_lengths{};
+                for (size_t symbol = 0; symbol < weight_count; ++symbol)
+                {
+                    code_lengths[symbol] = static_cast<std::uint8_t>(weights[symbol] > 0 ? max_bits + 1 - weights[symbol] : 0);
+                    ++rank_counts[code_lengths[symbol]];
+                }
+                std::array<int, ZSTD_HUF_MAX_BITS + 2> rank_starts{};
+                for (int length = max_bits; length >= 1; --length)
+                {
+                    rank_starts[length - 1] = rank_starts[length] + rank_counts[length] * (1 << (max_bits - length));
+                }
+                if (rank_starts[0] != (1 << max_bits)) return 0;
+                for (size_t symbol = 0; symbol < weight_count; ++symbol)
+                {
+                    const int length = code_lengths[symbol];
+                    if (length == 0) continue;
+                    const int span = 1 << (max_bits - length);
+                    std::fill_n(symbols.begin() + rank_starts[length], span, static_cast<std::uint8_t>(symbol));
+                    std::fill_n(bit_counts.begin() + rank_starts[length], span, static_cast<std::uint8_t>(length));
+                    rank_starts[length] += span;
+                }
+                return used;
+            }
+
+            //解码一条霍夫曼流，必须恰好产生 out.size() 个符号并用完流
+            bool decodeStream(std::span<const std::uint8_t> src, std::span<std::uint8_t> out) const
+            {
+                BackwardBits bits;
+                if (!bits.init(src)) return false;
+                const std::uint32_t mask = (1u << max_bits) - 1;
+                std::uint32_t state = bits.read(max_bits);
+                for (auto& byte : out)
+                {
+                    byte = symbols[state];
+                    const int count = bit_counts[state];
+                    state = ((state << count) | bits.read(count)) & mask;
+                }
+                return bits.offset == -max_bits;
+            }
+        };
+
+        /// @brief 序列三元组的码表（基值 + 额外位数）
+        struct SequenceCode
+        {
+            std::uint32_t baseline;
+            std::uint8_t extra_bits;
+        };
+
+        constexpr std::array<SequenceCode, 36> LITERAL_LENGTH_CODES = {{
+            {0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}, {5, 0}, {6, 0}, {7, 0}, {8, 0}, {9, 0}, {10, 0}, {11, 0},
+            {12, 0}, {13, 0}, {14, 0}, {15, 0}, {16, 1}, {18, 1}, {20, 1}, {22, 1}, {24, 2}, {28, 2}, {32, 3},
+            {40, 3}, {48, 4}, {64, 6}, {128, 7}, {256, 8}, {512, 9}, {1024, 10}, {2048, 11}, {4096, 12},
+            {8192, 13}, {16384, 14}, {32768, 15}, {65536, 16},
+        }};
+        constexpr std::array<SequenceCode, 53> MATCH_LENGTH_CODES = {{
+            {3, 0}, {4, 0}, {5, 0}, {6, 0}, {7, 0}, {8, 0}, {9, 0}, {10, 0}, {11, 0}, {12, 0}, {13, 0}, {14, 0},
+            {15, 0}, {16, 0}, {17, 0}, {18, 0}, {19, 0}, {20, 0}, {21, 0}, {22, 0}, {23, 0}, {24, 0}, {25, 0},
+            {26, 0}, {27, 0}, {28, 0}, {29, 0}, {30, 0}, {31, 0}, {32, 0}, {33, 0}, {34, 0}, {35, 1}, {37, 1},
+            {39, 1}, {41, 1}, {43, 2}, {47, 2}, {51, 3}, {59, 3}, {67, 4}, {83, 4}, {99, 5}, {131, 7}, {259, 8},
+            {515, 9}, {1027, 10}, {2051, 11}, {4099, 12}, {8195, 13}, {16387, 14}, {32771, 15}, {65539, 16},
+        }};
+        constexpr int MAX_OFFSET_CODE = 31;
+
+        //预定义分布（RFC 8878 3.1.1.3.2.2）
+        constexpr std::array<std::int16_t, 36> DEFAULT_LITERAL_LENGTH_FREQUENCIES = {
+            4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1, -1, -1, -1, -1};
+        constexpr std::array<std::int16_t, 53> DEFAULT_MATCH_LENGTH_FREQUENCIES = {
+            1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1, -1};
+        constexpr std::array<std::int16_t, 29> DEFAULT_OFFSET_FREQUENCIES = {
+            1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1};
+
+        class ZstdDecoder
+        {
+        public:
+            ZstdDecoder(std::span<const std::uint8_t> in, std::span<std::uint8_t> out) : in_(in), out_(out) {}
+
+            //解码全部帧（跳过可跳过帧），返回是否成功且输出恰好填满
+            bool run()
+            {
+                while (in_pos_ < in_.size())
+                {
+                    if (in_pos_ + 4 > in_.size()) return false;
+                    const std::uint32_t magic = readLE(in_pos_, 4);
+                    in_pos_ += 4;
+                    if ((magic & 0xFFFFFFF0u) == 0x184D2A50u)
+                    {
+                        if (in_pos_ + 4 > in_.size()) return false;
+                        in_pos_ += 4 + readLE(in_pos_, 4);
+                        if (in_pos_ > in_.size()) return false;
+                        continue;
+                    }
+                    if (magic != ZSTD_MAGIC || !frame()) return false;
+                }
+                return out_pos_ == out_.size();
+            }
+
+        private:
+            std::span<const std::uint8_t> in_;
+            std::span<std::uint8_t> out_;
+            size_t in_pos_ = 0;
+            size_t out_pos_ = 0;
+            size_t frame_start_ = 0;                    //当前帧在输出中的起点（匹配不能越过）
+            std::array<std::uint32_t, 3> repeat_offsets_{};
+            HuffmanTable huffman_;
+            bool has_huffman_ = false;
+            FseTable literal_length_table_, offset_table_, match_length_table_;
+            std::array<bool, 3> has_sequence_table_{};
+            std::vector<std::uint8_t> literals_;        //当前块的字面量（块间复用）
+
+            std::uint32_t readLE(size_t pos, int bytes) const
+            {
+                std::uint32_t value = 0;
+                for (int i = 0; i < bytes; ++i) value |= static_cast<std::uint32_t>(in_[pos + i]) << (8 * i);
+                return value;
+            }
+
+            bool frame()
+            {
+                if (in_pos_ >= in_.size()) return false;
+                const std::uint8_t descriptor = in_[in_pos_++];
+                const int content_size_flag = descriptor >> 6;
+                const bool single_segment = (descriptor & 0x20) != 0;
+                const bool has_checksum = (descriptor & 0x04) != 0;
+                const int dictionary_id_flag = descriptor & 0x03;
+                if (descriptor & 0x08) return false;//保留位
+                static constexpr int DICTIONARY_ID_SIZES[4] = {0, 1, 2, 4};
+                const int dictionary_id_size = DICTIONARY_ID_SIZES[dictionary_id_flag];
+                const size_t content_size_size = content_size_flag == 0 ? (single_segment ? 1 : 0) : (size_t{1} << content_size_flag);
+                if (in_pos_ + (single_segment ? 0 : 1) + dictionary_id_size + content_size_size > in_.size()) return false;
+                if (!single_segment) ++in_pos_;//窗口描述符：整个输出都可引用，不需要
+                if (dictionary_id_size > 0 && readLE(in_pos_, dictionary_id_size) != 0) return false;//不支持字典
+                in_pos_ += dictionary_id_size + content_size_size;//帧内容大小：输出大小由调用者给定，不需要
+
+                frame_start_ = out_pos_;
+                repeat_offsets_ = {1, 4, 8};
+                has_huffman_ = false;
+                has_sequence_table_.fill(false);
+                bool last = false;
+                while (!last)
+                {
+                    if (in_pos_ + 3 > in_.size()) return false;
+                    const std::uint32_t block_header = readLE(in_pos_, 3);
+                    in_pos_ += 3;
+                    last = (block_header & 1) != 0;
+                    const std::uint32_t type = (block_header >> 1) & 3;
+                    const size_t size = block_header >> 3;
+                    switch (type)
+                    {
+                    case 0://原始块
+                        if (in_pos_ + size > in_.size() || out_pos_ + size > out_.size()) return false;
+                        std::copy_n(in_.begin() + static_cast<std::ptrdiff_t>(in_pos_), size, out_.begin() + static_cast<std::ptrdiff_t>(out_pos_));
+                        in_pos_ += size;
+                        out_pos_ += size;
+                        break;
+                    case 1://RLE 块：1 字节重复 size 次
+                        if (in_pos_ + 1 > in_.size() || out_pos_ + size > out_.size()) return false;
+                        std::fill_n(out_.begin() + static_cast<std::ptrdiff_t>(out_pos_), size, in_[in_pos_]);
+                        ++in_pos_;
+                        out_pos_ += size;
+                        break;
+                    case 2://压缩块
+                        if (in_pos_ + size > in_.size() || !compressedBlock(in_.subspan(in_pos_, size))) return false;
+                        in_pos_ += size;
+                        break;
+                    default:
+                        return false;
+                    }
+                }
+                if (has_checksum) in_pos_ += 4;//内容校验和（XXH64 低 32 位），不校验
+                return in_pos_ <= in_.size();
+            }
+
+            bool compressedBlock(std::span<const std::uint8_t> block)
+            {
+                const size_t literals_size = literalsSection(block);
+                if (literals_size == 0) return false;
+                return sequencesSection(block.subspan(literals_size));
+            }
+
+            //解码字面量段到 literals_，返回消耗的字节数，失败返回 0
+            size_t literalsSection(std::span<const std::uint8_t> src)
+            {
+                if (src.empty()) return 0;
+                const int type = src[0] & 3;
+                const int size_format = (src[0] >> 2) & 3;
+                if (type <= 1)
+                {
+                    //原始 / RLE 字面量
+                    size_t header_size = 1;
+                    size_t regenerated = src[0] >> 3;
+                    if (size_format == 1)
+                    {
+                        if (src.size() < 2) return 0;
+                        header_size = 2;
+                        regenerated = (src[0] >> 4) | (static_cast<size_t>(src[1]) << 4);
+                    }
+                    else if (size_format == 3)
+                    {
+                        if (src.size() < 3) return 0;
+                        header_size = 3;
+                        regenerated = (src[0] >> 4) | (static_cast<size_t>(src[1]) << 4) | (static_cast<size_t>(src[2]) << 12);
+                    }
+                    literals_.resize(regenerated);
+                    if (type == 0)
+                    {
+                        if (header_size + regenerated > src.size()) return 0;
+                        std::copy_n(src.begin() + static_cast<std::ptrdiff_t>(header_size), regenerated, literals_.begin());
+                        return header_size + regenerated;
+                    }
+                    if (header_size + 1 > src.size()) return 0;
+                    std::fill(literals_.begin(), literals_.end(), src[header_size]);
+                    return header_size + 1;
+                }
+
+                //霍夫曼压缩（type 2 带树描述，type 3 沿用上一棵树）
+                static constexpr size_t HEADER_SIZES[4] = {3, 3, 4, 5};
+                const size_t header_size = HEADER_SIZES[size_format];
+                if (src.size() < header_size) return 0;
+                std::uint64_t combined = 0;
+                for (size_t i = 0; i < header_size; ++i) combined |= static_cast<std::uint64_t>(src[i]) << (8 * i);
+                static constexpr int SIZE_BITS[4] = {10, 10, 14, 18};
+                const int size_bits = SIZE_BITS[size_format];
+                const size_t regenerated = static_cast<size_t>((combined >> 4) & ((1u << size_bits) - 1));
+                const size_t compressed = static_cast<size_t>((combined >> (4 + size_bits)) & ((1u << size_bits) - 1));
+                const bool four_streams = size_format != 0;
+                if (header_size + compressed > src.size()) return 0;
+                auto data = src.subspan(header_size, compressed);
+                if (type == 2)
+                {
+                    const size_t tree_size = huffman_.read(data);
+                    if (tree_size == 0) return 0;
+                    has_huffman_ = true;
+                    data = data.subspan(tree_size);
+                }
+                else if (!has_huffman_)
+                {
+                    return 0;
+                }
+
+                literals_.resize(regenerated);
+                std::span<std::uint8_t> out(literals_);
+                if (!four_streams)
+                {
+                    if (!huffman_.decodeStream(data, out)) return 0;
+                    return header_size + compressed;
+                }
+                //4 条流：6 字节跳转表给出前三条流的大小
+                if (data.size() < 6) return 0;
+                std::array<size_t, 4> stream_sizes = {
+                    static_cast<size_t>(data[0] | (data[1] << 8)),
+                    static_cast<size_t>(data[2] | (data[3] << 8)),
+                    static_cast<size_t>(data[4] | (data[5] << 8)),
+                    0};
+                const size_t first_three = stream_sizes[0] + stream_sizes[1] + stream_sizes[2];
+                if (6 + first_three > data.size()) return 0;
+                stream_sizes[3] = data.size() - 6 - first_three;
+                const size_t segment = (regenerated + 3) / 4;
+                if (segment * 3 > regenerated) return 0;
+                size_t stream_pos = 6;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    const size_t begin = segment * i;
+                    const size_t count = i < 3 ? segment : regenerated - segment * 3;
+                    if (!huffman_.decodeStream(data.subspan(stream_pos, stream_sizes[i]), out.subspan(begin, count))) return 0;
+                    stream_pos += stream_sizes[i];
+                }
+                return header_size + compressed;
+            }
+
+            //读取一种序列码的解码表（mode：0 预定义，1 RLE，2 FSE 压缩，3 沿用），返回消耗的字节数，失败返回 -1
+            int sequenceTable(std::span<const std::uint8_t> src, int mode, int index, FseTable& table,
+                              std::span<const std::int16_t> defaults, int default_log, int max_log, size_t max_symbol)
+            {
+                switch (mode)
+                {
+                case 0:
+                    table.build(defaults, default_log);
+                    break;
+                case 1:
+                    if (src.empty() || src[0] > max_symbol) return -1;
+                    table.buildRle(src[0]);
+                    has_sequence_table_[index] = true;
+                    return 1;
+                case 2:
+                {
+                    const size_t used = table.read(src, max_log, max_symbol + 1);
+                    if (used == 0) return -1;
+                    has_sequence_table_[index] = true;
+                    return static_cast<int>(used);
+                }
+                default:
+                    if (!has_sequence_table_[index]) return -1;
+                    return 0;
+                }
+                has_sequence_table_[index] = true;
+                return 0;
+            }
+
+            bool sequencesSection(std::span<const std::uint8_t> src)
+            {
+                if (src.empty()) return false;
+                size_t pos = 1;
+                size_t sequence_count = src[0];
+                if (sequence_count >= 128)
+                {
+                    if (sequence_count < 255)
+                    {
+                        if (src.size() < 2) return false;
+                        sequence_count = ((sequence_count - 128) << 8) + src[1];
+                        pos = 2;
+                    }
+                    else
+                    {
+                        if (src.size() < 3) return false;
+                        sequence_count = src[1] + (static_cast<size_t>(src[2]) << 8) + 0x7F00;
+                        pos = 3;
+                    }
+                }
+                size_t literal_pos = 0;
+                if (sequence_count > 0)
+                {
+                    if (pos >= src.size()) return false;
+                    const std::uint8_t modes = src[pos++];
+                    if (modes & 3) return false;//保留位
+                    int used = sequenceTable(src.subspan(pos), modes >> 6, 0, literal_length_table_,
+                                             DEFAULT_LITERAL_LENGTH_FREQUENCIES, 6, ZSTD_FSE_MAX_ACCURACY, LITERAL_LENGTH_CODES.size() - 1);
+                    if (used < 0) return false;
+                    pos += static_cast<size_t>(used);
+                    used = sequenceTable(src.subspan(pos), (modes >> 4) & 3, 1, offset_table_,
+                                         DEFAULT_OFFSET_FREQUENCIES, 5, ZSTD_FSE_MAX_ACCURACY - 1, MAX_OFFSET_CODE);
+                    if (used < 0) return false;
+                    pos += static_cast<size_t>(used);
+                    used = sequenceTable(src.subspan(pos), (modes >> 2) & 3, 2, match_length_table_,
+                                         DEFAULT_MATCH_LENGTH_FREQUENCIES, 6, ZSTD_FSE_MAX_ACCURACY, MATCH_LENGTH_CODES.size() - 1);
+                    if (used < 0) return false;
+                    pos += static_cast<size_t>(used);
+                    if (pos > src.size() || !sequences(src.subspan(pos), sequence_count, literal_pos)) return false;
+                }
+                //最后一个序列之后剩余的字面量
+                const size_t rest = literals_.size() - literal_pos;
+                if (out_pos_ + rest > out_.size()) return false;
+                std::copy_n(literals_.begin() + static_cast<std::ptrdiff_t>(literal_pos), rest, out_.begin() + static_cast<std::ptrdiff_t>(out_pos_));
+                out_pos_ += rest;
+                return true;
+            }
+
+            //解码并执行序列：复制字面量，再从已输出的数据复制匹配
+            bool sequences(std::span<const std::uint8_t> src, size_t count, size_t& literal_pos)
+            {
+                BackwardBits bits;
+                if (!bits.init(src)) return false;
+                std::uint32_t literal_length_state = literal_length_table_.initState(bits);
+                std::uint32_t offset_state = offset_table_.initState(bits);
+                std::uint32_t match_length_state = match_length_table_.initState(bits);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const std::uint8_t offset_code = offset_table_.peek(offset_state);
+                    const std::uint8_t match_length_code = match_length_table_.peek(match_length_state);
+                    const std::uint8_t literal_length_code = literal_length_table_.peek(literal_length_state);
+                    if (offset_code > MAX_OFFSET_CODE || match_length_code >= MATCH_LENGTH_CODES.size() ||
+                        literal_length_code >= LITERAL_LENGTH_CODES.size()) return false;
+
+                    //额外位的读取顺序：偏移、匹配长度、字面量长度
+                    const std::uint32_t offset_value = (1u << offset_code) + bits.read(offset_code);
+                    const auto& match_code = MATCH_LENGTH_CODES[match_length_code];
+                    const size_t match_length = match_code.baseline + bits.read(match_code.extra_bits);
+                    const auto& literal_code = LITERAL_LENGTH_CODES[literal_length_code];
+                    const size_t literal_length = literal_code.baseline + bits.read(literal_code.extra_bits);
+
+                    //状态更新顺序：字面量长度、匹配长度、偏移（最后一个序列不更新）
+                    if (i + 1 < count)
+                    {
+                        literal_length_table_.update(literal_length_state, bits);
+                        match_length_table_.update(match_length_state, bits);
+                        offset_table_.update(offset_state, bits);
+                    }
+
+                    const std::uint32_t offset = resolveOffset(offset_value, literal_length);
+                    if (literal_pos + literal_length > literals_.size() || out_pos_ + literal_length + match_length > out_.size()) return false;
+                    std::copy_n(literals_.begin() + static_cast<std::ptrdiff_t>(literal_pos), literal_length, out_.begin() + static_cast<std::ptrdiff_t>(out_pos_));
+                    literal_pos += literal_length;
+                    out_pos_ += literal_length;
+                    if (offset == 0 || offset > out_pos_ - frame_start_) return false;
+                    //逐字节复制：偏移小于长度时源和目标重叠
+                    for (size_t j = 0; j < match_length; ++j, ++out_pos_)
+                        out_[out_pos_] = out_[out_pos_ - offset];
+                }
+                return bits.offset == 0;
+            }
+
+            //由偏移值和重复偏移历史求出实际偏移（RFC 8878 3.1.1.5）
+            std::uint32_t resolveOffset(std::uint32_t offset_value, size_t literal_length)
+            {
+                auto& history = repeat_offsets_;
+                if (offset_value > 3)
+                {
+                    const std::uint32_t offset = offset_value - 3;
+                    history = {offset, history[0], history[1]};
+                    return offset;
+                }
+                std::uint32_t index = offset_value - 1;
+                if (literal_length == 0) ++index;
+                if (index == 0) return history[0];
+                const std::uint32_t offset = index < 3 ? history[index] : history[0] - 1;
+                if (index > 1) history[2] = history[1];
+                history[1] = history[0];
+                history[0] = offset;
+                return offset;
+            }
+        };
+    }
+
+    std::optional<size_t> decodeBase64(std::string_view text, std::span<std::uint8_t> out)
+    {
+        size_t written = 0;
+        std::uint32_t buffer = 0;
+        int bit_count = 0;
+        bool padding = false;
+        for (const char c : text)
+        {
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+            if (c == '=')
+            {
+                padding = true;
+                continue;
+            }
+            const int value = base64Value(c);
+            if (value < 0 || padding) return std::nullopt;//非法字符，或填充之后还有数据
+            buffer = (buffer << 6) | static_cast<std::uint32_t>(value);
+            bit_count += 6;
+            if (bit_count >= 8)
+            {
+                bit_count -= 8;
+                if (written >= out.size()) return std::nullopt;
+                out[written++] = static_cast<std::uint8_t>(buffer >> bit_count);
+            }
+        }
+        return written;
+    }
+
+    bool decompressZlib(std::span<const std::uint8_t> in, std::span<std::uint8_t> out)
+    {
+        //2 字节头：CM=8（deflate），FCHECK 校验，不支持预设字典
+        if (in.size() < 6) return false;
+        const std::uint8_t cmf = in[0];
+        const std::uint8_t flg = in[1];
+        if ((cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20) != 0) return false;
+
+        Inflater inflater(in.subspan(2), out);
+        if (!inflater.run()) return false;
+
+        //尾部 4 字节大端 Adler-32
+        const size_t trailer = 2 + inflater.consumed();
+        if (trailer + 4 > in.size()) return false;
+        const std::uint32_t expected = (static_cast<std::uint32_t>(in[trailer]) << 24) | (static_cast<std::uint32_t>(in[trailer + 1]) << 16) |
+                                       (static_cast<std::uint32_t>(in[trailer + 2]) << 8) | in[trailer + 3];
+        return adler32(out) == expected;
+    }
+
+    bool decompressGzip(std::span<const std::uint8_t> in, std::span<std::uint8_t> out)
+    {
+        //10 字节头 + 可选字段
+        if (in.size() < 18 || in[0] != 0x1F || in[1] != 0x8B || in[2] != 8) return false;
+        const std::uint8_t flags = in[3];
+        size_t pos = 10;
+        if (flags & 0x04)//FEXTRA
+        {
+            if (pos + 2 > in.size()) return false;
+            pos += 2 + (in[pos] | (in[pos + 1] << 8));
+        }
+        for (const std::uint8_t string_flag : {std::uint8_t{0x08}, std::uint8_t{0x10}})//FNAME、FCOMMENT：以 0 结尾的字符串
+        {
+            if (!(flags & string_flag)) continue;
+            while (pos < in.size() && in[pos] != 0) ++pos;
+            ++pos;
+        }
+        if (flags & 0x02) pos += 2;//FHCRC
+        if (pos >= in.size()) return false;
+
+        Inflater inflater(in.subspan(pos), out);
+        if (!inflater.run()) return false;
+
+        //尾部：CRC-32（不校验）+ 小端的原始长度
+        const size_t trailer = pos + inflater.consumed();
+        if (trailer + 8 > in.size()) return false;
+        const std::uint32_t original_size = in[trailer + 4] | (in[trailer + 5] << 8) | (in[trailer + 6] << 16) |
+                                            (static_cast<std::uint32_t>(in[trailer + 7]) << 24);
+        return original_size == static_cast<std::uint32_t>(out.size());
+    }
+
+    bool decompressZstd(std::span<const std::uint8_t> in, std::span<std::uint8_t> out)
+    {
+        ZstdDecoder decoder(in, out);
+        return decoder.run();
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <optional>
+#include <string_view>
+
+/**
+ * @file decompress.h
+ * @brief Tiled 图块数据用到的解码：base64、zlib/gzip（内置 inflate 实现）和 zstd（内置解码器，不依赖 libzstd）。
+ *
+ * 解压函数都写入调用者提供的定长缓冲区（图块数据解压后的大小由图层尺寸决定），
+ * 输出必须恰好填满缓冲区，否则视为失败。
+ */
+
+namespace engine::utils
+{
+    /// @brief base64 文本解码后的最大字节数，用于确定输出缓冲区大小
+    constexpr size_t base64MaxDecodedSize(size_t text_size) { return text_size / 4 * 3 + 3; }
+
+    /**
+     * @brief 解码 base64 文本（忽略空白字符）到 out。
+     * @return 写入的字节数；格式错误或 out 放不下时返回空。
+     */
+    std::optional<size_t> decodeBase64(std::string_view text, std::span<std::uint8_t> out);
+
+    /// @brief 解压 zlib 格式（RFC 1950）数据，校验 Adler-32
+    bool decompressZlib(std::span<const std::uint8_t> in, std::span<std::uint8_t> out);
+
+    /// @brief 解压 gzip 格式（RFC 1952）数据，校验解压后的长度
+    bool decompressGzip(std::span<const std::uint8_t> in, std::span<std::uint8_t> out);
+
+    /// @brief 解压 zstd 帧（RFC 8878，不支持字典，不校验内容校验和）
+    bool decompressZstd(std::span<const std::uint8_t> in, std::span<std::uint8_t> out);
+}
@@ -5,6 +5,7 @@
 #include "../../engine/component/sprite_component.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/render/camera.h"
+#include "../../engine/resource/resource_manager.h"
 #include <spdlog/spdlog.h>
 
 #include "../../engine/scene/level_loader.h"
@@ -12,6 +13,12 @@
 
 namespace game::scene
 {
+    namespace
+    {
+        constexpr const char* LEVEL_PATH = "assets/maps/level1.tmj";
+        constexpr const char* TEST_OBJECT_TEXTURE = "assets/textures/Props/big-crate.png";
+    }
+    
     GameScene::GameScene(std::string name, engine::core::Context& context, engine::scene::SceneManager& scene_manager)
         : Scene(name, context, scene_manager)
     {
@@ -20,10 +27,15 @@ namespace game::scene
 
     void GameScene::init()
     {
+        auto& input_manager = context_.getInputManager();
+        move_up_action_ = input_manager.getActionId("move_up");
+        move_down_action_ = input_manager.getActionId("move_down");
+        move_left_action_ = input_manager.getActionId("move_left");
+        move_right_action_ = input_manager.getActionId("move_right");
         
         //加载关卡
-        engine::scene::LevelLoader level_loader;
-        level_loader.loadLevel("assets/maps/level1.tmj", *this);
+        engine::scene::LevelLoader level_loader(&context_.getResourceManager().getArchive());
+        level_loader.loadLevel(LEVEL_PATH, *this);
         
         // 创建 test_object
         createTestObject();
@@ -54,6 +66,16 @@ namespace game::scene
         Scene::clean();
     }
 
+    engine::scene::SceneAssets GameScene::discoverAssets() const
+    {
+        //关卡引用的图片，加上 init() 中手动创建的对象用到的纹理
+        engine::scene::SceneAssets assets;
+        engine::scene::LevelLoader level_loader(&context_.getResourceManager().getArchive());
+        assets.textures = level_loader.collectTexturePaths(LEVEL_PATH);
+        assets.textures.emplace_back(TEST_OBJECT_TEXTURE);
+        return assets;
+    }
+
     void GameScene::createTestObject()
     {
         spdlog::trace("在 GameScene 中创建 test_object...");
@@ -61,7 +83,7 @@ namespace game::scene
         
         // 添加组件
         test_object->addComponent<engine::component::TransformComponent>(glm::vec2(100.0f, 100.0f)); 
-        test_object->addComponent<engine::component::SpriteComponent>("assets/textures/Props/big-crate.png", context_.getResourceManager());
+        test_object->addComponent<engine::component::SpriteComponent>(TEST_OBJECT_TEXTURE, context_.getResourceManager());
         
         // 将创建好的 GameObject 添加到场景中 （一定要用std::move，否则传递的是左值）
         addGameObject(std::move(test_object)); 
@@ -72,9 +94,9 @@ namespace game::scene
     {
         auto& camera = context_.getCamera();
         auto& input_manager = context_.getInputManager();
-        if (input_manager.isActionDown("move_up")) camera.move(glm::vec2(0, -1));   
-        if (input_manager.isActionDown("move_down")) camera.move(glm::vec2(0, 1));
-        if (input_manager.isActionDown("move_left")) camera.move(glm::vec2(-1, 0));
-        if (input_manager.isActionDown("move_right")) camera.move(glm::vec2(1, 0));
+        if (input_manager.isActionDown(move_up_action_)) camera.move(glm::vec2(0, -1));   
+        if (input_manager.isActionDown(move_down_action_)) camera.move(glm::vec2(0, 1));
+        if (input_manager.isActionDown(move_left_action_)) camera.move(glm::vec2(-1, 0));
+        if (input_manager.isActionDown(move_right_action_)) camera.move(glm::vec2(1, 0));
     }
 }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "../../engine/scene/scene.h"
+#include "../../engine/input/action_id.h"
 #include <memory>
 
 
@@ -33,10 +34,17 @@ namespace game::scene
         void render() override;
         void handleInput() override;
         void clean() override;        
+        engine::scene::SceneAssets discoverAssets() const override;
         
         
         
     private:
+        // 相机移动动作（init 时查找ID，每帧直接按ID查询）
+        engine::input::ActionId move_up_action_ = engine::input::INVALID_ACTION_ID;
+        engine::input::ActionId move_down_action_ = engine::input::INVALID_ACTION_ID;
+        engine::input::ActionId move_left_action_ = engine::input::INVALID_ACTION_ID;
+        engine::input::ActionId move_right_action_ = engine::input::INVALID_ACTION_ID;
+        
         // 测试函数
         void createTestObject();
         void testCamera();